@@ -0,0 +1,351 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+// Offline replay bench for the head-tracking filters.
+//
+// Record a session with "pose_record_path": "/tmp/head.vr3dpose" in the
+// driver_vrto3d section of steamvr.vrsettings, then:
+//   vrto3d_filter_bench /tmp/head.vr3dpose [--source opentrack|gamepad]
+//       [--rot-sens 0.5] [--pos-sens 0.25] [--rot-dz 0.03] [--pos-dz 0.02]
+//       [--zoom-smooth 0] [--max-zoom 10]
+//       [--min-cutoff 1.0] [--beta 0.0] [--dcutoff 1.0]
+//       [--rot-min-cutoff 1.0] [--rot-beta 0.5] [--pos-min-cutoff 1.0] [--pos-beta 5.0]
+//
+// Each filter is fed the recorded samples with their recorded timestamps and
+// scored on:
+//   latency  - time shift of the raw stream that best matches the output
+//   jitter   - RMS deviation of the output from its own centered moving mean
+//   thruput  - filter calls per second of wall time (bench machine)
+//
+// Regression gate (the ctest entries replay tools/filter_bench/testdata):
+//   --check <raw|accela|one_euro|euro_so3> [--max-latency-ms N]
+//       [--max-rot-jitter-deg N] [--max-pos-jitter-mm N]
+// exits 1 when that filter's rotation or position latency, or either
+// jitter, is above its limit. Limits left out are not checked.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "accela_hamilton_runtime.h"
+#include "one_euro_filter.h"
+#include "one_euro_pose_filter.h"
+#include "pose_stream.h"
+#include "vrmath.h"
+
+namespace {
+
+struct Pose {
+    double t;
+    vr::HmdQuaternion_t q;
+    double p[3];
+};
+
+struct Metrics {
+    double rot_latency_ms;
+    double pos_latency_ms;
+    double rot_jitter_deg;
+    double pos_jitter_mm;
+    double calls_per_sec;
+};
+
+// Half-window of the centered moving mean used as the jitter reference.
+constexpr double kJitterHalfWindowSec = 0.025;
+// Latency search range; coarse pass then a fine pass around the best lag.
+constexpr double kMaxLagSec = 0.5;
+constexpr double kCoarseLagStepSec = 0.005;
+constexpr double kFineLagStepSec = 0.0005;
+
+double AngleDeg(const vr::HmdQuaternion_t& a, const vr::HmdQuaternion_t& b)
+{
+    const double dot = std::clamp(std::abs(a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z), 0.0, 1.0);
+    return RAD_TO_DEG(2.0 * std::acos(dot));
+}
+
+vr::HmdQuaternion_t Nlerp(const vr::HmdQuaternion_t& a, vr::HmdQuaternion_t b, double t)
+{
+    b = HmdQuaternion_EnsureSignContinuity(b, a);
+    vr::HmdQuaternion_t r = {a.w + (b.w - a.w) * t, a.x + (b.x - a.x) * t,
+                             a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t};
+    return HmdQuaternion_Normalize(r);
+}
+
+// Raw pose at time t by linear interpolation between recorded samples.
+// Returns false outside the recorded span.
+bool SampleAt(const std::vector<Pose>& raw, double t, Pose* out)
+{
+    if (raw.empty() || t < raw.front().t || t > raw.back().t)
+        return false;
+    auto it = std::lower_bound(raw.begin(), raw.end(), t,
+                               [](const Pose& p, double v) { return p.t < v; });
+    if (it == raw.begin()) {
+        *out = *it;
+        return true;
+    }
+    const Pose& b = *it;
+    const Pose& a = *(it - 1);
+    const double span = b.t - a.t;
+    const double u = span > 0.0 ? (t - a.t) / span : 0.0;
+    out->t = t;
+    out->q = Nlerp(a.q, b.q, u);
+    for (int i = 0; i < 3; ++i)
+        out->p[i] = a.p[i] + (b.p[i] - a.p[i]) * u;
+    return true;
+}
+
+// Mean error between out(t) and raw(t - lag); negative when no overlap.
+double LagError(const std::vector<Pose>& raw, const std::vector<Pose>& out, bool rotation,
+                double lag)
+{
+    double err = 0.0;
+    size_t n = 0;
+    for (const Pose& o : out) {
+        Pose r;
+        if (!SampleAt(raw, o.t - lag, &r))
+            continue;
+        if (rotation) {
+            err += AngleDeg(o.q, r.q);
+        } else {
+            const double dx = o.p[0] - r.p[0], dy = o.p[1] - r.p[1], dz = o.p[2] - r.p[2];
+            err += std::sqrt(dx * dx + dy * dy + dz * dz);
+        }
+        ++n;
+    }
+    return n ? err / static_cast<double>(n) : -1.0;
+}
+
+// Lag (seconds) minimizing LagError over [0, kMaxLagSec].
+double BestLag(const std::vector<Pose>& raw, const std::vector<Pose>& out, bool rotation)
+{
+    double best_lag = 0.0;
+    double best_err = 1e300;
+    auto scan = [&](double from, double to, double step) {
+        for (double lag = std::max(0.0, from); lag <= to; lag += step) {
+            const double err = LagError(raw, out, rotation, lag);
+            if (err < 0.0)
+                break;
+            if (err < best_err) {
+                best_err = err;
+                best_lag = lag;
+            }
+        }
+    };
+    scan(0.0, kMaxLagSec, kCoarseLagStepSec);
+    const double centre = best_lag;
+    scan(centre - kCoarseLagStepSec, std::min(kMaxLagSec, centre + kCoarseLagStepSec), kFineLagStepSec);
+    return best_lag;
+}
+
+void Jitter(const std::vector<Pose>& s, double* rot_deg, double* pos_mm)
+{
+    double rot_sq = 0.0, pos_sq = 0.0;
+    size_t n = 0;
+    size_t lo = 0, hi = 0;
+    for (size_t i = 0; i < s.size(); ++i) {
+        while (s[lo].t < s[i].t - kJitterHalfWindowSec)
+            ++lo;
+        while (hi + 1 < s.size() && s[hi + 1].t <= s[i].t + kJitterHalfWindowSec)
+            ++hi;
+        if (hi - lo < 2)
+            continue;
+        vr::HmdQuaternion_t qsum = {0, 0, 0, 0};
+        double psum[3] = {0, 0, 0};
+        for (size_t k = lo; k <= hi; ++k) {
+            const vr::HmdQuaternion_t q = HmdQuaternion_EnsureSignContinuity(s[k].q, s[i].q);
+            qsum.w += q.w; qsum.x += q.x; qsum.y += q.y; qsum.z += q.z;
+            for (int c = 0; c < 3; ++c)
+                psum[c] += s[k].p[c];
+        }
+        const double count = static_cast<double>(hi - lo + 1);
+        const double a = AngleDeg(s[i].q, HmdQuaternion_Normalize(qsum));
+        rot_sq += a * a;
+        double d2 = 0.0;
+        for (int c = 0; c < 3; ++c) {
+            const double d = (s[i].p[c] - psum[c] / count) * 1000.0;
+            d2 += d * d;
+        }
+        pos_sq += d2;
+        ++n;
+    }
+    *rot_deg = n ? std::sqrt(rot_sq / n) : 0.0;
+    *pos_mm = n ? std::sqrt(pos_sq / n) : 0.0;
+}
+
+using FilterFn = std::function<void(Pose&)>;
+
+Metrics Run(const std::vector<Pose>& raw, const FilterFn& filter)
+{
+    std::vector<Pose> out = raw;
+    const auto start = std::chrono::steady_clock::now();
+    for (Pose& p : out)
+        filter(p);
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Metrics m{};
+    m.rot_latency_ms = BestLag(raw, out, true) * 1000.0;
+    m.pos_latency_ms = BestLag(raw, out, false) * 1000.0;
+    Jitter(out, &m.rot_jitter_deg, &m.pos_jitter_mm);
+    m.calls_per_sec = wall > 0.0 ? static_cast<double>(out.size()) / wall : 0.0;
+    return m;
+}
+
+void Print(const char* name, const Metrics& m)
+{
+    std::printf("%-10s %10.1f %10.1f %12.4f %11.3f %14.0f\n", name, m.rot_latency_ms,
+                m.pos_latency_ms, m.rot_jitter_deg, m.pos_jitter_mm, m.calls_per_sec);
+}
+
+const char* ArgValue(int argc, char** argv, const char* name)
+{
+    for (int i = 1; i + 1 < argc; ++i)
+        if (std::strcmp(argv[i], name) == 0)
+            return argv[i + 1];
+    return nullptr;
+}
+
+float ArgFloat(int argc, char** argv, const char* name, float def)
+{
+    const char* v = ArgValue(argc, argv, name);
+    return v ? static_cast<float>(std::atof(v)) : def;
+}
+
+// One --max-* limit; negative when not given.
+bool OverLimit(const char* filter, const char* what, double value, double limit)
+{
+    if (limit < 0.0 || value <= limit)
+        return false;
+    std::printf("FAIL %s: %s %.4f exceeds %.4f\n", filter, what, value, limit);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argv[1][0] == '-') {
+        std::fprintf(stderr, "usage: %s <recording> [--source opentrack|gamepad] [filter params]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    std::vector<vrto3d::PoseSample> samples;
+    if (!vrto3d::ReadPoseStream(argv[1], &samples)) {
+        std::fprintf(stderr, "cannot read pose recording '%s'\n", argv[1]);
+        return 1;
+    }
+
+    const char* source_arg = ArgValue(argc, argv, "--source");
+    vrto3d::PoseSource source = vrto3d::PoseSource::OpenTrack;
+    if (source_arg && std::strcmp(source_arg, "gamepad") == 0)
+        source = vrto3d::PoseSource::Gamepad;
+
+    std::vector<Pose> raw;
+    for (const auto& s : samples) {
+        if (s.source != static_cast<uint32_t>(source))
+            continue;
+        if (!raw.empty() && s.t <= raw.back().t)
+            continue;  // duplicate timestamp
+        Pose p;
+        p.t = s.t;
+        p.q = HmdQuaternion_Normalize({s.q[0], s.q[1], s.q[2], s.q[3]});
+        for (int i = 0; i < 3; ++i)
+            p.p[i] = s.p[i];
+        raw.push_back(p);
+    }
+    if (raw.size() < 3) {
+        std::fprintf(stderr, "recording has fewer than 3 %s samples\n",
+                     source == vrto3d::PoseSource::Gamepad ? "gamepad" : "opentrack");
+        return 1;
+    }
+
+    StereoDisplayDriverConfiguration config{};
+    config.trk_flt_rot_sens = ArgFloat(argc, argv, "--rot-sens", 0.5f);
+    config.trk_flt_pos_sens = ArgFloat(argc, argv, "--pos-sens", 0.25f);
+    config.trk_flt_rot_dz = ArgFloat(argc, argv, "--rot-dz", 0.03f);
+    config.trk_flt_pos_dz = ArgFloat(argc, argv, "--pos-dz", 0.02f);
+    config.trk_flt_zoom_smooth = ArgFloat(argc, argv, "--zoom-smooth", 0.0f);
+    config.trk_flt_max_zoom = ArgFloat(argc, argv, "--max-zoom", 10.0f);
+    const float min_cutoff = ArgFloat(argc, argv, "--min-cutoff", 1.0f);
+    const float beta = ArgFloat(argc, argv, "--beta", 0.0f);
+    const float dcutoff = ArgFloat(argc, argv, "--dcutoff", 1.0f);
+    OneEuroPoseParams pose_params;
+    pose_params.rot_min_cutoff = ArgFloat(argc, argv, "--rot-min-cutoff", 1.0f);
+    pose_params.rot_beta = ArgFloat(argc, argv, "--rot-beta", 0.5f);
+    pose_params.pos_min_cutoff = ArgFloat(argc, argv, "--pos-min-cutoff", 1.0f);
+    pose_params.pos_beta = ArgFloat(argc, argv, "--pos-beta", 5.0f);
+    pose_params.d_cutoff = dcutoff;
+
+    const double span = raw.back().t - raw.front().t;
+    std::printf("%zu samples over %.2f s (%.1f Hz)\n\n", raw.size(), span,
+                span > 0.0 ? (raw.size() - 1) / span : 0.0);
+    std::printf("%-10s %10s %10s %12s %11s %14s\n", "filter", "rot lat ms", "pos lat ms",
+                "rot jit deg", "pos jit mm", "calls/s");
+
+    const char* check = ArgValue(argc, argv, "--check");
+    bool checked = false;
+    bool failed = false;
+    auto report = [&](const char* name, const Metrics& m) {
+        Print(name, m);
+        if (!check || std::strcmp(check, name) != 0)
+            return;
+        checked = true;
+        const double max_latency = ArgFloat(argc, argv, "--max-latency-ms", -1.0f);
+        failed |= OverLimit(name, "rot latency ms", m.rot_latency_ms, max_latency);
+        failed |= OverLimit(name, "pos latency ms", m.pos_latency_ms, max_latency);
+        failed |= OverLimit(name, "rot jitter deg", m.rot_jitter_deg,
+                            ArgFloat(argc, argv, "--max-rot-jitter-deg", -1.0f));
+        failed |= OverLimit(name, "pos jitter mm", m.pos_jitter_mm,
+                            ArgFloat(argc, argv, "--max-pos-jitter-mm", -1.0f));
+    };
+
+    report("raw", Run(raw, [](Pose&) {}));
+
+    AccelaHamiltonRuntimeFilter accela;
+    report("accela", Run(raw, [&](Pose& p) { accela.FilterPose(p.q, p.p, config, p.t); }));
+
+    // Scalar One Euro per component (quaternion renormalized afterwards).
+    OneEuroFilter euro[7];
+    for (auto& f : euro)
+        f = OneEuroFilter(60.0f, min_cutoff, beta, dcutoff);
+    vr::HmdQuaternion_t euro_prev = HmdQuaternion_Identity;
+    report("one_euro", Run(raw, [&](Pose& p) {
+        const vr::HmdQuaternion_t q = HmdQuaternion_EnsureSignContinuity(p.q, euro_prev);
+        vr::HmdQuaternion_t fq = {euro[0].filter(static_cast<float>(q.w), p.t),
+                                  euro[1].filter(static_cast<float>(q.x), p.t),
+                                  euro[2].filter(static_cast<float>(q.y), p.t),
+                                  euro[3].filter(static_cast<float>(q.z), p.t)};
+        euro_prev = q;
+        p.q = HmdQuaternion_Normalize(fq);
+        for (int i = 0; i < 3; ++i)
+            p.p[i] = euro[4 + i].filter(static_cast<float>(p.p[i]), p.t);
+    }));
+
+    // Same filter the driver runs for track_filter_type "one_euro".
+    OneEuroPoseFilter euro_pose;
+    report("euro_so3", Run(raw, [&](Pose& p) { euro_pose.FilterPose(p.q, p.p, pose_params, p.t); }));
+
+    if (check && !checked) {
+        std::fprintf(stderr, "unknown filter '%s' for --check\n", check);
+        return 2;
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""Generate the synthetic head-pose recording the filter bench test replays.
+
+    python3 make_test_recording.py testdata/head_sweep.vr3dpose
+
+Writes the pose_stream.h format (VR3DPOSE v1): ten seconds of OpenTrack
+samples at 100 Hz with smooth yaw/pitch sweeps, two quick 40 degree turns,
+a still stretch, head sway, sensor noise and timestamp jitter. The noise is
+seeded, so rerunning this reproduces the checked-in file. The bench's
+regression limits in vrto3d/tests/CMakeLists.txt were measured on it;
+regenerate them if this changes.
+"""
+import math
+import random
+import struct
+import sys
+
+RATE_HZ = 100.0
+SECONDS = 10.0
+ROT_NOISE_DEG = 0.15
+POS_NOISE_M = 0.001
+TIME_JITTER_S = 0.001
+SOURCE_OPENTRACK = 1
+
+
+def smoothstep(x):
+    x = min(max(x, 0.0), 1.0)
+    return x * x * (3.0 - 2.0 * x)
+
+
+def head_angles(t):
+    """Yaw, pitch, roll in degrees at time t."""
+    # The sweeps pause for two seconds at t = 4 (the still stretch).
+    sweep_t = t if t < 4.0 else max(4.0, t - 2.0)
+    yaw = 30.0 * math.sin(2.0 * math.pi * 0.25 * sweep_t)
+    pitch = 10.0 * math.sin(2.0 * math.pi * 0.4 * sweep_t)
+    # Quick turns: 40 degrees in 0.2 s and back.
+    yaw += 40.0 * (smoothstep((t - 2.0) / 0.2) - smoothstep((t - 3.0) / 0.2))
+    yaw += 40.0 * (smoothstep((t - 7.0) / 0.2) - smoothstep((t - 8.0) / 0.2))
+    roll = 3.0 * math.sin(2.0 * math.pi * 0.15 * sweep_t)
+    return yaw, pitch, roll
+
+
+def quat_from_euler(yaw, pitch, roll):
+    """w, x, y, z for yaw about +Y, then pitch about +X, then roll about +Z."""
+    cy, sy = math.cos(math.radians(yaw) / 2), math.sin(math.radians(yaw) / 2)
+    cp, sp = math.cos(math.radians(pitch) / 2), math.sin(math.radians(pitch) / 2)
+    cr, sr = math.cos(math.radians(roll) / 2), math.sin(math.radians(roll) / 2)
+    return (cy * cp * cr + sy * sp * sr,
+            cy * sp * cr + sy * cp * sr,
+            sy * cp * cr - cy * sp * sr,
+            cy * cp * sr - sy * sp * cr)
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(__doc__)
+    rng = random.Random(20261019)
+    out = bytearray(b"VR3DPOSE" + struct.pack("<II", 1, 40))
+    for i in range(int(RATE_HZ * SECONDS)):
+        t = i / RATE_HZ
+        yaw, pitch, roll = head_angles(t)
+        w, x, y, z = quat_from_euler(yaw + rng.gauss(0.0, ROT_NOISE_DEG),
+                                     pitch + rng.gauss(0.0, ROT_NOISE_DEG),
+                                     roll + rng.gauss(0.0, ROT_NOISE_DEG))
+        pos = (0.05 * math.sin(2.0 * math.pi * 0.3 * t) + rng.gauss(0.0, POS_NOISE_M),
+               0.02 * math.sin(2.0 * math.pi * 0.2 * t) + rng.gauss(0.0, POS_NOISE_M),
+               0.03 * math.sin(2.0 * math.pi * 0.1 * t) + rng.gauss(0.0, POS_NOISE_M))
+        stamp = 1000.0 + t + rng.uniform(-TIME_JITTER_S, TIME_JITTER_S)
+        out += struct.pack("<d4f3fI", stamp, w, x, y, z, *pos, SOURCE_OPENTRACK)
+    with open(sys.argv[1], "wb") as f:
+        f.write(out)
+
+
+if __name__ == "__main__":
+    main()
@@ -24,9 +24,21 @@ public:
         initialized_ = false;
     }
 
+    // Live path: the filter advances on steady_clock wall time.
     void FilterPose(vr::HmdQuaternion_t& rotation, double position[3], const StereoDisplayDriverConfiguration& config)
     {
-        const auto now = std::chrono::steady_clock::now();
+        const double now = std::chrono::duration<double>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        FilterPose(rotation, position, config, now);
+    }
+
+    // Timestamped path (seconds, any monotonic origin). Used by the replay
+    // bench so recorded streams filter identically regardless of how fast
+    // they are fed through.
+    void FilterPose(vr::HmdQuaternion_t& rotation, double position[3], const StereoDisplayDriverConfiguration& config,
+                    double timestamp_seconds)
+    {
+        const double now = timestamp_seconds;
 
         const vr::HmdQuaternion_t current_rotation = HmdQuaternion_Normalize(rotation);
         const std::array<double, 3> current_position = { position[0], position[1], position[2] };
@@ -40,7 +52,7 @@ public:
             return;
         }
 
-        double dt = std::chrono::duration<double>(now - last_timestamp_).count();
+        double dt = now - last_timestamp_;
         last_timestamp_ = now;
         dt = std::clamp<double>(dt, kMinDeltaTimeSeconds, kMaxDeltaTimeSeconds);
 
@@ -225,7 +237,7 @@ private:
     }
 
     bool initialized_ = false;
-    std::chrono::steady_clock::time_point last_timestamp_{};
+    double last_timestamp_ = 0.0;
     vr::HmdQuaternion_t last_rotation_ = HmdQuaternion_Identity;
     std::array<double, 3> last_position_ = { 0.0, 0.0, 0.0 };
 };
@@ -1,7 +1,7 @@
 // one_euro_filter.h — Speed-adaptive low-pass filter
 // Based on: "1 Euro Filter" by Casiez, Roussel, Vogel (CHI 2012)
 // Original BSD 3-Clause License (Casiez/Roussel 2019) — see utils/LICENSE
-// Adapted: header-only, float, value types, no exceptions
+// Adapted: header-only, float values (double timestamps), value types, no exceptions
 #pragma once
 #include <cmath>
 
@@ -44,7 +44,7 @@ public:
 class OneEuroFilter {
     float freq_, mincutoff_, beta_, dcutoff_;
     LowPassFilter x_, dx_;
-    float lasttime_ = -1.0f;
+    double lasttime_ = -1.0;
 
     float alpha(float cutoff) const {
         float te = 1.0f / freq_;
@@ -68,10 +68,12 @@ public:
         dx_ = LowPassFilter(alpha(dcutoff_));
     }
 
-    float filter(float value, float timestamp = -1.0f) {
-        if (lasttime_ >= 0.0f && timestamp >= 0.0f && timestamp > lasttime_) {
-            float dt = timestamp - lasttime_;
-            if (dt > 0.0f) freq_ = 1.0f / dt;
+    // `timestamp` is in seconds. Double so steady-clock epochs (days of
+    // uptime) keep sub-millisecond resolution.
+    float filter(float value, double timestamp = -1.0) {
+        if (lasttime_ >= 0.0 && timestamp >= 0.0 && timestamp > lasttime_) {
+            double dt = timestamp - lasttime_;
+            if (dt > 0.0) freq_ = static_cast<float>(1.0 / dt);
         }
         lasttime_ = timestamp;
 
@@ -91,5 +93,5 @@ public:
     float getMinCutoff() const { return mincutoff_; }
     float getBeta() const { return beta_; }
     float getFrequency() const { return freq_; }
-    void reset() { x_.reset(); dx_.reset(); lasttime_ = -1.0f; }
+    void reset() { x_.reset(); dx_.reset(); lasttime_ = -1.0; }
 };
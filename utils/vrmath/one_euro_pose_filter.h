@@ -0,0 +1,152 @@
+// one_euro_pose_filter.h — 1 Euro head-pose filter (SO(3) rotation + R^3 position)
+// Based on: "1 Euro Filter" by Casiez, Roussel, Vogel (CHI 2012)
+//
+// Rotation is filtered on the sphere rather than per quaternion component:
+// the speed term is the angular velocity from the log map of the delta
+// rotation, and smoothing is a slerp toward the new sample by the 1 Euro
+// alpha. Position runs the same filter on the 3-vector, with the speed term
+// taken from the velocity magnitude so all axes share one cutoff.
+//
+// The filter only advances when the sample timestamp does. The pose thread
+// polls faster than OpenTrack/gamepad deliver, so re-feeding the same sample
+// returns the held output instead of collapsing dt to zero.
+#pragma once
+
+#include "openvr_driver.h"
+#include "vrmath.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+struct OneEuroPoseParams
+{
+    double rot_min_cutoff = 1.0;   // Hz at rest
+    double rot_beta = 0.5;         // Hz per rad/s of angular speed
+    double pos_min_cutoff = 1.0;   // Hz at rest
+    double pos_beta = 5.0;         // Hz per m/s of linear speed
+    double d_cutoff = 1.0;         // Hz, derivative low-pass
+};
+
+class OneEuroPoseFilter
+{
+public:
+    void Reset()
+    {
+        initialized_ = false;
+    }
+
+    // `timestamp_seconds` is the tracking sample time (any monotonic origin),
+    // not the time the pose thread happens to run.
+    void FilterPose(vr::HmdQuaternion_t& rotation, double position[3], const OneEuroPoseParams& params,
+                    double timestamp_seconds)
+    {
+        const vr::HmdQuaternion_t current_rotation = HmdQuaternion_Normalize(rotation);
+        const std::array<double, 3> current_position = { position[0], position[1], position[2] };
+
+        if (!initialized_)
+        {
+            initialized_ = true;
+            last_timestamp_ = timestamp_seconds;
+            last_rotation_ = current_rotation;
+            last_position_ = current_position;
+            rot_speed_ = 0.0;
+            pos_velocity_ = { 0.0, 0.0, 0.0 };
+            return;
+        }
+
+        if (timestamp_seconds <= last_timestamp_)
+        {
+            Emit(rotation, position);
+            return;
+        }
+
+        const double dt = std::clamp<double>(timestamp_seconds - last_timestamp_,
+                                             kMinDeltaTimeSeconds, kMaxDeltaTimeSeconds);
+        last_timestamp_ = timestamp_seconds;
+        const double d_alpha = Alpha(params.d_cutoff, dt);
+
+        // Rotation: speed from the log map of last_filtered^-1 * sample.
+        const vr::HmdQuaternion_t contiguous =
+            HmdQuaternion_EnsureSignContinuity(current_rotation, last_rotation_);
+        const std::array<float, 3> omega =
+            HmdQuaternion_AngularVelocity(contiguous, last_rotation_, static_cast<float>(dt));
+        const double raw_rot_speed = std::sqrt(static_cast<double>(omega[0]) * omega[0] +
+                                               static_cast<double>(omega[1]) * omega[1] +
+                                               static_cast<double>(omega[2]) * omega[2]);
+        rot_speed_ += d_alpha * (raw_rot_speed - rot_speed_);
+        const double rot_cutoff = std::max<double>(kEpsilon, params.rot_min_cutoff) +
+                                  std::max<double>(0.0, params.rot_beta) * rot_speed_;
+        last_rotation_ = Slerp(last_rotation_, contiguous, Alpha(rot_cutoff, dt));
+
+        // Position: vector derivative, scalar cutoff from its magnitude.
+        for (int i = 0; i < 3; ++i)
+        {
+            const double v = (current_position[i] - last_position_[i]) / dt;
+            pos_velocity_[i] += d_alpha * (v - pos_velocity_[i]);
+        }
+        const double pos_speed = std::sqrt(pos_velocity_[0] * pos_velocity_[0] +
+                                           pos_velocity_[1] * pos_velocity_[1] +
+                                           pos_velocity_[2] * pos_velocity_[2]);
+        const double pos_cutoff = std::max<double>(kEpsilon, params.pos_min_cutoff) +
+                                  std::max<double>(0.0, params.pos_beta) * pos_speed;
+        const double pos_alpha = Alpha(pos_cutoff, dt);
+        for (int i = 0; i < 3; ++i)
+        {
+            last_position_[i] += pos_alpha * (current_position[i] - last_position_[i]);
+        }
+
+        Emit(rotation, position);
+    }
+
+private:
+    static constexpr double kEpsilon = 1e-9;
+    static constexpr double kMinDeltaTimeSeconds = 1e-5;
+    static constexpr double kMaxDeltaTimeSeconds = 0.25;
+
+    static double Alpha(double cutoff, double dt)
+    {
+        const double tau = 1.0 / (2.0 * M_PI * cutoff);
+        return 1.0 / (1.0 + tau / dt);
+    }
+
+    static vr::HmdQuaternion_t Slerp(const vr::HmdQuaternion_t& a, const vr::HmdQuaternion_t& b, double t)
+    {
+        const double dot = std::clamp(static_cast<double>(HmdQuaternion_Dot(a, b)), -1.0, 1.0);
+        if (dot > 0.9995)
+        {
+            return HmdQuaternion_Normalize({
+                a.w + (b.w - a.w) * t,
+                a.x + (b.x - a.x) * t,
+                a.y + (b.y - a.y) * t,
+                a.z + (b.z - a.z) * t
+            });
+        }
+
+        const double theta0 = std::acos(dot);
+        const double sin_theta0 = std::sin(theta0);
+        const double s0 = std::sin((1.0 - t) * theta0) / sin_theta0;
+        const double s1 = std::sin(t * theta0) / sin_theta0;
+        return HmdQuaternion_Normalize({
+            a.w * s0 + b.w * s1,
+            a.x * s0 + b.x * s1,
+            a.y * s0 + b.y * s1,
+            a.z * s0 + b.z * s1
+        });
+    }
+
+    void Emit(vr::HmdQuaternion_t& rotation, double position[3]) const
+    {
+        rotation = last_rotation_;
+        position[0] = last_position_[0];
+        position[1] = last_position_[1];
+        position[2] = last_position_[2];
+    }
+
+    bool initialized_ = false;
+    double last_timestamp_ = 0.0;
+    vr::HmdQuaternion_t last_rotation_ = HmdQuaternion_Identity;
+    std::array<double, 3> last_position_ = { 0.0, 0.0, 0.0 };
+    double rot_speed_ = 0.0;
+    std::array<double, 3> pos_velocity_ = { 0.0, 0.0, 0.0 };
+};
@@ -0,0 +1,150 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+// pose_stream.h — compact binary recording of raw head-pose samples
+//
+// Written by the driver when driver_vrto3d/pose_record_path is set, read
+// back by the filter replay bench (tools/filter_bench). No OpenVR dependency
+// so the bench can link it without the driver.
+//
+// Layout (little-endian, native float/double):
+//   PoseStreamHeader  (16 bytes)
+//   PoseSample * N    (40 bytes each) until EOF
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace vrto3d {
+
+enum class PoseSource : uint32_t {
+    OpenTrack = 1,  // raw UDP attitude/position (pre-composition)
+    Gamepad   = 2,  // integrated stick pitch/yaw + pitch-radius offset
+};
+
+#pragma pack(push, 1)
+struct PoseStreamHeader {
+    char     magic[8];       // "VR3DPOSE"
+    uint32_t version;        // kPoseStreamVersion
+    uint32_t sample_size;    // sizeof(PoseSample), for forward-compat skips
+};
+
+struct PoseSample {
+    double   t;              // steady-clock seconds at sample arrival
+    float    q[4];           // w, x, y, z
+    float    p[3];           // meters, SteamVR axes
+    uint32_t source;         // PoseSource
+};
+#pragma pack(pop)
+
+static_assert(sizeof(PoseStreamHeader) == 16, "pose stream header layout");
+static_assert(sizeof(PoseSample) == 40, "pose stream sample layout");
+
+constexpr uint32_t kPoseStreamVersion = 1;
+
+inline std::FILE* OpenPoseStreamFile(const char* path, const char* mode)
+{
+#ifdef _MSC_VER
+    std::FILE* f = nullptr;
+    return fopen_s(&f, path, mode) == 0 ? f : nullptr;
+#else
+    return std::fopen(path, mode);
+#endif
+}
+
+// Thread-safe append-only writer. Samples arrive from the OpenTrack and
+// gamepad threads at a few hundred Hz combined, so a mutex around fwrite is
+// plenty; stdio buffering keeps syscalls off the hot path.
+class PoseStreamWriter {
+public:
+    ~PoseStreamWriter() { Close(); }
+
+    bool Open(const char* path)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (file_)
+            return true;
+        file_ = OpenPoseStreamFile(path, "wb");
+        if (!file_)
+            return false;
+        PoseStreamHeader hdr{};
+        std::memcpy(hdr.magic, "VR3DPOSE", 8);
+        hdr.version = kPoseStreamVersion;
+        hdr.sample_size = sizeof(PoseSample);
+        std::fwrite(&hdr, sizeof(hdr), 1, file_);
+        return true;
+    }
+
+    void Close()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (file_) {
+            std::fclose(file_);
+            file_ = nullptr;
+        }
+    }
+
+    void Write(PoseSource source, double t, double qw, double qx, double qy, double qz,
+               double px, double py, double pz)
+    {
+        PoseSample s{};
+        s.t = t;
+        s.q[0] = static_cast<float>(qw);
+        s.q[1] = static_cast<float>(qx);
+        s.q[2] = static_cast<float>(qy);
+        s.q[3] = static_cast<float>(qz);
+        s.p[0] = static_cast<float>(px);
+        s.p[1] = static_cast<float>(py);
+        s.p[2] = static_cast<float>(pz);
+        s.source = static_cast<uint32_t>(source);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (file_)
+            std::fwrite(&s, sizeof(s), 1, file_);
+    }
+
+private:
+    std::mutex  mutex_;
+    std::FILE*  file_ = nullptr;
+};
+
+// Reads a whole recording. Returns false on a missing file or bad header;
+// a truncated trailing sample (driver killed mid-write) is dropped.
+inline bool ReadPoseStream(const char* path, std::vector<PoseSample>* out)
+{
+    std::FILE* f = OpenPoseStreamFile(path, "rb");
+    if (!f)
+        return false;
+    PoseStreamHeader hdr{};
+    if (std::fread(&hdr, sizeof(hdr), 1, f) != 1 || std::memcmp(hdr.magic, "VR3DPOSE", 8) != 0 ||
+        hdr.version != kPoseStreamVersion || hdr.sample_size < sizeof(PoseSample)) {
+        std::fclose(f);
+        return false;
+    }
+    std::vector<unsigned char> buf(hdr.sample_size);
+    while (std::fread(buf.data(), hdr.sample_size, 1, f) == 1) {
+        PoseSample s;
+        std::memcpy(&s, buf.data(), sizeof(s));
+        out->push_back(s);
+    }
+    std::fclose(f);
+    return true;
+}
+
+}  // namespace vrto3d
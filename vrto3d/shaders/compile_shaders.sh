@@ -71,3 +71,7 @@ emit() {
 
 emit fullscreen.vert fullscreen_vert
 emit repack.frag    repack_frag
+emit tile_hash.comp tile_hash_comp
+emit easu.comp      easu_comp
+emit rcas.comp      rcas_comp
+emit lanczos.comp   lanczos_comp
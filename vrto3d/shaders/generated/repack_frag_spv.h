@@ -45,6 +45,8 @@ static const uint32_t repack_frag_spv[] =
 0x00040047,0x000000b8,0x0000001e,0x00000000,
 0x00040047,0x0000013c,0x0000000b,0x0000000f,
 0x00040047,0x00000502,0x0000001e,0x00000000,
+0x00040047,0x0000001e,0x00000022,0x00000000,
+0x00040047,0x0000001e,0x00000021,0x00000001,
 0x00020013,0x00000002,0x00030021,0x00000003,
 0x00000002,0x00040015,0x00000006,0x00000020,
 0x00000001,0x00030016,0x00000008,0x00000020,
@@ -54,10 +56,10 @@ static const uint32_t repack_frag_spv[] =
 0x000c001e,0x0000001c,0x0000001b,0x0000001b,
 0x00000006,0x00000006,0x00000006,0x00000008,
 0x0000000a,0x0000000a,0x0000000a,0x0000000a,
-0x00040020,0x0000001d,0x00000009,0x0000001c,
-0x0004003b,0x0000001d,0x0000001e,0x00000009,
+0x00040020,0x0000001d,0x00000002,0x0000001c,
+0x0004003b,0x0000001d,0x0000001e,0x00000002,
 0x0004002b,0x00000006,0x0000001f,0x00000003,
-0x00040020,0x00000020,0x00000009,0x00000006,
+0x00040020,0x00000020,0x00000002,0x00000006,
 0x0004002b,0x00000006,0x00000023,0x00000000,
 0x00020014,0x00000024,0x0004002b,0x00000006,
 0x00000029,0x00000001,0x0004002b,0x00000008,
@@ -71,7 +73,7 @@ static const uint32_t repack_frag_spv[] =
 0x00000044,0x00000009,0x00040015,0x00000045,
 0x00000020,0x00000000,0x0004002b,0x00000045,
 0x00000046,0x00000000,0x00040020,0x00000047,
-0x00000009,0x00000008,0x0004002b,0x00000045,
+0x00000002,0x00000008,0x0004002b,0x00000045,
 0x0000004b,0x00000001,0x0004002b,0x00000045,
 0x0000004f,0x00000002,0x0004002b,0x00000006,
 0x00000055,0x00000005,0x0004002b,0x00000008,
@@ -79,7 +81,7 @@ static const uint32_t repack_frag_spv[] =
 0x0000006e,0x00000000,0x0004002b,0x00000008,
 0x00000077,0x3fc00000,0x0004002b,0x00000006,
 0x00000078,0x00000006,0x00040020,0x00000079,
-0x00000009,0x0000000a,0x0004002b,0x00000006,
+0x00000002,0x0000000a,0x0004002b,0x00000006,
 0x0000008c,0x00000008,0x0004002b,0x00000006,
 0x00000094,0x00000007,0x0004002b,0x00000006,
 0x000000a2,0x00000002,0x0004002b,0x00000006,
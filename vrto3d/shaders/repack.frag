@@ -31,9 +31,12 @@
 // 45 px for the 1080p variants — mirrors FramePackTimingSpec::gap_pixels,
 // which is what the Windows presenter feeds as `framepack_offset`).
 //
-// C++ mirror of the push-constant block (std430 layout, 96 bytes total):
+// The parameters sit in a uniform buffer bound with a dynamic offset, one
+// entry per frame slot and sink, so a recorded draw stays valid while the
+// config changes (VkRenderer::RecordRepack). C++ mirror of the block
+// (std140 layout, 96 bytes total):
 //
-//     struct RepackPushConstants {          // offset
+//     struct RepackParams {                 // offset
 //         int32_t out_size[2];              //   0  swapchain extent (w, h)
 //         int32_t eye_size[2];              //   8  per-eye pixel size of sbs
 //         int32_t mode;                     //  16  OutputMode int value
@@ -44,15 +47,15 @@
 //         float   gamma[4];                 //  48  rgb + pad
 //         float   gain[4];                  //  64  rgb + pad
 //         float   curve_offsets[4];         //  80  x=off_low y=off_high z=off_both w=unused
-//     };                                    //  96 bytes (<= 128 push-constant min-spec)
-//     static_assert(sizeof(RepackPushConstants) == 96);
+//     };                                    //  96 bytes
+//     static_assert(sizeof(RepackParams) == 96);
 
 layout(set = 0, binding = 0) uniform sampler2D sbs;
 
 layout(location = 0) in vec2 uv;
 layout(location = 0) out vec4 out_color;
 
-layout(push_constant) uniform Pc {
+layout(set = 0, binding = 1, std140) uniform Pc {
     ivec2 out_size;           // swapchain extent
     ivec2 eye_size;           // per-eye pixel size of sbs (sbs is 2*eye_size.x wide); reserved
     int   mode;               // OutputMode int value
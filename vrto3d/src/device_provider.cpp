@@ -39,19 +39,19 @@
 #include "vk/vk_renderer.h"
 #include "vk/direct_mode_component_vk.h"
 #endif
+#include "process_watch.h"
 #include "vr_recenter.h"
 
 namespace {
 
-// Sample the PID a few seconds after disconnect — most games take a moment
-// to fully exit after their SteamVR connection drops. If the PID is gone,
-// shut SteamVR down; otherwise the user still has the app running and we
-// leave SteamVR alone.
+// Give the game up to 5s after disconnect to exit — most take a moment to
+// fully terminate after their SteamVR connection drops. Shut SteamVR down
+// the moment the process is gone; if it outlives the grace period the user
+// still has the app running and we leave SteamVR alone.
 void ScheduleAutoExitCheck(uint32_t pid)
 {
     std::thread([pid]() {
-        std::this_thread::sleep_for(std::chrono::seconds(5));
-        if (IsProcessRunning(pid)) {
+        if (!vrto3d::ProcessWatch::Instance().WaitForExit(pid, std::chrono::seconds(5))) {
             LOG() << "auto_exit: pid " << pid
                   << " still running after 5s, leaving SteamVR alone";
             return;
@@ -180,6 +180,7 @@ void MyDeviceProvider::RunFrame()
                 app_name_ = appName;
                 app_pid_ = vrEvent.data.process.pid;
                 g_current_app_pid.store(app_pid_);
+                vrto3d::ProcessWatch::Instance().Watch(app_pid_);
                 LOG() << "AppName = " << app_name_.c_str()
                       << " (evt=" << (int)vrEvent.eventType
                       << " pid=" << vrEvent.data.process.pid << ")";
@@ -286,6 +287,8 @@ void MyDeviceProvider::Cleanup()
     // Our controller devices will have already deactivated. Let's now destroy them.
     my_hmd_device_ = nullptr;
 
+    vrto3d::ProcessWatch::Instance().Shutdown();
+
     // Tear down the background OpenVR client session we used for chaperone
     // recenters. vrserver flags an unclean exit if a VR_Init'd client never
     // VR_Shutdown's. This is the last hook called before our DLL unloads.
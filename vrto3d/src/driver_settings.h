@@ -0,0 +1,54 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+// Global driver switches from the driver_vrto3d section of the driver's
+// default.vrsettings; users override them in steamvr.vrsettings. Anything
+// that should follow the game lives in the profile sidecar instead
+// (profile_sidecar.h). A missing or mistyped key yields the fallback.
+
+#include <string>
+
+#include "openvr_driver.h"
+
+namespace vrto3d {
+
+inline constexpr const char* kDriverSettingsSection = "driver_vrto3d";
+
+inline bool DriverSettingBool(const char* key, bool fallback)
+{
+    vr::EVRSettingsError err = vr::VRSettingsError_None;
+    const bool v = vr::VRSettings()->GetBool(kDriverSettingsSection, key, &err);
+    return err == vr::VRSettingsError_None ? v : fallback;
+}
+
+inline float DriverSettingFloat(const char* key, float fallback)
+{
+    vr::EVRSettingsError err = vr::VRSettingsError_None;
+    const float v = vr::VRSettings()->GetFloat(kDriverSettingsSection, key, &err);
+    return err == vr::VRSettingsError_None ? v : fallback;
+}
+
+inline std::string DriverSettingString(const char* key, const std::string& fallback = std::string())
+{
+    char buf[1024] = {};
+    vr::EVRSettingsError err = vr::VRSettingsError_None;
+    vr::VRSettings()->GetString(kDriverSettingsSection, key, buf, sizeof(buf), &err);
+    return err == vr::VRSettingsError_None ? std::string(buf) : fallback;
+}
+
+} // namespace vrto3d
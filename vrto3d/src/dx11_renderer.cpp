@@ -347,6 +347,8 @@ void Dx11Renderer::VsyncTickThread()
     while (!vsync_stop_.load(std::memory_order_relaxed)) {
         std::this_thread::sleep_until(next);
         vr::VRServerDriverHost()->VsyncEvent(0.0);
+        if (auto* component = vsync_component_.load(std::memory_order_acquire))
+            component->FlushPublishedProperties();
         next += interval;
         // If we've fallen behind (e.g. process throttled), don't try to
         // catch up by firing back-to-back — re-anchor to "now + interval"
@@ -1238,6 +1240,7 @@ void Dx11Renderer::ConfigureOsd(StereoDisplayComponent* component,
                                 void* headset_hwnd)
 {
     osd_component_    = component;
+    vsync_component_.store(component, std::memory_order_release);
     osd_headset_hwnd_ = headset_hwnd;
     osd_pending_callbacks_ = std::make_unique<vrto3d::osd::MenuCallbacks>(std::move(callbacks));
     // Real OsdRenderer construction happens on the window thread on the next
@@ -220,6 +220,9 @@ private:
     std::thread            vsync_thread_;
     std::atomic<bool>      vsync_stop_{false};
     std::chrono::nanoseconds frame_interval_ns_{8'333'333};  // refined from cfg in Init
+    // Set by ConfigureOsd; the vsync tick flushes its rate-limited
+    // depth/projection writes (StereoDisplayComponent::FlushPublishedProperties).
+    std::atomic<StereoDisplayComponent*> vsync_component_{nullptr};
 
     // Compositor → window thread handoff. OnDirectModeFrame sets ready=true
     // after composite + Flush so the window thread wakes immediately and
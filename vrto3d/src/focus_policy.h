@@ -37,7 +37,7 @@ struct FocusInputs {
     bool     man_on_top = false;   // FocusContext::man_on_top
     bool     auto_focus = true;    // FocusContext::auto_focus
     uint32_t app_pid = 0;          // FocusContext::app_pid
-    bool     app_running = false;  // platform IsProcessRunning(app_pid)
+    bool     app_running = false;  // ProcessWatch::IsRunning(app_pid)
     bool     force_on_top = false; // caller override (OSD open, etc.)
 };
 
@@ -0,0 +1,271 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "gamepad_evdev_linux.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include "vrto3dlib/debug_log.hpp"
+
+namespace vrto3d {
+
+namespace {
+
+constexpr double kRescanIntervalSeconds = 2.0;
+
+double NowSeconds()
+{
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9;
+}
+
+bool TestBit(const unsigned long* bits, int bit)
+{
+    constexpr int kBitsPerLong = static_cast<int>(sizeof(unsigned long) * 8);
+    return (bits[bit / kBitsPerLong] >> (bit % kBitsPerLong)) & 1UL;
+}
+
+// A gamepad in the kernel's gamepad API sense: BTN_GAMEPAD plus a right
+// stick on ABS_RX/ABS_RY. Mice, keyboards, and joysticks without a second
+// stick are skipped.
+bool IsGamepadWithRightStick(int fd)
+{
+    constexpr int kLongs = (KEY_MAX / (sizeof(unsigned long) * 8)) + 1;
+    unsigned long key_bits[kLongs] = {};
+    unsigned long abs_bits[(ABS_MAX / (sizeof(unsigned long) * 8)) + 1] = {};
+    if (ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(key_bits)), key_bits) < 0 ||
+        ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(abs_bits)), abs_bits) < 0) {
+        return false;
+    }
+    return TestBit(key_bits, BTN_GAMEPAD) && TestBit(abs_bits, ABS_RX) && TestBit(abs_bits, ABS_RY);
+}
+
+} // namespace
+
+float EvdevGamepadStick::AxisRange::Normalize(int v) const
+{
+    const float center = 0.5f * (static_cast<float>(min) + static_cast<float>(max));
+    const float half = 0.5f * static_cast<float>(max - min);
+    if (half <= 0.0f)
+        return 0.0f;
+    return std::clamp((static_cast<float>(v) - center) / half, -1.0f, 1.0f);
+}
+
+EvdevGamepadStick::EvdevGamepadStick()
+{
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    Scan();
+}
+
+EvdevGamepadStick::~EvdevGamepadStick()
+{
+    CloseDevice();
+    if (wake_fd_ >= 0)
+        close(wake_fd_);
+}
+
+void EvdevGamepadStick::Scan()
+{
+    next_scan_ = NowSeconds() + kRescanIntervalSeconds;
+
+    DIR* dir = opendir("/dev/input");
+    if (!dir)
+        return;
+    while (dirent* ent = readdir(dir)) {
+        int n = 0;
+        if (std::sscanf(ent->d_name, "event%d", &n) != 1)
+            continue;
+        char path[64];
+        std::snprintf(path, sizeof(path), "/dev/input/%s", ent->d_name);
+        const int fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0)
+            continue;
+        if (!IsGamepadWithRightStick(fd)) {
+            close(fd);
+            continue;
+        }
+        int clock_id = CLOCK_MONOTONIC;
+        ioctl(fd, EVIOCSCLOCKID, &clock_id);
+
+        char name[128] = {};
+        ioctl(fd, EVIOCGNAME(sizeof(name) - 1), name);
+        LOG() << "Gamepad look input: " << name << " (" << path << ")";
+
+        dev_fd_ = fd;
+        Resync();
+        break;
+    }
+    closedir(dir);
+}
+
+void EvdevGamepadStick::CloseDevice()
+{
+    if (dev_fd_ >= 0) {
+        close(dev_fd_);
+        dev_fd_ = -1;
+    }
+    x_ = y_ = 0.0f;
+}
+
+// Re-read absolute state after open or SYN_DROPPED.
+void EvdevGamepadStick::Resync()
+{
+    input_absinfo info{};
+    if (ioctl(dev_fd_, EVIOCGABS(ABS_RX), &info) == 0) {
+        rx_range_.min = info.minimum;
+        rx_range_.max = info.maximum;
+        raw_rx_ = info.value;
+    }
+    if (ioctl(dev_fd_, EVIOCGABS(ABS_RY), &info) == 0) {
+        ry_range_.min = info.minimum;
+        ry_range_.max = info.maximum;
+        raw_ry_ = info.value;
+    }
+    x_ = rx_range_.Normalize(raw_rx_);
+    y_ = -ry_range_.Normalize(raw_ry_);  // evdev Y grows downward
+}
+
+void EvdevGamepadStick::Drain(std::vector<Sample>& out)
+{
+    input_event evs[64];
+    for (;;) {
+        const ssize_t n = read(dev_fd_, evs, sizeof(evs));
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno != EAGAIN) {
+                LOG() << "Gamepad look input: device lost, errno " << errno;
+                CloseDevice();
+                next_scan_ = NowSeconds() + kRescanIntervalSeconds;
+            }
+            return;
+        }
+        const size_t count = static_cast<size_t>(n) / sizeof(input_event);
+        for (size_t i = 0; i < count; ++i) {
+            const input_event& ev = evs[i];
+            if (ev.type == EV_ABS && ev.code == ABS_RX) {
+                raw_rx_ = ev.value;
+                dirty_ = true;
+            }
+            else if (ev.type == EV_ABS && ev.code == ABS_RY) {
+                raw_ry_ = ev.value;
+                dirty_ = true;
+            }
+            else if (ev.type == EV_SYN && ev.code == SYN_DROPPED) {
+                dropped_ = true;
+            }
+            else if (ev.type == EV_SYN && ev.code == SYN_REPORT) {
+                if (dropped_) {
+                    Resync();
+                    dropped_ = false;
+                    dirty_ = true;
+                }
+                else if (dirty_) {
+                    x_ = rx_range_.Normalize(raw_rx_);
+                    y_ = -ry_range_.Normalize(raw_ry_);
+                }
+                if (dirty_) {
+                    Sample s;
+                    s.t = static_cast<double>(ev.input_event_sec) +
+                          static_cast<double>(ev.input_event_usec) * 1e-6;
+                    s.x = x_;
+                    s.y = y_;
+                    out.push_back(s);
+                    dirty_ = false;
+                }
+            }
+        }
+        if (static_cast<size_t>(n) < sizeof(evs))
+            return;
+    }
+}
+
+void EvdevGamepadStick::Wait(int timeout_ms, std::vector<Sample>& out)
+{
+    if (dev_fd_ < 0 && NowSeconds() >= next_scan_)
+        Scan();
+    if (dev_fd_ < 0) {
+        // Come back for the next scan even when asked to block indefinitely.
+        const int until_scan = std::max(1, static_cast<int>(std::ceil((next_scan_ - NowSeconds()) * 1000.0)));
+        if (timeout_ms < 0 || timeout_ms > until_scan)
+            timeout_ms = until_scan;
+    }
+
+    pollfd fds[2];
+    nfds_t nfds = 0;
+    if (wake_fd_ >= 0)
+        fds[nfds++] = { wake_fd_, POLLIN, 0 };
+    const nfds_t dev_index = nfds;
+    if (dev_fd_ >= 0)
+        fds[nfds++] = { dev_fd_, POLLIN, 0 };
+
+    if (poll(fds, nfds, timeout_ms) <= 0)
+        return;
+
+    if (wake_fd_ >= 0 && (fds[0].revents & POLLIN)) {
+        uint64_t v = 0;
+        (void)!read(wake_fd_, &v, sizeof(v));
+    }
+    if (dev_fd_ >= 0 && dev_index < nfds) {
+        if (fds[dev_index].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+            LOG() << "Gamepad look input: device disconnected";
+            CloseDevice();
+            next_scan_ = NowSeconds() + kRescanIntervalSeconds;
+        }
+        else if (fds[dev_index].revents & POLLIN) {
+            Drain(out);
+        }
+    }
+}
+
+void EvdevGamepadStick::WaitForWake(int timeout_ms)
+{
+    if (wake_fd_ < 0) {
+        // No eventfd: degrade to a short sleep so the caller still polls.
+        constexpr int kFallbackMs = 100;
+        poll(nullptr, 0, timeout_ms < 0 ? kFallbackMs : std::min(timeout_ms, kFallbackMs));
+        return;
+    }
+    pollfd fd{ wake_fd_, POLLIN, 0 };
+    if (poll(&fd, 1, timeout_ms) > 0 && (fd.revents & POLLIN)) {
+        uint64_t v = 0;
+        (void)!read(wake_fd_, &v, sizeof(v));
+    }
+}
+
+void EvdevGamepadStick::Wake()
+{
+    if (wake_fd_ >= 0) {
+        const uint64_t one = 1;
+        (void)!write(wake_fd_, &one, sizeof(one));
+    }
+}
+
+} // namespace vrto3d
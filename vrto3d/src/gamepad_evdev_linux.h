@@ -0,0 +1,95 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+// Event-driven right-stick reader for XInputUpdateThread on Linux.
+//
+// VRto3DLib's evdev pump only exposes a latest-state snapshot, which forces
+// the look thread to poll. This opens the same gamepad node read-only (no
+// grab — the game still sees it) and blocks in poll() until the kernel
+// delivers an axis frame, so a centered stick costs no wakeups and every
+// deflection change arrives with its kernel timestamp.
+//
+// Timestamps are switched to CLOCK_MONOTONIC (EVIOCSCLOCKID) so they share
+// an epoch with std::chrono::steady_clock and the pose sample clock.
+
+#include <vector>
+
+namespace vrto3d {
+
+class EvdevGamepadStick {
+public:
+    // One SYN_REPORT frame. Axes are normalized to [-1, 1] in XInput
+    // convention (Y up), deadzone not applied.
+    struct Sample {
+        double t = 0.0;   // CLOCK_MONOTONIC seconds
+        float  x = 0.0f;
+        float  y = 0.0f;
+    };
+
+    EvdevGamepadStick();
+    ~EvdevGamepadStick();
+
+    EvdevGamepadStick(const EvdevGamepadStick&) = delete;
+    EvdevGamepadStick& operator=(const EvdevGamepadStick&) = delete;
+
+    // Blocks until an axis frame arrives, Wake() is called, or timeout_ms
+    // elapses (-1 = no timeout). Appends every frame read to `out`.
+    // Without an open device this sleeps until the timeout or the next
+    // device scan, whichever is sooner; scans run at most every couple of
+    // seconds.
+    void Wait(int timeout_ms, std::vector<Sample>& out);
+
+    // Blocks until Wake() is called or timeout_ms elapses (-1 = no timeout),
+    // ignoring stick motion. For a caller that has nothing to do with the
+    // stick until someone else tells it so. Frames queued meanwhile are
+    // read by the next Wait().
+    void WaitForWake(int timeout_ms);
+
+    // Unblocks a concurrent Wait() or WaitForWake(), or the next one if none
+    // is blocked. Safe from any thread.
+    void Wake();
+
+    bool HasDevice() const { return dev_fd_ >= 0; }
+
+    // Current stick position (valid once HasDevice()).
+    float X() const { return x_; }
+    float Y() const { return y_; }
+
+private:
+    struct AxisRange {
+        int   min = -32768;
+        int   max = 32767;
+        float Normalize(int v) const;
+    };
+
+    void Scan();
+    void CloseDevice();
+    void Resync();
+    void Drain(std::vector<Sample>& out);
+
+    int       dev_fd_ = -1;
+    int       wake_fd_ = -1;
+    double    next_scan_ = 0.0;
+    AxisRange rx_range_, ry_range_;
+    int       raw_rx_ = 0, raw_ry_ = 0;
+    float     x_ = 0.0f, y_ = 0.0f;
+    bool      dirty_ = false;
+    bool      dropped_ = false;
+};
+
+} // namespace vrto3d
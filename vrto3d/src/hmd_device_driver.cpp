@@ -26,7 +26,10 @@
 #include "vk/vk_renderer.h"
 #include "vrto3dlib/key_codes.h"
 #endif
+#include "driver_settings.h"
 #include "platform.h"
+#include "process_watch.h"
+#include "render_target_policy.h"
 #include "vrto3dlib/json_manager.h"
 #include "osd/osd_renderer.h"
 #include "osd/osd_menu.h"
@@ -52,6 +55,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <cmath>
 #include <vector>
 
 #ifdef _WIN32
@@ -171,6 +175,7 @@ MockControllerDeviceDriver::MockControllerDeviceDriver()
 
     // Profile settings
     json_manager.LoadProfileFromJson(DEF_CFG, display_configuration);
+    LoadProfileSidecar(DEF_CFG);
 
     // Resolve display-index-driven window bounds from the active desktop layout
 #ifdef _WIN32
@@ -189,6 +194,7 @@ MockControllerDeviceDriver::MockControllerDeviceDriver()
 
     // Instantiate our display component
     stereo_display_component_ = std::make_unique< StereoDisplayComponent >( display_configuration );
+    stereo_display_component_->SetOutputProfile(output_profile_);
 
     LOG() << "Default Config Loaded";
 }
@@ -271,6 +277,19 @@ vr::EVRInitError MockControllerDeviceDriver::Activate( uint32_t unObjectId )
             platform::ResolveTargetMonitors(cfg.display_index, false, primary, secondary);
         }
 
+        // Frame-packed HDMI modes switch the output to the packed timing's
+        // own refresh, with one stereo pair per refresh. The desktop rate
+        // read above (or a higher configured one) would have the game and
+        // compositor render 60 pairs a second for a 1080p24 output that can
+        // show only 24 of them.
+        if (const FramePackTimingSpec* spec = GetFramePackTimingSpec(cfg.output_mode)) {
+            if (spec->refresh_hz > 1.0f && cfg.display_frequency > spec->refresh_hz + 0.01f) {
+                LOG() << "Display: frame-packed output refreshes at " << spec->refresh_hz
+                      << "Hz, throttling from " << cfg.display_frequency << "Hz";
+                cfg.display_frequency = spec->refresh_hz;
+            }
+        }
+
         cfg.display_latency   = (cfg.display_frequency > 1.0f)
             ? (0.5f / cfg.display_frequency) : 0.011f;
         cfg.sleep_count_max   = (int)(floor(1600.0 / (1000.0 / cfg.display_frequency)));
@@ -284,6 +303,24 @@ vr::EVRInitError MockControllerDeviceDriver::Activate( uint32_t unObjectId )
         LOG() << "Display: target=" << primary.device_name
               << " freq=" << cfg.display_frequency << "Hz"
               << " latency=" << cfg.display_latency << "s";
+
+        // Opt-in (driver_vrto3d/render_size_from_output): ask the game for
+        // only the pixels this output mode displays, sized from the target
+        // monitor instead of render_width/height. SteamVR reads the size once
+        // at startup, before the renderer has brought up a presenter, so the
+        // monitor's current mode stands in for the presenter's output extent.
+        // Every presenter fills the target monitor at that mode, and
+        // frame-packed modes size from their packed timing instead, so the
+        // two agree. A mode change takes effect on the next launch.
+        if (vrto3d::DriverSettingBool("render_size_from_output", false) && primary.width > 0 && primary.height > 0) {
+            const float supersample = std::clamp(vrto3d::DriverSettingFloat("render_supersample", 1.0f), 0.25f, 2.0f);
+            const vrto3d::RenderTargetSize size = vrto3d::OutputMatchedRenderTargetSize(
+                cfg.output_mode, primary.width, primary.height, supersample);
+            stereo_display_component_->SetRecommendedRenderTargetSize(size.width, size.height);
+            LOG() << "Display: output-matched render target " << size.width << "x" << size.height
+                  << " per eye (output " << primary.width << "x" << primary.height
+                  << ", supersample " << supersample << ")";
+        }
     }
 
     // Display settings
@@ -445,6 +482,13 @@ vr::EVRInitError MockControllerDeviceDriver::Activate( uint32_t unObjectId )
     // placement + always-on-top) now live inside WindowPresenter, which is
     // owned by VirtualDisplayDevice and observes the focus atomics below via
     // GetFocusContext().
+    if (const std::string record_path = vrto3d::DriverSettingString("pose_record_path"); !record_path.empty()) {
+        if (pose_recorder_.Open(record_path.c_str()))
+            LOG() << "Recording raw pose samples to " << record_path;
+        else
+            LOG() << "Failed to open pose recording " << record_path;
+    }
+    stereo_display_component_->SetLookConfigListener([this] { WakeXInputThread(); });
     xinput_thread_ = std::thread(&MockControllerDeviceDriver::XInputUpdateThread, this);
     pose_thread_ = std::thread(&MockControllerDeviceDriver::PoseUpdateThread, this);
     hotkey_thread_ = std::thread(&MockControllerDeviceDriver::PollHotkeysThread, this);
@@ -508,6 +552,7 @@ vr::EVRInitError MockControllerDeviceDriver::Activate( uint32_t unObjectId )
                 if (prev_name_.empty()) return;
                 auto cfg = stereo_display_component_->GetConfig();
                 JsonManager().SaveProfileToJson(prev_name_ + "_config.json", cfg);
+                SaveProfileSidecar(prev_name_ + "_config.json");
                 if (renderer_ && renderer_->Osd()) renderer_->Osd()->SetText(toast);
             };
             cb.save_default_profile = [this](std::string toast) {
@@ -516,12 +561,14 @@ vr::EVRInitError MockControllerDeviceDriver::Activate( uint32_t unObjectId )
                 // output_mode, render dims, OpenTrack, track filter, LeiaSR,
                 // launch_script, etc.) — required so System-tab edits persist.
                 JsonManager().SaveFullConfigToJson(DEF_CFG, cfg);
+                SaveProfileSidecar(DEF_CFG);
                 if (renderer_ && renderer_->Osd()) renderer_->Osd()->SetText(toast);
             };
             cb.reload_game_profile = [this](std::string toast) {
                 if (prev_name_.empty()) return;
                 auto cfg = stereo_display_component_->GetConfig();
                 if (JsonManager().LoadProfileFromJson(prev_name_ + "_config.json", cfg)) {
+                    LoadProfileSidecar(prev_name_ + "_config.json");
                     stereo_display_component_->LoadSettings(cfg);
                     SetAsync(cfg.async_enable);
                     auto_focus_.store(cfg.auto_focus);
@@ -546,6 +593,7 @@ vr::EVRInitError MockControllerDeviceDriver::Activate( uint32_t unObjectId )
                 // LoadParamsFromJson reads exactly that superset.
                 JsonManager().LoadParamsFromJson(cfg);
                 if (JsonManager().LoadProfileFromJson(DEF_CFG, cfg)) {
+                    LoadProfileSidecar(DEF_CFG);
                     stereo_display_component_->LoadSettings(cfg);
                     SetAsync(cfg.async_enable);
                     auto_focus_.store(cfg.auto_focus);
@@ -629,9 +677,9 @@ vr::EVRInitError MockControllerDeviceDriver::Activate( uint32_t unObjectId )
 #endif  // LeiaSR is a Windows-only presenter
             };
             cb.recenter_pose = [this]() {
-                // Raise the flag; XInputUpdateThread picks it up on its next
-                // 8ms tick and ConsumePoseReset zeros pitch/yaw + OT state
-                // and dispatches the deferred OpenVR ResetZeroPose.
+                // Raise the flag; it wakes XInputUpdateThread, whose
+                // ConsumePoseReset zeros pitch/yaw + OT state and dispatches
+                // the deferred OpenVR ResetZeroPose.
                 stereo_display_component_->RequestPoseReset();
                 if (renderer_ && renderer_->Osd())
                     renderer_->Osd()->SetText("Recentered");
@@ -644,7 +692,7 @@ vr::EVRInitError MockControllerDeviceDriver::Activate( uint32_t unObjectId )
             cb.request_game_focus = [this]() {
                 uint32_t pid = app_pid_.load();
                 LOG() << "request_game_focus fired pid=" << pid;
-                if (pid == 0 || !IsProcessRunning(pid)) return;
+                if (pid == 0 || !vrto3d::ProcessWatch::Instance().IsRunning(pid)) return;
 #ifndef _WIN32
                 // No cross-client focus stealing on Wayland; X11 raise lives
                 // in the presenter's topmost handling.
@@ -972,16 +1020,22 @@ void MockControllerDeviceDriver::OpenTrackThread()
 
         if (bytes_read > 0) {
             const auto sample_time = std::chrono::steady_clock::now();
+            const double sample_time_seconds =
+                std::chrono::duration<double>(sample_time.time_since_epoch()).count();
+            vr::HmdQuaternion_t att;
+            std::array<double, 3> pos;
             {
                 std::lock_guard<std::mutex> lock(trk_mutex_);
                 open_track_att_ = HmdQuaternion_FromEulerAngles(DEG_TO_RAD(open_track.Roll), DEG_TO_RAD(open_track.Pitch), DEG_TO_RAD(-open_track.Yaw));
                 // Map Opentrack pose data to steam_vr coordinate system
                 open_track_pos_ = { -(open_track.X / 100.0f), -(open_track.Y / 100.0f), open_track.Z / 100.0f };
+                att = open_track_att_;
+                pos = open_track_pos_;
             }
 
-            open_track_pose_sample_time_seconds_.store(
-                std::chrono::duration<double>(sample_time.time_since_epoch()).count(),
-                std::memory_order_relaxed);
+            open_track_pose_sample_time_seconds_.store(sample_time_seconds, std::memory_order_relaxed);
+            pose_recorder_.Write(vrto3d::PoseSource::OpenTrack, sample_time_seconds,
+                                 att.w, att.x, att.y, att.z, pos[0], pos[1], pos[2]);
         }
         else std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
@@ -993,23 +1047,64 @@ void MockControllerDeviceDriver::OpenTrackThread()
 
 
 //-----------------------------------------------------------------------------
-// Purpose: Poll XInput and publish controller-derived rotation and offset
+// Purpose: Integrate gamepad right stick into controller rotation and offset
 //-----------------------------------------------------------------------------
 void MockControllerDeviceDriver::XInputUpdateThread()
 {
+    // ctrl_sensitivity was tuned as degrees per 8 ms poll; integrating by
+    // measured dt against that period keeps the turn rate users are used to
+    // while making it independent of scheduler jitter.
+    constexpr double kSensitivityPeriodSeconds = 0.008;
+    // Longest span integrated in one step, so a stalled thread doesn't turn
+    // a held stick into a sudden jump.
+    constexpr double kMaxStepSeconds = 0.1;
+    // Poll period while a deflection is held, or for XInput, which has no
+    // change notification. Otherwise the thread blocks until stick motion
+    // (evdev) or WakeXInputThread: config changes, recenter, Deactivate.
+    constexpr int kActiveWaitMs = 8;
+
     float current_pitch = 0.0f;
     vr::HmdQuaternion_t current_yaw_quat = HmdQuaternion_Identity;
     bool was_idle = false;
+    bool restart_clock = true;
+    double last_time = 0.0;
+    float held_x = 0.0f;  // deadzoned deflection applied since last_time
+    float held_y = 0.0f;
+
+    auto now_seconds = []() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    };
 
     while (is_active_)
     {
-        const auto loop_start = std::chrono::steady_clock::now();
         const auto config = stereo_display_component_->GetConfig();
 
+        // Advance pitch/yaw by the held deflection up to time t.
+        auto integrate_to = [&](double t) {
+            const double dt = std::clamp(t - last_time, 0.0, kMaxStepSeconds);
+            last_time = std::max(last_time, t);
+            const float scale = static_cast<float>(dt / kSensitivityPeriodSeconds) * config.ctrl_sensitivity;
+
+            if (config.pitch_enable && held_y != 0.0f)
+            {
+                current_pitch += held_y * scale;
+                current_pitch = std::clamp(current_pitch, -90.0f, 90.0f);
+            }
+
+            if (config.yaw_enable && held_x != 0.0f)
+            {
+                const float yaw_adjustment = -held_x * scale;
+                const vr::HmdQuaternion_t yaw_quat_adjust =
+                    QuaternionFromAxisAngle(0.0f, 1.0f, 0.0f, DEG_TO_RAD(yaw_adjustment));
+
+                current_yaw_quat = HmdQuaternion_Normalize(yaw_quat_adjust * current_yaw_quat);
+            }
+        };
+
         // When neither stick is consumed and no reset is pending, skip the
-        // XInput poll, math, and mutex publish. On the live→idle edge, clear
-        // the published controller pose once so PoseUpdateThread doesn't keep
-        // applying the last non-zero offset.
+        // math and mutex publish. On the live→idle edge, clear the published
+        // controller pose once so PoseUpdateThread doesn't keep applying the
+        // last non-zero offset.
         if (!config.pitch_enable && !config.yaw_enable && !config.pose_reset)
         {
             if (!was_idle)
@@ -1021,36 +1116,62 @@ void MockControllerDeviceDriver::XInputUpdateThread()
                     controller_rotation_ = HmdQuaternion_Identity;
                     controller_pos_offset_ = { 0.0, 0.0, 0.0 };
                 }
+                // The clear is a sample in its own right; the one-euro filter
+                // only advances on a newer stamp.
+                xinput_pose_sample_time_seconds_.store(now_seconds(), std::memory_order_relaxed);
                 was_idle = true;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(8));
+            restart_clock = true;
+            WaitForXInputWake(-1);
             continue;
         }
         was_idle = false;
 
-        XINPUT_STATE state;
-        ZeroMemory(&state, sizeof(XINPUT_STATE));
-        const bool got_xinput = (_XInputGetState(0, &state) == ERROR_SUCCESS);
-
-        if (config.pitch_enable && got_xinput)
+        if (restart_clock)
         {
-            float normalized_y = state.Gamepad.sThumbRY / 32767.0f;
-            normalized_y = ApplyDeadzone(normalized_y, config.ctrl_deadzone);
-
-            current_pitch += (normalized_y * config.ctrl_sensitivity);
-            current_pitch = std::clamp(current_pitch, -90.0f, 90.0f);
+            last_time = now_seconds();
+            held_x = held_y = 0.0f;
+            restart_clock = false;
         }
 
-        if (config.yaw_enable && got_xinput)
+        double sample_time_seconds = 0.0;
+#ifndef _WIN32
+        if (gamepad_stick_.HasDevice())
         {
-            float normalized_x = state.Gamepad.sThumbRX / 32767.0f;
-            normalized_x = ApplyDeadzone(normalized_x, config.ctrl_deadzone);
-
-            const float yaw_adjustment = -normalized_x * config.ctrl_sensitivity;
-            const vr::HmdQuaternion_t yaw_quat_adjust =
-                QuaternionFromAxisAngle(0.0f, 1.0f, 0.0f, DEG_TO_RAD(yaw_adjustment));
-
-            current_yaw_quat = HmdQuaternion_Normalize(yaw_quat_adjust * current_yaw_quat);
+            // Event path: sleep until the kernel reports a stick frame or a
+            // wake arrives, or one active period while a deflection is held
+            // (it keeps turning without producing events). Each frame closes
+            // the segment held since the previous one at its kernel timestamp.
+            const bool holding = held_x != 0.0f || held_y != 0.0f;
+            std::vector<vrto3d::EvdevGamepadStick::Sample> samples;
+            gamepad_stick_.Wait(holding ? kActiveWaitMs : -1, samples);
+            for (const auto& s : samples)
+            {
+                integrate_to(s.t);
+                held_x = ApplyDeadzone(s.x, config.ctrl_deadzone);
+                held_y = ApplyDeadzone(s.y, config.ctrl_deadzone);
+            }
+            sample_time_seconds = now_seconds();
+            integrate_to(sample_time_seconds);
+        }
+        else
+#endif
+        {
+            // Polled path (XInput, or no readable evdev gamepad): the state
+            // read now stands for the interval since the previous poll.
+            XINPUT_STATE state;
+            ZeroMemory(&state, sizeof(XINPUT_STATE));
+            if (_XInputGetState(0, &state) == ERROR_SUCCESS)
+            {
+                held_x = ApplyDeadzone(state.Gamepad.sThumbRX / 32767.0f, config.ctrl_deadzone);
+                held_y = ApplyDeadzone(state.Gamepad.sThumbRY / 32767.0f, config.ctrl_deadzone);
+            }
+            else
+            {
+                held_x = held_y = 0.0f;
+            }
+            sample_time_seconds = now_seconds();
+            integrate_to(sample_time_seconds);
         }
 
         if (config.pose_reset)
@@ -1087,18 +1208,60 @@ void MockControllerDeviceDriver::XInputUpdateThread()
             controller_pos_offset_ = controller_pos_offset;
         }
 
-        const auto sample_time = std::chrono::steady_clock::now();
-        xinput_pose_sample_time_seconds_.store(
-            std::chrono::duration<double>(sample_time.time_since_epoch()).count(),
-            std::memory_order_relaxed);
+        xinput_pose_sample_time_seconds_.store(sample_time_seconds, std::memory_order_relaxed);
+        pose_recorder_.Write(vrto3d::PoseSource::Gamepad, sample_time_seconds,
+                             controller_rotation.w, controller_rotation.x,
+                             controller_rotation.y, controller_rotation.z,
+                             controller_pos_offset[0], controller_pos_offset[1],
+                             controller_pos_offset[2]);
 
-        const auto elapsed = std::chrono::steady_clock::now() - loop_start;
-        const auto xinput_period = std::chrono::milliseconds(8); // 125Hz
-        if (elapsed < xinput_period)
+#ifdef _WIN32
+        // XInput has no change notification; keep polling at the active rate.
+        WaitForXInputWake(kActiveWaitMs);
+#else
+        if (!gamepad_stick_.HasDevice())
         {
-            std::this_thread::sleep_for(xinput_period - elapsed);
+            // Doubles as the poll-rate sleep and the hotplug rescan.
+            std::vector<vrto3d::EvdevGamepadStick::Sample> discard;
+            gamepad_stick_.Wait(kActiveWaitMs, discard);
         }
+#endif
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Block XInputUpdateThread until woken or timeout_ms passes
+//-----------------------------------------------------------------------------
+void MockControllerDeviceDriver::WaitForXInputWake(int timeout_ms)
+{
+#ifdef _WIN32
+    std::unique_lock<std::mutex> lock(xinput_wake_mutex_);
+    if (timeout_ms < 0)
+        xinput_wake_cv_.wait(lock, [this] { return xinput_wake_; });
+    else
+        xinput_wake_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this] { return xinput_wake_; });
+    xinput_wake_ = false;
+#else
+    gamepad_stick_.WaitForWake(timeout_ms);
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Wake XInputUpdateThread; latched until its next wait
+//-----------------------------------------------------------------------------
+void MockControllerDeviceDriver::WakeXInputThread()
+{
+#ifdef _WIN32
+    {
+        std::lock_guard<std::mutex> lock(xinput_wake_mutex_);
+        xinput_wake_ = true;
     }
+    xinput_wake_cv_.notify_all();
+#else
+    gamepad_stick_.Wake();
+#endif
 }
 
 
@@ -1120,6 +1283,7 @@ void MockControllerDeviceDriver::PoseUpdateThread()
             if (track_filter_was_enabled_)
             {
                 track_filter_.Reset();
+                track_euro_filter_.Reset();
                 track_filter_was_enabled_ = false;
             }
 
@@ -1144,39 +1308,107 @@ void MockControllerDeviceDriver::PoseUpdateThread()
                 controller_pos_offset = controller_pos_offset_;
             }
 
+            vrto3d::TrackFilterSelection filter_sel;
+            if (config.use_track_filter)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(track_filter_sel_mutex_);
+                    filter_sel = track_filter_sel_;
+                }
+                // Reset on the disabled→enabled edge so the filter doesn't carry
+                // stale state (potentially minutes old) into its first FilterPose
+                // call when the OSD toggles use_track_filter on. Without this the
+                // initial samples produce noisy output until the filter resettles.
+                // A profile switching filter type is treated the same way.
+                if (!track_filter_was_enabled_ || filter_sel.type != track_filter_active_type_)
+                {
+                    track_filter_.Reset();
+                    track_euro_filter_.Reset();
+                    track_filter_active_type_ = filter_sel.type;
+                }
+                track_filter_was_enabled_ = true;
+            }
+            else if (track_filter_was_enabled_)
+            {
+                track_filter_.Reset();
+                track_euro_filter_.Reset();
+                track_filter_was_enabled_ = false;
+            }
+
+            // Tracker component on its own: OpenTrack's attitude/offset, or the
+            // gamepad's rotation/offset when OpenTrack is off.
+            vr::HmdQuaternion_t tracker_rotation = controller_rotation;
+            double tracker_position[3] = {
+                controller_pos_offset[0],
+                controller_pos_offset[1],
+                controller_pos_offset[2]
+            };
+            if (config.use_open_track)
+            {
+                std::lock_guard<std::mutex> lock(trk_mutex_);
+                tracker_rotation = open_track_att_;
+                tracker_position[0] = open_track_pos_[0];
+                tracker_position[1] = open_track_pos_[1];
+                tracker_position[2] = open_track_pos_[2];
+                pose_sample_time = open_track_pose_sample_time_seconds_.load(std::memory_order_relaxed);
+            }
+            else
+            {
+                pose_sample_time = xinput_pose_sample_time_seconds_.load(std::memory_order_relaxed);
+            }
+
+            // The one-euro filter runs on the tracker sample clock and only sees
+            // the tracker component, so polls between samples hold its output
+            // while the config offsets, hotkey yaw and gamepad look composed
+            // around it below stay live. Nothing to filter until the first
+            // sample has arrived.
+            const bool euro_filter = config.use_track_filter &&
+                filter_sel.type == vrto3d::TrackFilterType::OneEuro;
+            if (euro_filter && pose_sample_time > 0.0)
+            {
+                track_euro_filter_.FilterPose(tracker_rotation, tracker_position, filter_sel.one_euro,
+                                              pose_sample_time);
+            }
+
             const vr::HmdQuaternion_t hmd_yaw_quat =
                 QuaternionFromAxisAngle(0.0f, 1.0f, 0.0f, DEG_TO_RAD(config.hmd_yaw));
-            const vr::HmdQuaternion_t final_controller_rotation =
-                HmdQuaternion_Normalize(hmd_yaw_quat * controller_rotation);
 
             pose.qWorldFromDriverRotation = HmdQuaternion_Identity;
             pose.qDriverFromHeadRotation = HmdQuaternion_Identity;
-            pose.qRotation = final_controller_rotation;
 
             // Calculate Position
-            pose.vecPosition[0] = config.hmd_x;
-            pose.vecPosition[1] = config.hmd_height;
-            pose.vecPosition[2] = config.hmd_y;
+            pose.vecPosition[0] = config.hmd_x + tracker_position[0];
+            pose.vecPosition[1] = config.hmd_height + tracker_position[1];
+            pose.vecPosition[2] = config.hmd_y + tracker_position[2];
             if (config.use_open_track)
             {
-                std::lock_guard<std::mutex> lock(trk_mutex_);
-                pose.qRotation = HmdQuaternion_Normalize(final_controller_rotation * open_track_att_);
-                pose.vecPosition[0] += open_track_pos_[0];
-                pose.vecPosition[1] += open_track_pos_[1];
-                pose.vecPosition[2] += open_track_pos_[2];
-                pose_sample_time = open_track_pose_sample_time_seconds_.load(std::memory_order_relaxed);
+                const vr::HmdQuaternion_t final_controller_rotation =
+                    HmdQuaternion_Normalize(hmd_yaw_quat * controller_rotation);
+                pose.qRotation = HmdQuaternion_Normalize(final_controller_rotation * tracker_rotation);
             }
             else
             {
-                pose.qRotation = final_controller_rotation;
-                pose.vecPosition[0] += controller_pos_offset[0];
-                pose.vecPosition[1] += controller_pos_offset[1];
-                pose.vecPosition[2] += controller_pos_offset[2];
+                pose.qRotation = HmdQuaternion_Normalize(hmd_yaw_quat * tracker_rotation);
                 if (pose.vecPosition[1] < config.hmd_height - 1.0)
                 {
                     pose.vecPosition[1] = config.hmd_height - 1.0;
                 }
-                pose_sample_time = xinput_pose_sample_time_seconds_.load(std::memory_order_relaxed);
+            }
+
+            // Accela smooths the composed pose on the pose-thread clock.
+            if (config.use_track_filter && !euro_filter)
+            {
+                double filtered_position[3] = {
+                    pose.vecPosition[0],
+                    pose.vecPosition[1],
+                    pose.vecPosition[2]
+                };
+                vr::HmdQuaternion_t filtered_rotation = pose.qRotation;
+                track_filter_.FilterPose(filtered_rotation, filtered_position, config);
+                pose.qRotation = filtered_rotation;
+                pose.vecPosition[0] = filtered_position[0];
+                pose.vecPosition[1] = filtered_position[1];
+                pose.vecPosition[2] = filtered_position[2];
             }
 
             pose.poseIsValid = true;
@@ -1186,35 +1418,6 @@ void MockControllerDeviceDriver::PoseUpdateThread()
             pose.willDriftInYaw = false;
         }
 
-        if (config.use_track_filter)
-        {
-            // Reset on the disabled→enabled edge so the filter doesn't carry
-            // stale state (potentially minutes old) into its first FilterPose
-            // call when the OSD toggles use_track_filter on. Without this the
-            // initial samples produce noisy output until the filter resettles.
-            if (!track_filter_was_enabled_)
-            {
-                track_filter_.Reset();
-            }
-            double filtered_position[3] = {
-                pose.vecPosition[0],
-                pose.vecPosition[1],
-                pose.vecPosition[2]
-            };
-            vr::HmdQuaternion_t filtered_rotation = pose.qRotation;
-            track_filter_.FilterPose(filtered_rotation, filtered_position, config);
-            pose.qRotation = filtered_rotation;
-            pose.vecPosition[0] = filtered_position[0];
-            pose.vecPosition[1] = filtered_position[1];
-            pose.vecPosition[2] = filtered_position[2];
-            track_filter_was_enabled_ = true;
-        }
-        else if (track_filter_was_enabled_)
-        {
-            track_filter_.Reset();
-            track_filter_was_enabled_ = false;
-        }
-
         if (pose_sample_time > 0.0)
         {
             const double pose_publish_time_seconds =
@@ -1293,15 +1496,10 @@ void MockControllerDeviceDriver::PollHotkeysThread() {
 
     setOverlay("VRto3D: " + stereo_version_number_);
 
-    // Deferred projection re-sync for the depth/convergence hotkeys.
-    // ResetProjection() posts SetDisplayProjectionRaw + a LensDistortionChanged
-    // event that most VR mods answer by rebuilding their projection; firing it
-    // at poll rate while a key autorepeats makes adjustment feel laggy. The
-    // flush at the bottom of the loop resyncs immediately on the first press,
-    // at most every 150ms while held, and once more on release so the final
-    // value always lands.
-    bool resync_pending = false;
-    auto last_resync = std::chrono::steady_clock::now() - std::chrono::seconds(1);
+    // Projection re-syncs requested by the depth/convergence hotkeys below go
+    // through the component's PropertyPublisher, which sends the first press
+    // at once, rate-limits while a key autorepeats, and lands the final value
+    // on the next vsync flush after release.
 
     while (is_active_) {
         auto cfg = stereo_display_component_->GetConfig();
@@ -1338,25 +1536,23 @@ void MockControllerDeviceDriver::PollHotkeysThread() {
             // Ctrl+F3 Decrease Depth (re-sync projection; hold Shift to skip the sync)
             if (isCtrlDown() && isDown(VK_F3)) {
                 stereo_display_component_->AdjustDepth(-0.001f, true);
-                if (!isDown(VK_SHIFT)) resync_pending = true;
+                if (!isDown(VK_SHIFT)) stereo_display_component_->ResetProjection();
                 setOverlay(fmtDepthConv());
             }
             // Ctrl+F4 Increase Depth (re-sync projection; hold Shift to skip the sync)
             else if (isCtrlDown() && isDown(VK_F4)) {
                 stereo_display_component_->AdjustDepth(0.001f, true);
-                if (!isDown(VK_SHIFT)) resync_pending = true;
+                if (!isDown(VK_SHIFT)) stereo_display_component_->ResetProjection();
                 setOverlay(fmtDepthConv());
             }
             // Ctrl+F5 Decrease Convergence
             else if (isCtrlDown() && isDown(VK_F5)) {
-                stereo_display_component_->AdjustConvergence(0.005f, true, false);
-                resync_pending = true;
+                stereo_display_component_->AdjustConvergence(0.005f, true);
                 setOverlay(fmtDepthConv());
             }
             // Ctrl+F6 Increase Convergence
             else if (isCtrlDown() && isDown(VK_F6)) {
-                stereo_display_component_->AdjustConvergence(-0.005f, true, false);
-                resync_pending = true;
+                stereo_display_component_->AdjustConvergence(-0.005f, true);
                 setOverlay(fmtDepthConv());
             }
             // Ctrl+F7 Store settings into game profile
@@ -1366,6 +1562,7 @@ void MockControllerDeviceDriver::PollHotkeysThread() {
                     // reflected in the saved file.
                     auto save_cfg = stereo_display_component_->GetConfig();
                     JsonManager().SaveProfileToJson(prev_name_ + "_config.json", save_cfg);
+                    SaveProfileSidecar(prev_name_ + "_config.json");
                     BeepSuccess();
                     setOverlay("Saved " + prev_name_ + "_config.json profile");
                 }
@@ -1387,6 +1584,7 @@ void MockControllerDeviceDriver::PollHotkeysThread() {
                     app_name_ = prev_name_;
                 }
                 if (JsonManager().LoadProfileFromJson(path, cfg)) {
+                    LoadProfileSidecar(path);
                     stereo_display_component_->LoadSettings(cfg);
                     SetAsync(cfg.async_enable);
                     auto_focus_.store(cfg.auto_focus);
@@ -1471,18 +1669,9 @@ void MockControllerDeviceDriver::PollHotkeysThread() {
             no_profile_ = false;
         }
 
-        // Flush a deferred depth/convergence projection re-sync (see the
-        // resync_pending comment above the loop for the batching rules).
-        if (resync_pending) {
-            const bool adjust_held = isCtrlDown() &&
-                (isDown(VK_F3) || isDown(VK_F4) || isDown(VK_F5) || isDown(VK_F6));
-            const auto now = std::chrono::steady_clock::now();
-            if (!adjust_held || now - last_resync >= std::chrono::milliseconds(150)) {
-                stereo_display_component_->ResetProjection();
-                resync_pending = false;
-                last_resync = now;
-            }
-        }
+        // Backstop for the renderer's vsync flush (renderer not up yet, or
+        // failed to init) so rate-limited values still land.
+        stereo_display_component_->FlushPublishedProperties();
 
         // Sleep for ~ 1 frame
         std::this_thread::sleep_for(std::chrono::milliseconds(sleep_time));
@@ -1515,6 +1704,20 @@ void MockControllerDeviceDriver::MonitorModeThread() {
     auto& rx = uevr::receiver();
     static float last_hint_ipd = -1.0f;
 
+    // The UEVR plugin exposes one depth-command slot that it can only refill
+    // after we clear it, so the poll rate bounds how fast a burst of steps
+    // lands. Poll about once a frame just after a command or a monitor-mode
+    // change, then double the interval back up to the connected rate, and
+    // only retry the mapping slowly while nothing is attached.
+    constexpr auto kActivePoll = std::chrono::milliseconds(8);
+    constexpr auto kConnectedPoll = std::chrono::milliseconds(100);
+    constexpr auto kDisconnectedPoll = std::chrono::milliseconds(1000);
+    // How long the fast rate is kept after the last command or mode change.
+    constexpr auto kActiveHold = std::chrono::seconds(2);
+    auto last_activity = std::chrono::steady_clock::now() - kActiveHold;
+    auto quiet_poll = kConnectedPoll;
+    bool was_mon = false;
+
     while (is_active_) {
         const auto config = stereo_display_component_->GetConfig();
 
@@ -1531,6 +1734,10 @@ void MockControllerDeviceDriver::MonitorModeThread() {
 
         const bool mon = rx.is_connected() && rx.get_monitor_mode();
         stereo_display_component_->SetMonitorMode(mon);
+        if (mon != was_mon) {
+            last_activity = std::chrono::steady_clock::now();
+            was_mon = mon;
+        }
 
         if (mon)
         {
@@ -1573,10 +1780,23 @@ void MockControllerDeviceDriver::MonitorModeThread() {
                     app_updated_ = true;
                 }
                 rx.clear_depth_request();
+                last_activity = std::chrono::steady_clock::now();
             }
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+        auto poll = kDisconnectedPoll;
+        if (rx.is_connected()) {
+            if (std::chrono::steady_clock::now() - last_activity < kActiveHold) {
+                quiet_poll = kActivePoll;
+                poll = kActivePoll;
+            }
+            else {
+                quiet_poll = (std::min)(quiet_poll * 2, kConnectedPoll);
+                poll = quiet_poll;
+            }
+        }
+        std::unique_lock<std::mutex> lock(monitor_wake_mutex_);
+        monitor_wake_cv_.wait_for(lock, poll, [this] { return !is_active_; });
     }
 }
 
@@ -1893,6 +2113,7 @@ void MockControllerDeviceDriver::LoadSettings(const std::string& app_name, uint3
         // Attempt to read the JSON settings file
         if (JsonManager().LoadProfileFromJson(app_name + "_config.json", config))
         {
+            LoadProfileSidecar(app_name + "_config.json");
             stereo_display_component_->LoadSettings(config);
             LOG() << "Loaded " << app_name.c_str() << " profile";
             BeepSuccess();
@@ -1961,12 +2182,13 @@ void MockControllerDeviceDriver::LoadSettings(const std::string& app_name, uint3
         // Some games briefly disconnect from SteamVR (compositor blip,
         // scene-app handoff) and immediately reconnect with the same exe
         // still alive. Wait 15s, then re-engage focus if the original
-        // process is still running and no new app has connected since.
+        // process is still running and no new app has connected since;
+        // give up early if it exits in the meantime.
         uint32_t pid = app_pid_.load();
         std::thread([this, pid]() {
-            std::this_thread::sleep_for(std::chrono::seconds(15));
+            if (vrto3d::ProcessWatch::Instance().WaitForExit(pid, std::chrono::seconds(15))) return;
             if (!is_active_) return;
-            if (app_pid_.load() == pid && IsProcessRunning(pid)) {
+            if (app_pid_.load() == pid) {
                 is_on_top_ = true;
                 man_on_top_ = true;
                 focus_pre_disconnect_.store(false);
@@ -2016,6 +2238,43 @@ void MockControllerDeviceDriver::SetAsync(bool enable)
 }
 
 
+//-----------------------------------------------------------------------------
+// Purpose: Pick up the head-tracking filter and output options from a profile
+//-----------------------------------------------------------------------------
+void MockControllerDeviceDriver::LoadProfileSidecar(const std::string& profile_file)
+{
+    std::lock_guard<std::mutex> lock(track_filter_sel_mutex_);
+    if (vrto3d::LoadTrackFilterSelection(profile_file, track_filter_sel_))
+    {
+        LOG() << "Track filter: " << vrto3d::TrackFilterTypeName(track_filter_sel_.type)
+              << " (" << profile_file.c_str() << ")";
+    }
+    vrto3d::LoadOutputProfileOptions(profile_file, output_profile_);
+    if (stereo_display_component_)
+        stereo_display_component_->SetOutputProfile(output_profile_);
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Re-add the sidecar keys after JsonManager rewrote a profile file
+//-----------------------------------------------------------------------------
+void MockControllerDeviceDriver::SaveProfileSidecar(const std::string& profile_file)
+{
+    vrto3d::TrackFilterSelection sel;
+    vrto3d::OutputProfileOptions opts;
+    {
+        std::lock_guard<std::mutex> lock(track_filter_sel_mutex_);
+        sel = track_filter_sel_;
+        opts = output_profile_;
+    }
+    if (!vrto3d::SaveTrackFilterSelection(profile_file, sel) ||
+        !vrto3d::SaveOutputProfileOptions(profile_file, opts))
+    {
+        LOG() << "Profile sidecar: failed to write keys to " << profile_file.c_str();
+    }
+}
+
+
 //-----------------------------------------------------------------------------
 // Purpose: Stub for Standby mode
 //-----------------------------------------------------------------------------
@@ -2065,6 +2324,7 @@ void MockControllerDeviceDriver::Deactivate()
     LOG() << "MockControllerDeviceDriver::Deactivate";
     if ( is_active_.exchange( false ) )
     {
+        WakeXInputThread();
         if (xinput_thread_.joinable()) {
             xinput_thread_.join();
         }
@@ -2074,6 +2334,10 @@ void MockControllerDeviceDriver::Deactivate()
         if (hotkey_thread_.joinable()) {
             hotkey_thread_.join();
         }
+        {
+            std::lock_guard<std::mutex> lock(monitor_wake_mutex_);
+        }
+        monitor_wake_cv_.notify_all();
         if (monitor_thread_.joinable()) {
             monitor_thread_.join();
         }
@@ -2086,6 +2350,7 @@ void MockControllerDeviceDriver::Deactivate()
         if (watchdog_thread_.joinable()) {
             watchdog_thread_.join();
         }
+        pose_recorder_.Close();
         // Direct-mode component holds a raw Dx11Renderer*; destroy it first
         // so any in-flight SubmitLayer/Present can no longer reach the
         // renderer before the renderer is torn down.
@@ -2123,6 +2388,21 @@ StereoDisplayComponent::StereoDisplayComponent( const StereoDisplayDriverConfigu
 void StereoDisplayComponent::Init(uint32_t device_index) 
 {
     device_index_ = device_index;
+
+    // Rate limits for the game-visible property writes (driver_vrto3d section
+    // of default.vrsettings); missing keys fall back to the defaults here.
+    vrto3d::PropertyPublisher::Limits ipd;
+    ipd.min_interval_s = vrto3d::DriverSettingFloat("publish_ipd_interval_ms", 33.0f) / 1000.0;
+    ipd.threshold      = vrto3d::DriverSettingFloat("publish_ipd_threshold", 0.0001f);
+    vrto3d::PropertyPublisher::Limits projection;
+    projection.min_interval_s = vrto3d::DriverSettingFloat("publish_projection_interval_ms", 150.0f) / 1000.0;
+    projection.threshold      = vrto3d::DriverSettingFloat("publish_projection_threshold", 0.0005f);
+
+    publisher_.Configure(device_index, ipd, projection,
+        [this](vr::HmdRect2_t& left, vr::HmdRect2_t& right) {
+            GetProjectionRaw(vr::Eye_Left, &left.vTopLeft.v[0], &left.vBottomRight.v[0], &left.vTopLeft.v[1], &left.vBottomRight.v[1]);
+            GetProjectionRaw(vr::Eye_Right, &right.vTopLeft.v[0], &right.vBottomRight.v[0], &right.vTopLeft.v[1], &right.vBottomRight.v[1]);
+        });
 }
 
 
@@ -2138,12 +2418,40 @@ bool StereoDisplayComponent::IsDisplayRealDisplay() { return false; }
 
 //-----------------------------------------------------------------------------
 // Purpose: To inform the rest of the vr system what the recommended target size should be
+// The profile's render_scale applies on top; SteamVR may keep the size it
+// read at startup until it restarts.
 //-----------------------------------------------------------------------------
 void StereoDisplayComponent::GetRecommendedRenderTargetSize( uint32_t *pnWidth, uint32_t *pnHeight )
 {
     std::shared_lock<std::shared_mutex> lock(cfg_mutex_);
-    *pnWidth  = static_cast<uint32_t>(config_.render_width);
-    *pnHeight = static_cast<uint32_t>(config_.render_height);
+    uint32_t width  = static_cast<uint32_t>(config_.render_width);
+    uint32_t height = static_cast<uint32_t>(config_.render_height);
+    if (recommended_width_ != 0 && recommended_height_ != 0) {
+        width  = recommended_width_;
+        height = recommended_height_;
+    }
+    const float scale = std::clamp(output_profile_.render_scale, 0.25f, 2.0f);
+    *pnWidth  = std::max<uint32_t>(1, static_cast<uint32_t>(std::lround(width * scale)));
+    *pnHeight = std::max<uint32_t>(1, static_cast<uint32_t>(std::lround(height * scale)));
+}
+
+void StereoDisplayComponent::SetRecommendedRenderTargetSize(uint32_t width, uint32_t height)
+{
+    std::unique_lock<std::shared_mutex> lock(cfg_mutex_);
+    recommended_width_  = width;
+    recommended_height_ = height;
+}
+
+void StereoDisplayComponent::SetOutputProfile(const vrto3d::OutputProfileOptions& opts)
+{
+    std::unique_lock<std::shared_mutex> lock(cfg_mutex_);
+    output_profile_ = opts;
+}
+
+vrto3d::OutputProfileOptions StereoDisplayComponent::GetOutputProfile()
+{
+    std::shared_lock<std::shared_mutex> lock(cfg_mutex_);
+    return output_profile_;
 }
 
 //-----------------------------------------------------------------------------
@@ -2261,8 +2569,7 @@ void StereoDisplayComponent::ApplyDepth(float new_depth)
     if (new_depth < 0.0f) new_depth = 0.0f;
     float cur_depth = GetDepth();
     while (!depth_.compare_exchange_weak(cur_depth, new_depth, std::memory_order_relaxed));
-    vr::PropertyContainerHandle_t container = vr::VRProperties()->TrackedDeviceToPropertyContainer(device_index_);
-    vr::VRProperties()->SetFloatProperty(container, vr::Prop_UserIpdMeters_Float, new_depth);
+    publisher_.SetIpd(new_depth);
 }
 
 
@@ -2425,9 +2732,9 @@ void StereoDisplayComponent::FeedAutoDepthSample(uint32_t max_disp_px, uint32_t
     }
     const float cur      = GetDepth();
     const float smoothed = cur + (target_depth - cur) * smoothing;
-    // The lerp never exactly converges, and every ApplyDepth pushes a
+    // The lerp never exactly converges, and every ApplyDepth queues a
     // SteamVR property write — skip sub-epsilon deltas so a settled loop
-    // stops churning vrserver.
+    // stops churning the publisher.
     if (std::fabs(smoothed - cur) > 1e-6f) {
         ApplyDepth(smoothed);
     }
@@ -2437,7 +2744,7 @@ void StereoDisplayComponent::FeedAutoDepthSample(uint32_t max_disp_px, uint32_t
 //-----------------------------------------------------------------------------
 // Purpose: To update the Convergence value
 //-----------------------------------------------------------------------------
-void StereoDisplayComponent::AdjustConvergence(float new_conv, bool is_delta, bool resync)
+void StereoDisplayComponent::AdjustConvergence(float new_conv, bool is_delta)
 {
     float cur_conv = GetConvergence();
     if (is_delta) {
@@ -2447,9 +2754,7 @@ void StereoDisplayComponent::AdjustConvergence(float new_conv, bool is_delta, bo
     if (NearlyEqual(cur_conv, new_conv))
         return;
     while (!convergence_.compare_exchange_weak(cur_conv, new_conv, std::memory_order_relaxed));
-    // resync=false lets the hotkey poll loop batch the projection re-sync
-    // instead of firing it on every autorepeat tick.
-    if (resync) ResetProjection();
+    publisher_.RequestProjection(false);
 }
 
 
@@ -2462,7 +2767,7 @@ void StereoDisplayComponent::AdjustFoV(float new_fov)
     if (NearlyEqual(cur_fov, new_fov))
         return;
     while (!fov_.compare_exchange_weak(cur_fov, new_fov, std::memory_order_relaxed));
-    ResetProjection();
+    publisher_.RequestProjection(false);
 }
 
 
@@ -2570,7 +2875,11 @@ std::string StereoDisplayComponent::CheckUserSettings()
 
     // Update the config
     std::unique_lock<std::shared_mutex> lock(cfg_mutex_);
+    const bool look_changed = LookConfigDiffers(config_, config);
     config_ = config;
+    lock.unlock();
+    if (look_changed)
+        NotifyLookConfigChanged();
 
     return overlay_msg;
 }
@@ -2587,6 +2896,8 @@ void StereoDisplayComponent::AdjustSensitivity(float delta)
         config_.ctrl_sensitivity += delta;
         if (config_.ctrl_sensitivity < 0.0f)
             config_.ctrl_sensitivity = 0.0f;
+        lock.unlock();
+        NotifyLookConfigChanged();
     }
 }
 
@@ -2602,6 +2913,8 @@ void StereoDisplayComponent::AdjustRadius(float delta)
         config_.pitch_radius += delta;
         if (config_.pitch_radius < 0.0f)
             config_.pitch_radius = 0.0f;
+        lock.unlock();
+        NotifyLookConfigChanged();
     }
 }
 
@@ -2707,6 +3020,34 @@ void StereoDisplayComponent::RequestPoseReset()
 {
     std::unique_lock<std::shared_mutex> lock(cfg_mutex_);
     config_.pose_reset = true;
+    lock.unlock();
+    NotifyLookConfigChanged();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Register the look-config change hook (XInputUpdateThread's wake)
+//-----------------------------------------------------------------------------
+void StereoDisplayComponent::SetLookConfigListener(std::function<void()> listener)
+{
+    look_config_listener_ = std::move(listener);
+}
+
+
+void StereoDisplayComponent::NotifyLookConfigChanged()
+{
+    if (look_config_listener_)
+        look_config_listener_();
+}
+
+
+// True when b differs from a in a field XInputUpdateThread acts on.
+bool StereoDisplayComponent::LookConfigDiffers(const StereoDisplayDriverConfiguration& a,
+                                               const StereoDisplayDriverConfiguration& b)
+{
+    return a.pitch_enable != b.pitch_enable || a.yaw_enable != b.yaw_enable ||
+           a.pose_reset != b.pose_reset || a.pitch_radius != b.pitch_radius ||
+           a.ctrl_sensitivity != b.ctrl_sensitivity || a.ctrl_deadzone != b.ctrl_deadzone;
 }
 
 
@@ -2734,6 +3075,7 @@ void StereoDisplayComponent::LoadSettings(StereoDisplayDriverConfiguration& conf
     std::unique_lock<std::shared_mutex> lock(cfg_mutex_);
     config_ = config;
     lock.unlock();
+    NotifyLookConfigChanged();
     ResetProjection();
 }
 
@@ -2743,13 +3085,17 @@ void StereoDisplayComponent::LoadSettings(StereoDisplayDriverConfiguration& conf
 //-----------------------------------------------------------------------------
 void StereoDisplayComponent::ResetProjection()
 {
-    // Regenerate the Projection
-    vr::HmdRect2_t eyeLeft, eyeRight;
-    GetProjectionRaw(vr::Eye_Left, &eyeLeft.vTopLeft.v[0], &eyeLeft.vBottomRight.v[0], &eyeLeft.vTopLeft.v[1], &eyeLeft.vBottomRight.v[1]);
-    GetProjectionRaw(vr::Eye_Right, &eyeRight.vTopLeft.v[0], &eyeRight.vBottomRight.v[0], &eyeRight.vTopLeft.v[1], &eyeRight.vBottomRight.v[1]);
-    vr::VREvent_Data_t temp;
-    vr::VRServerDriverHost()->SetDisplayProjectionRaw(device_index_, eyeLeft, eyeRight);
-    vr::VRServerDriverHost()->VendorSpecificEvent(device_index_, vr::VREvent_LensDistortionChanged, temp, 0.0f);
+    // Regenerated from GetProjectionRaw when the publisher sends it
+    publisher_.RequestProjection(true);
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Send rate-limited depth / projection updates that are now due
+//-----------------------------------------------------------------------------
+void StereoDisplayComponent::FlushPublishedProperties()
+{
+    publisher_.Flush();
 }
 
 
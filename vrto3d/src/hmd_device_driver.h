@@ -18,12 +18,20 @@
 #include "openvr_driver.h"
 #include <array>
 #include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <thread>
 #include <shared_mutex>
 #include <string>
 
 #include "accela_hamilton_runtime.h"
 #include "focus_context.h"
+#include "pose_stream.h"
+#include "property_publisher.h"
+#include "profile_sidecar.h"
+#ifndef _WIN32
+#include "gamepad_evdev_linux.h"
+#endif
 #include "vrto3dlib/json_manager.h"
 #include "vrto3dlib/uevr_receiver.hpp"
 
@@ -65,9 +73,16 @@ public:
     vr::DistortionCoordinates_t ComputeDistortion( vr::EVREye eEye, float fU, float fV ) override;
     bool ComputeInverseDistortion(vr::HmdVector2_t* pResult, vr::EVREye eEye, uint32_t unChannel, float fU, float fV) override;
     void GetWindowBounds( int32_t *pnX, int32_t *pnY, uint32_t *pnWidth, uint32_t *pnHeight ) override;
+    // Overrides render_width/height in GetRecommendedRenderTargetSize (the
+    // output-matched sizing policy); 0x0 goes back to the config values.
+    void SetRecommendedRenderTargetSize(uint32_t width, uint32_t height);
+    // Active profile's output options; the renderer compares each frame and
+    // re-applies them to the presenters when they change.
+    void SetOutputProfile(const vrto3d::OutputProfileOptions& opts);
+    vrto3d::OutputProfileOptions GetOutputProfile();
     StereoDisplayDriverConfiguration GetConfig();
     void AdjustDepth(float new_depth, bool is_delta);
-    void AdjustConvergence(float new_conv, bool is_delta, bool resync = true);
+    void AdjustConvergence(float new_conv, bool is_delta);
     void AdjustFoV(float new_fov);
     float GetDepth();
     float GetConvergence();
@@ -112,22 +127,44 @@ public:
     // (zeros pitch/yaw, OpenTrack state, and clears the flag via
     // MockControllerDeviceDriver::ConsumePoseReset).
     void RequestPoseReset();
+    // Called after a write that changes what XInputUpdateThread acts on
+    // (look enables, pitch radius, sensitivity, deadzone, pose reset), so
+    // that thread can block while idle instead of polling the config. Set
+    // once before the thread starts.
+    void SetLookConfigListener(std::function<void()> listener);
     void LoadSettings(StereoDisplayDriverConfiguration& config);
+    // Explicit re-sync: always re-sends the projection + LensDistortionChanged
+    // (within the publisher's rate limit) even if nothing moved.
     void ResetProjection();
+    // Publishes depth / projection changes held back by the rate limits.
+    // Called from the renderers' vsync tick.
+    void FlushPublishedProperties();
     void Init(uint32_t device_index);
 
 private:
-    // Push new depth into depth_ (atomic CAS) and the OpenVR
-    // Prop_UserIpdMeters_Float property. Used by both manual and auto paths.
+    // Push new depth into depth_ (atomic CAS) and queue the OpenVR
+    // Prop_UserIpdMeters_Float write. Used by both manual and auto paths.
     void ApplyDepth(float new_depth);
 
+    void NotifyLookConfigChanged();
+    static bool LookConfigDiffers(const StereoDisplayDriverConfiguration& a,
+                                  const StereoDisplayDriverConfiguration& b);
+
+    // All IPD / projection writes go through here (see property_publisher.h).
+    vrto3d::PropertyPublisher publisher_;
+
     StereoDisplayDriverConfiguration config_;
+    std::function<void()> look_config_listener_;
     std::atomic< float > depth_;
     std::atomic< float > convergence_;
     std::atomic< float > fov_;
     std::atomic< uint32_t > device_index_;
 
     std::shared_mutex  cfg_mutex_;
+    // Output-matched render size; 0 = use render_width/height. Guarded by cfg_mutex_.
+    uint32_t recommended_width_ = 0;
+    uint32_t recommended_height_ = 0;
+    vrto3d::OutputProfileOptions output_profile_;  // guarded by cfg_mutex_
 
     // UE3D Monitor Mode
     std::atomic< bool > monitor_mode_{ false };
@@ -178,6 +215,11 @@ public:
 
     void OpenTrackThread();
     void XInputUpdateThread();
+    // XInputUpdateThread's wait: returns on WakeXInputThread (config change,
+    // recenter, Deactivate) or after timeout_ms (-1 = no timeout). Stick
+    // motion does not end it.
+    void WaitForXInputWake(int timeout_ms);
+    void WakeXInputThread();
     void PoseUpdateThread();
     void PollHotkeysThread();
     void MonitorModeThread();
@@ -199,6 +241,11 @@ public:
     void LoadSettings(const std::string& app_name, uint32_t app_pid, vr::EVREventType status);
     void SetAsync(bool enable);
 
+    // Mirror a profile's sidecar keys (track filter + output options) next to
+    // each JsonManager load or save of the same file (profile_sidecar.h).
+    void LoadProfileSidecar(const std::string& profile_file);
+    void SaveProfileSidecar(const std::string& profile_file);
+
     // Pose-reset consumption point. Called by XInputUpdateThread (and the
     // OSD Recenter button path) once the XInput-derived pitch/yaw have been
     // zeroed: also zeros the cached OpenTrack attitude/position so disabling
@@ -262,11 +309,26 @@ private:
     vr::HmdQuaternion_t controller_rotation_ = { 1.0, 0.0, 0.0, 0.0 };
     std::array<double, 3> controller_pos_offset_ = { 0.0, 0.0, 0.0 };
     std::atomic< double > xinput_pose_sample_time_seconds_ = 0.0;
+#ifndef _WIN32
+    // Right-stick events for XInputUpdateThread. Its wake eventfd also
+    // carries WakeXInputThread, so the thread blocks in poll() for both.
+    vrto3d::EvdevGamepadStick gamepad_stick_;
+#else
+    // XInputUpdateThread waits here while look is off and between XInput
+    // polls; WakeXInputThread raises xinput_wake_.
+    std::mutex xinput_wake_mutex_;
+    std::condition_variable xinput_wake_cv_;
+    bool xinput_wake_ = false;
+#endif
 
     std::thread xinput_thread_;
     std::thread pose_thread_;
     std::thread hotkey_thread_;
     std::thread monitor_thread_;
+    // MonitorModeThread sleeps on this between UEVR shared-memory polls so
+    // Deactivate doesn't wait out a long idle interval.
+    std::mutex monitor_wake_mutex_;
+    std::condition_variable monitor_wake_cv_;
     std::thread track_thread_;
     std::thread cursor_thread_;
     std::thread watchdog_thread_;
@@ -277,5 +339,19 @@ private:
     std::mutex trk_mutex_;
 
     AccelaHamiltonRuntimeFilter track_filter_;
+    OneEuroPoseFilter track_euro_filter_;
     bool track_filter_was_enabled_ = false;
+    // Written by profile loads, snapshotted by PoseUpdateThread each tick.
+    std::mutex track_filter_sel_mutex_;
+    vrto3d::TrackFilterSelection track_filter_sel_;
+    // Also under track_filter_sel_mutex_; pushed to the display component,
+    // which the renderer polls.
+    vrto3d::OutputProfileOptions output_profile_;
+    vrto3d::TrackFilterType track_filter_active_type_ = vrto3d::TrackFilterType::AccelaHamilton;
+
+    // Raw OpenTrack / gamepad sample dump for offline filter tuning
+    // (tools/filter_bench). Opened in Activate only when
+    // driver_vrto3d/pose_record_path names an output file; Write is a no-op
+    // otherwise.
+    vrto3d::PoseStreamWriter pose_recorder_;
 };
@@ -128,7 +128,8 @@ void EnablePerMonitorV2DpiAwareness();
 #endif  // _WIN32
 
 
-// Lightweight process helpers (for focus-thread's "is the tracked app still running?" check).
+// One-shot OS probe for "is this PID alive?". Per-frame and focus checks go
+// through vrto3d::ProcessWatch, which caches this and falls back to it.
 bool IsProcessRunning(uint32_t pid);
 
 }  // namespace platform
@@ -0,0 +1,470 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "presenter/drm_display_presenter.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <drm.h>
+#include <drm_mode.h>
+
+#include "presenter/frame_pack_mode.h"
+#include "presenter/wayland_drm_lease.h"
+
+namespace vrto3d {
+
+namespace {
+
+int DrmIoctl(int fd, unsigned long request, void* arg)
+{
+    int r;
+    do {
+        r = ioctl(fd, request, arg);
+    } while (r == -1 && (errno == EINTR || errno == EAGAIN));
+    return r;
+}
+
+// Id and current value of the property `name` on a KMS object.
+bool FindDrmProperty(int fd, uint32_t obj_id, uint32_t obj_type, const char* name,
+                     uint32_t* prop_id, uint64_t* value)
+{
+    drm_mode_obj_get_properties counts{};
+    counts.obj_id = obj_id;
+    counts.obj_type = obj_type;
+    if (DrmIoctl(fd, DRM_IOCTL_MODE_OBJ_GETPROPERTIES, &counts) != 0 || counts.count_props == 0)
+        return false;
+    std::vector<uint32_t> ids(counts.count_props);
+    std::vector<uint64_t> values(counts.count_props);
+    drm_mode_obj_get_properties props{};
+    props.obj_id = obj_id;
+    props.obj_type = obj_type;
+    props.count_props = counts.count_props;
+    props.props_ptr = reinterpret_cast<uintptr_t>(ids.data());
+    props.prop_values_ptr = reinterpret_cast<uintptr_t>(values.data());
+    if (DrmIoctl(fd, DRM_IOCTL_MODE_OBJ_GETPROPERTIES, &props) != 0)
+        return false;
+    for (uint32_t i = 0; i < std::min(props.count_props, counts.count_props); ++i) {
+        drm_mode_get_property prop{};
+        prop.prop_id = ids[i];
+        if (DrmIoctl(fd, DRM_IOCTL_MODE_GETPROPERTY, &prop) != 0)
+            continue;
+        if (std::strncmp(prop.name, name, DRM_PROP_NAME_LEN) == 0) {
+            *prop_id = ids[i];
+            *value = values[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+bool DeviceExtensionSupported(VkPhysicalDevice phys, const char* name)
+{
+    uint32_t count = 0;
+    vkEnumerateDeviceExtensionProperties(phys, nullptr, &count, nullptr);
+    std::vector<VkExtensionProperties> exts(count);
+    vkEnumerateDeviceExtensionProperties(phys, nullptr, &count, exts.data());
+    for (const auto& e : exts)
+        if (std::strcmp(e.extensionName, name) == 0) return true;
+    return false;
+}
+
+}  // namespace
+
+
+DrmDisplayPresenter::DrmDisplayPresenter() = default;
+
+
+DrmDisplayPresenter::~DrmDisplayPresenter()
+{
+    Shutdown();
+}
+
+
+uint32_t DrmDisplayPresenter::OpenCardNode(int32_t display_index)
+{
+    // The primary node's minor is the N in /dev/dri/cardN.
+    std::string path = "/dev/dri/card0";
+    if (DeviceExtensionSupported(ctx_->phys, VK_EXT_PHYSICAL_DEVICE_DRM_EXTENSION_NAME)) {
+        VkPhysicalDeviceDrmPropertiesEXT drm{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DRM_PROPERTIES_EXT};
+        VkPhysicalDeviceProperties2 props{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2};
+        props.pNext = &drm;
+        vkGetPhysicalDeviceProperties2(ctx_->phys, &props);
+        if (drm.hasPrimary)
+            path = "/dev/dri/card" + std::to_string(drm.primaryMinor);
+    }
+
+    card_fd_ = open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if (card_fd_ < 0) {
+        PresenterLog("DrmDisplayPresenter: open(%s) failed (%s)", path.c_str(), std::strerror(errno));
+        return 0;
+    }
+
+    drm_mode_card_res res{};
+    if (DrmIoctl(card_fd_, DRM_IOCTL_MODE_GETRESOURCES, &res) != 0 || res.count_connectors == 0) {
+        PresenterLog("DrmDisplayPresenter: %s has no KMS connectors", path.c_str());
+        return 0;
+    }
+    std::vector<uint32_t> ids(res.count_connectors);
+    drm_mode_card_res fill{};
+    fill.connector_id_ptr = reinterpret_cast<uintptr_t>(ids.data());
+    fill.count_connectors = res.count_connectors;
+    if (DrmIoctl(card_fd_, DRM_IOCTL_MODE_GETRESOURCES, &fill) != 0)
+        return 0;
+    ids.resize(std::min<size_t>(ids.size(), fill.count_connectors));
+
+    // Same 1-based connected-output numbering as the X11/Wayland presenters.
+    int32_t connected_seen = 0;
+    for (uint32_t id : ids) {
+        drm_mode_get_connector conn{};
+        conn.connector_id = id;
+        if (DrmIoctl(card_fd_, DRM_IOCTL_MODE_GETCONNECTOR, &conn) != 0)
+            continue;
+        if (conn.connection != 1)  // DRM_MODE_CONNECTED
+            continue;
+        ++connected_seen;
+        if (display_index <= 0 || connected_seen == display_index) {
+            PresenterLog("DrmDisplayPresenter: %s connector %u (type %u-%u)", path.c_str(), id,
+                         conn.connector_type, conn.connector_type_id);
+            return id;
+        }
+    }
+    PresenterLog("DrmDisplayPresenter: no connected connector for display_index=%d on %s",
+                 display_index, path.c_str());
+    return 0;
+}
+
+
+VkDisplayModeKHR DrmDisplayPresenter::PickMode(const StereoDisplayDriverConfiguration& cfg,
+                                               VkExtent2D* extent)
+{
+    VkPhysicalDevice phys = ctx_->phys;
+    uint32_t count = 0;
+    vkGetDisplayModePropertiesKHR(phys, display_, &count, nullptr);
+    std::vector<VkDisplayModePropertiesKHR> modes(count);
+    vkGetDisplayModePropertiesKHR(phys, display_, &count, modes.data());
+    modes.resize(count);
+
+    // Frame-packed: the spec's active size at the refresh its modeline
+    // yields. The porches aren't expressible here, so this relies on the
+    // sink (or an EDID override) advertising the timing.
+    if (const FramePackTimingSpec* spec = GetFramePackTimingSpec(cfg.output_mode)) {
+        const uint32_t want_mhz = FramePackRefreshMilliHz(*spec);
+        for (const auto& m : modes) {
+            const VkDisplayModeParametersKHR& p = m.parameters;
+            if (p.visibleRegion.width == spec->active_w && p.visibleRegion.height == spec->active_h &&
+                (p.refreshRate > want_mhz ? p.refreshRate - want_mhz : want_mhz - p.refreshRate) <= 500) {
+                *extent = p.visibleRegion;
+                return m.displayMode;
+            }
+        }
+        VkDisplayModeCreateInfoKHR mci{VK_STRUCTURE_TYPE_DISPLAY_MODE_CREATE_INFO_KHR};
+        mci.parameters.visibleRegion = {spec->active_w, spec->active_h};
+        mci.parameters.refreshRate = want_mhz;
+        VkDisplayModeKHR created = VK_NULL_HANDLE;
+        if (vkCreateDisplayModeKHR(phys, display_, &mci, nullptr, &created) == VK_SUCCESS) {
+            *extent = mci.parameters.visibleRegion;
+            return created;
+        }
+        PresenterLog("DrmDisplayPresenter: frame-packed %ux%u@%.3fHz not offered by the sink — "
+                     "using its native mode (see the README's EDID override)",
+                     spec->active_w, spec->active_h, want_mhz / 1000.0);
+    }
+
+    // Native: the panel's physical resolution at its highest refresh,
+    // else the largest mode.
+    VkExtent2D native{};
+    uint32_t dcount = 0;
+    vkGetPhysicalDeviceDisplayPropertiesKHR(phys, &dcount, nullptr);
+    std::vector<VkDisplayPropertiesKHR> displays(dcount);
+    vkGetPhysicalDeviceDisplayPropertiesKHR(phys, &dcount, displays.data());
+    for (uint32_t i = 0; i < dcount; ++i)
+        if (displays[i].display == display_) native = displays[i].physicalResolution;
+
+    const VkDisplayModePropertiesKHR* best = nullptr;
+    auto better = [&](const VkDisplayModePropertiesKHR& m) {
+        if (!best) return true;
+        const VkExtent2D a = m.parameters.visibleRegion, b = best->parameters.visibleRegion;
+        const bool a_native = a.width == native.width && a.height == native.height;
+        const bool b_native = b.width == native.width && b.height == native.height;
+        if (a_native != b_native) return a_native;
+        const uint64_t area_a = (uint64_t)a.width * a.height, area_b = (uint64_t)b.width * b.height;
+        if (area_a != area_b) return area_a > area_b;
+        return m.parameters.refreshRate > best->parameters.refreshRate;
+    };
+    for (const auto& m : modes)
+        if (better(m)) best = &m;
+    if (!best) return VK_NULL_HANDLE;
+    *extent = best->parameters.visibleRegion;
+    return best->displayMode;
+}
+
+
+bool DrmDisplayPresenter::CreatePlaneSurface(VkDisplayModeKHR mode, VkExtent2D extent)
+{
+    VkPhysicalDevice phys = ctx_->phys;
+    uint32_t plane_count = 0;
+    vkGetPhysicalDeviceDisplayPlanePropertiesKHR(phys, &plane_count, nullptr);
+    std::vector<VkDisplayPlanePropertiesKHR> planes(plane_count);
+    vkGetPhysicalDeviceDisplayPlanePropertiesKHR(phys, &plane_count, planes.data());
+
+    for (uint32_t i = 0; i < plane_count; ++i) {
+        if (planes[i].currentDisplay != VK_NULL_HANDLE && planes[i].currentDisplay != display_)
+            continue;
+        uint32_t n = 0;
+        vkGetDisplayPlaneSupportedDisplaysKHR(phys, i, &n, nullptr);
+        std::vector<VkDisplayKHR> supported(n);
+        vkGetDisplayPlaneSupportedDisplaysKHR(phys, i, &n, supported.data());
+        bool ok = false;
+        for (uint32_t d = 0; d < n; ++d)
+            if (supported[d] == display_) ok = true;
+        if (!ok) continue;
+
+        VkDisplayPlaneCapabilitiesKHR caps{};
+        vkGetDisplayPlaneCapabilitiesKHR(phys, mode, i, &caps);
+        if (!(caps.supportedAlpha & VK_DISPLAY_PLANE_ALPHA_OPAQUE_BIT_KHR))
+            continue;
+
+        VkDisplaySurfaceCreateInfoKHR sci{VK_STRUCTURE_TYPE_DISPLAY_SURFACE_CREATE_INFO_KHR};
+        sci.displayMode = mode;
+        sci.planeIndex = i;
+        sci.planeStackIndex = planes[i].currentStackIndex;
+        sci.transform = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+        sci.globalAlpha = 1.0f;
+        sci.alphaMode = VK_DISPLAY_PLANE_ALPHA_OPAQUE_BIT_KHR;
+        sci.imageExtent = extent;
+        if (vkCreateDisplayPlaneSurfaceKHR(ctx_->instance, &sci, nullptr, &vk_surface_) == VK_SUCCESS)
+            return true;
+    }
+    PresenterLog("DrmDisplayPresenter: no usable plane for the display");
+    return false;
+}
+
+
+bool DrmDisplayPresenter::Init(vrto3d::vk::DeviceCtx* ctx, const StereoDisplayDriverConfiguration& cfg)
+{
+    ctx_ = ctx;
+    if (!ctx_->drm_display) {
+        PresenterLog("DrmDisplayPresenter: Vulkan loader lacks VK_KHR_display / "
+                     "VK_EXT_acquire_drm_display");
+        return false;
+    }
+    get_drm_display_ = (PFN_vkGetDrmDisplayEXT)vkGetInstanceProcAddr(ctx_->instance, "vkGetDrmDisplayEXT");
+    acquire_drm_display_ =
+        (PFN_vkAcquireDrmDisplayEXT)vkGetInstanceProcAddr(ctx_->instance, "vkAcquireDrmDisplayEXT");
+    release_display_ = (PFN_vkReleaseDisplayEXT)vkGetInstanceProcAddr(ctx_->instance, "vkReleaseDisplayEXT");
+    if (!get_drm_display_ || !acquire_drm_display_ || !release_display_) {
+        PresenterLog("DrmDisplayPresenter: display acquisition entry points unavailable");
+        return false;
+    }
+
+    // A running compositor owns DRM master: ask it for a lease first.
+    uint32_t connector_id = 0;
+    int drm_fd = -1;
+    const char* wl = std::getenv("WAYLAND_DISPLAY");
+    if (wl && wl[0] != '\0') {
+        lease_ = std::make_unique<WaylandDrmLease>();
+        if (lease_->Acquire(cfg.display_index)) {
+            connector_id = lease_->ConnectorId();
+            drm_fd = lease_->LeaseFd();
+        } else {
+            lease_.reset();
+        }
+    }
+    if (!lease_) {
+        connector_id = OpenCardNode(cfg.display_index);
+        drm_fd = card_fd_;
+    }
+    if (connector_id == 0) {
+        Shutdown();
+        return false;
+    }
+    drm_fd_ = drm_fd;
+    connector_id_ = connector_id;
+
+    if (cfg.output_mode == OutputMode::DualDisplay || cfg.output_mode == OutputMode::DualDisplayFlip)
+        PresenterLog("DrmDisplayPresenter: DualDisplay drives a single connector here");
+
+    VkResult r = get_drm_display_(ctx_->phys, drm_fd, connector_id, &display_);
+    if (r != VK_SUCCESS || display_ == VK_NULL_HANDLE) {
+        PresenterLog("DrmDisplayPresenter: vkGetDrmDisplayEXT failed (r=%d)", static_cast<int>(r));
+        Shutdown();
+        return false;
+    }
+    r = acquire_drm_display_(ctx_->phys, drm_fd, display_);
+    if (r != VK_SUCCESS) {
+        PresenterLog("DrmDisplayPresenter: vkAcquireDrmDisplayEXT failed (r=%d) — the fd must be "
+                     "DRM master (no compositor on this seat) or a lease", static_cast<int>(r));
+        Shutdown();
+        return false;
+    }
+    acquired_ = true;
+
+    VkExtent2D extent{};
+    VkDisplayModeKHR mode = PickMode(cfg, &extent);
+    if (mode == VK_NULL_HANDLE) {
+        PresenterLog("DrmDisplayPresenter: display reports no modes");
+        Shutdown();
+        return false;
+    }
+    if (!CreatePlaneSurface(mode, extent) ||
+        !swapchain_.Create(ctx_, vk_surface_, extent.width, extent.height)) {
+        Shutdown();
+        return false;
+    }
+
+    PresenterLog("DrmDisplayPresenter: up via %s, %ux%u", lease_ ? "lease" : "card node",
+                 swapchain_.extent.width, swapchain_.extent.height);
+    return true;
+}
+
+
+void DrmDisplayPresenter::Shutdown()
+{
+    if (swapchain_.ctx) {
+        swapchain_.Destroy();
+    }
+    if (vk_surface_ != VK_NULL_HANDLE && ctx_ && ctx_->instance != VK_NULL_HANDLE) {
+        vkDestroySurfaceKHR(ctx_->instance, vk_surface_, nullptr);
+    }
+    vk_surface_ = VK_NULL_HANDLE;
+
+    if (acquired_ && release_display_ && ctx_) {
+        release_display_(ctx_->phys, display_);
+    }
+    acquired_ = false;
+    display_ = VK_NULL_HANDLE;
+
+    lease_.reset();
+    if (card_fd_ >= 0) {
+        close(card_fd_);
+        card_fd_ = -1;
+    }
+    drm_fd_ = -1;
+    connector_id_ = 0;
+    vrr_wanted_ = vrr_applied_ = false;
+    ctx_ = nullptr;
+}
+
+
+bool DrmDisplayPresenter::Present(uint32_t image_index, VkSemaphore wait_sem)
+{
+    const bool ok = swapchain_.Present(image_index, wait_sem);
+    // A few seconds of frames is plenty for the first modeset to land.
+    constexpr int kMaxVrrAttempts = 600;
+    if (vrr_wanted_ != vrr_applied_ && vrr_attempts_ < kMaxVrrAttempts) {
+        if (++vrr_attempts_ == kMaxVrrAttempts)
+            PresenterLog("DrmDisplayPresenter: no CRTC to set VRR_ENABLED on — giving up");
+        ApplyVariableRefresh();
+    }
+    return ok;
+}
+
+
+bool DrmDisplayPresenter::SetVariableRefresh(bool enable)
+{
+    if (drm_fd_ < 0 || connector_id_ == 0) return false;
+    uint32_t prop = 0;
+    uint64_t capable = 0;
+    if (enable && (!FindDrmProperty(drm_fd_, connector_id_, DRM_MODE_OBJECT_CONNECTOR,
+                                    "vrr_capable", &prop, &capable) || capable == 0)) {
+        PresenterLog("DrmDisplayPresenter: connector is not VRR capable");
+        return false;
+    }
+    vrr_wanted_ = enable;
+    vrr_attempts_ = 0;
+    // Re-applied after the next flip if no CRTC is bound yet.
+    vrr_applied_ = !enable;
+    ApplyVariableRefresh();
+    return true;
+}
+
+
+bool DrmDisplayPresenter::ApplyVariableRefresh()
+{
+    drm_mode_get_connector conn{};
+    conn.connector_id = connector_id_;
+    if (DrmIoctl(drm_fd_, DRM_IOCTL_MODE_GETCONNECTOR, &conn) != 0 || conn.encoder_id == 0)
+        return false;
+    drm_mode_get_encoder enc{};
+    enc.encoder_id = conn.encoder_id;
+    if (DrmIoctl(drm_fd_, DRM_IOCTL_MODE_GETENCODER, &enc) != 0 || enc.crtc_id == 0)
+        return false;
+
+    uint32_t prop = 0;
+    uint64_t current = 0;
+    if (!FindDrmProperty(drm_fd_, enc.crtc_id, DRM_MODE_OBJECT_CRTC, "VRR_ENABLED", &prop, &current)) {
+        PresenterLog("DrmDisplayPresenter: CRTC %u has no VRR_ENABLED property", enc.crtc_id);
+        vrr_applied_ = vrr_wanted_;  // nothing more to try
+        return false;
+    }
+    drm_mode_obj_set_property set{};
+    set.value = vrr_wanted_ ? 1 : 0;
+    set.prop_id = prop;
+    set.obj_id = enc.crtc_id;
+    set.obj_type = DRM_MODE_OBJECT_CRTC;
+    if (current != set.value && DrmIoctl(drm_fd_, DRM_IOCTL_MODE_OBJ_SETPROPERTY, &set) != 0) {
+        PresenterLog("DrmDisplayPresenter: setting VRR_ENABLED failed (%s)", std::strerror(errno));
+        vrr_applied_ = vrr_wanted_;
+        return false;
+    }
+    vrr_applied_ = vrr_wanted_;
+    PresenterLog("DrmDisplayPresenter: VRR %s on CRTC %u", vrr_wanted_ ? "enabled" : "disabled",
+                 enc.crtc_id);
+    return true;
+}
+
+
+bool DrmDisplayPresenter::PumpEvents()
+{
+    if (!acquired_) return false;
+    if (lease_) {
+        lease_->Dispatch();
+        if (lease_->Finished()) {
+            PresenterLog("DrmDisplayPresenter: lease revoked — stopping");
+            return false;
+        }
+    }
+    return true;
+}
+
+
+int DrmDisplayPresenter::EventFd() const
+{
+    return lease_ ? lease_->EventFd() : -1;
+}
+
+
+bool DrmDisplayPresenter::PrepareEventWait()
+{
+    return lease_ ? lease_->PrepareEventWait() : true;
+}
+
+
+void DrmDisplayPresenter::FinishEventWait(bool readable)
+{
+    if (lease_) lease_->FinishEventWait(readable);
+}
+
+}  // namespace vrto3d
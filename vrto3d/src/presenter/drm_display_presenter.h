@@ -0,0 +1,92 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "presenter/swapchain_presenter_base.h"
+#include "presenter/vk_swapchain_util.h"
+
+namespace vrto3d {
+
+class WaylandDrmLease;
+
+// Compositor-free IVkPresenter: takes a DRM connector for exclusive use and
+// scans out through a VK_KHR_display plane surface, so page flips go straight
+// to KMS with no compositor in the path and the mode is ours to pick.
+//
+// The connector comes from one of two places:
+//   - a wp_drm_lease_device_v1 lease when a Wayland compositor is running
+//     (it must offer the connector — usually only non-desktop outputs);
+//   - otherwise the card node backing ctx->phys, opened directly. This needs
+//     DRM master, i.e. no compositor on the seat (a bare VT, or vkms for
+//     testing).
+// cfg.display_index picks the connector (1-based among leasable/connected
+// connectors; 0 = the first). Frame-packed output modes select the
+// FramePackTimingSpec mode by size + refresh; VK_KHR_display can't program
+// porches, so a sink without that mode in its EDID still needs the
+// EDID-firmware override from the README.
+class DrmDisplayPresenter final : public SwapchainPresenterBase {
+public:
+    DrmDisplayPresenter();
+    ~DrmDisplayPresenter() override;
+
+    bool Init(vrto3d::vk::DeviceCtx* ctx, const StereoDisplayDriverConfiguration& cfg) override;
+    void Shutdown() override;
+
+    // True while the display is still ours (a lease can be revoked).
+    bool PumpEvents() override;
+    int  EventFd() const override;
+    bool PrepareEventWait() override;
+    void FinishEventWait(bool readable) override;
+    bool Present(uint32_t image_index, VkSemaphore wait_sem) override;
+    // AcquireNext/RenderPass/Extent/Format inherited from
+    // SwapchainPresenterBase.
+    const char* Name() const override { return "DrmDisplayPresenter"; }
+
+    bool SetVariableRefresh(bool enable) override;
+
+private:
+    // Opens the primary node of ctx_->phys and returns the connector id for
+    // display_index among its connected connectors (0 on failure).
+    uint32_t OpenCardNode(int32_t display_index);
+    VkDisplayModeKHR PickMode(const StereoDisplayDriverConfiguration& cfg, VkExtent2D* extent);
+    bool CreatePlaneSurface(VkDisplayModeKHR mode, VkExtent2D extent);
+    // Writes VRR_ENABLED on the CRTC currently driving connector_id_. The
+    // WSI only binds a CRTC on its first flip, so this retries from
+    // Present() until one is there.
+    bool ApplyVariableRefresh();
+
+    std::unique_ptr<WaylandDrmLease> lease_;
+    int              card_fd_ = -1;     // direct path only; the lease owns its fd
+    int              drm_fd_ = -1;      // card_fd_ or the lease fd (not owned)
+    uint32_t         connector_id_ = 0;
+    VkDisplayKHR     display_ = VK_NULL_HANDLE;
+    bool             acquired_ = false;
+    VkSurfaceKHR     vk_surface_ = VK_NULL_HANDLE;
+
+    bool             vrr_wanted_ = false;
+    bool             vrr_applied_ = false;
+    int              vrr_attempts_ = 0;
+
+    PFN_vkGetDrmDisplayEXT     get_drm_display_ = nullptr;
+    PFN_vkAcquireDrmDisplayEXT acquire_drm_display_ = nullptr;
+    PFN_vkReleaseDisplayEXT    release_display_ = nullptr;
+};
+
+}  // namespace vrto3d
@@ -0,0 +1,46 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+// Mode math for the frame-packed timings in FramePackTimingSpec, shared by
+// the two Linux paths that program them: XRandR modelines (x11_modeline.cpp)
+// and VK_KHR_display mode selection (drm_display_presenter.cpp). Both must
+// agree on the pixel clock or a mode created by one won't be recognised by
+// the other.
+
+#include <cstdint>
+
+#include "vrto3dlib/stereo_config.h"
+
+namespace vrto3d {
+
+// Pixel clock in Hz. The refresh is rounded to whole Hz first so the
+// modeline is identical to the one CRU writes on Windows.
+inline uint64_t FramePackDotClock(const FramePackTimingSpec& spec)
+{
+    return (uint64_t)spec.h_total * spec.v_total * (uint64_t)(spec.refresh_hz + 0.5f);
+}
+
+// Vertical refresh in millihertz as the kernel derives it from the clock
+// (VkDisplayModeParametersKHR::refreshRate units).
+inline uint32_t FramePackRefreshMilliHz(const FramePackTimingSpec& spec)
+{
+    const uint64_t pixels = (uint64_t)spec.h_total * spec.v_total;
+    return pixels ? (uint32_t)((FramePackDotClock(spec) * 1000 + pixels / 2) / pixels) : 0;
+}
+
+}  // namespace vrto3d
@@ -33,6 +33,7 @@
 
 #include "dx11_renderer.h"
 #include "focus_policy.h"
+#include "process_watch.h"
 #include "hmd_device_driver.h"
 #include "vrto3dlib/debug_log.hpp"
 #include "vrto3dlib/win32_helper.hpp"
@@ -754,7 +755,7 @@ void LeiaSrPresenter::FocusThreadLoop()
         fi.man_on_top   = focus_.man_on_top  && focus_.man_on_top->load();
         fi.app_pid      = focus_.app_pid ? focus_.app_pid->load() : 0;
         fi.auto_focus   = focus_.auto_focus  ? focus_.auto_focus->load() : auto_focus_;
-        fi.app_running  = platform::IsProcessRunning(fi.app_pid);
+        fi.app_running  = vrto3d::ProcessWatch::Instance().IsRunning(fi.app_pid);
         fi.force_on_top = false;  // topmost-model window: an open OSD is made
                                   // visible/clickable via ApplyMenuVisibility,
                                   // not by forcing topmost.
@@ -30,6 +30,7 @@
 
 #include "dx11_renderer.h"
 #include "focus_policy.h"
+#include "process_watch.h"
 #include "hmd_device_driver.h"
 #include "osd/osd_renderer.h"
 #include "platform.h"
@@ -357,7 +358,7 @@ void NvStereoDx9Presenter::FocusThreadLoop()
         // didn't plumb the pointer.
         fi.auto_focus   = focus_.auto_focus ? focus_.auto_focus->load()
                                             : auto_focus_cache_;
-        fi.app_running  = platform::IsProcessRunning(fi.app_pid);
+        fi.app_running  = vrto3d::ProcessWatch::Instance().IsRunning(fi.app_pid);
         // An open OSD must be visible to use — force the popup up while the
         // menu is open (mirrors the Linux VkRenderer focus block). Without
         // this, opening the menu while the popup is hidden softlocks: the
@@ -0,0 +1,881 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "presenter/pipewire_presenter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include <dlfcn.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <pipewire/pipewire.h>
+#include <spa/buffer/meta.h>
+#include <spa/param/video/format-utils.h>
+#include <spa/pod/builder.h>
+
+#include "driver_settings.h"
+#include "platform.h"
+#include "presenter/vk_swapchain_util.h"  // PresenterLog
+
+namespace vrto3d {
+
+// The libpipewire entry points used here, resolved from the dlopen'd
+// library. The spa_pod builders and parsers are header-only.
+struct PipeWirePresenter::Api {
+    decltype(&pw_init)                   init = nullptr;
+    decltype(&pw_thread_loop_new)        thread_loop_new = nullptr;
+    decltype(&pw_thread_loop_get_loop)   thread_loop_get_loop = nullptr;
+    decltype(&pw_thread_loop_start)      thread_loop_start = nullptr;
+    decltype(&pw_thread_loop_stop)       thread_loop_stop = nullptr;
+    decltype(&pw_thread_loop_destroy)    thread_loop_destroy = nullptr;
+    decltype(&pw_thread_loop_lock)       thread_loop_lock = nullptr;
+    decltype(&pw_thread_loop_unlock)     thread_loop_unlock = nullptr;
+    decltype(&pw_context_new)            context_new = nullptr;
+    decltype(&pw_context_connect)        context_connect = nullptr;
+    decltype(&pw_context_destroy)        context_destroy = nullptr;
+    decltype(&pw_core_disconnect)        core_disconnect = nullptr;
+    decltype(&pw_properties_new)         properties_new = nullptr;
+    decltype(&pw_stream_new)             stream_new = nullptr;
+    decltype(&pw_stream_add_listener)    stream_add_listener = nullptr;
+    decltype(&pw_stream_connect)         stream_connect = nullptr;
+    decltype(&pw_stream_disconnect)      stream_disconnect = nullptr;
+    decltype(&pw_stream_destroy)         stream_destroy = nullptr;
+    decltype(&pw_stream_update_params)   stream_update_params = nullptr;
+    decltype(&pw_stream_dequeue_buffer)  stream_dequeue_buffer = nullptr;
+    decltype(&pw_stream_queue_buffer)    stream_queue_buffer = nullptr;
+    decltype(&pw_stream_get_node_id)     stream_get_node_id = nullptr;
+    decltype(&pw_stream_state_as_string) stream_state_as_string = nullptr;
+};
+
+namespace {
+
+constexpr int kRingDefault = 4;
+constexpr int kRingMax = 8;
+
+// ---------------------------------------------------------------------------
+// C stream-event trampolines.
+// ---------------------------------------------------------------------------
+
+void StreamStateChanged(void* data, pw_stream_state old_state, pw_stream_state state,
+                        const char* error)
+{
+    static_cast<PipeWirePresenter*>(data)->OnStateChanged(old_state, state, error);
+}
+
+void StreamParamChanged(void* data, uint32_t id, const spa_pod* param)
+{
+    static_cast<PipeWirePresenter*>(data)->OnParamChanged(id, param);
+}
+
+void StreamAddBuffer(void* data, pw_buffer* buffer)
+{
+    static_cast<PipeWirePresenter*>(data)->OnAddBuffer(buffer);
+}
+
+void StreamRemoveBuffer(void* data, pw_buffer* buffer)
+{
+    static_cast<PipeWirePresenter*>(data)->OnRemoveBuffer(buffer);
+}
+
+const pw_stream_events& StreamEvents()
+{
+    static const pw_stream_events events = [] {
+        pw_stream_events e{};
+        e.version = PW_VERSION_STREAM_EVENTS;
+        e.state_changed = StreamStateChanged;
+        e.param_changed = StreamParamChanged;
+        e.add_buffer = StreamAddBuffer;
+        e.remove_buffer = StreamRemoveBuffer;
+        return e;
+    }();
+    return events;
+}
+
+// Frame size for the output mode, from the per-eye render size: what a
+// display of that layout would show, at the game's full resolution.
+VkExtent2D StreamExtent(const StereoDisplayDriverConfiguration& cfg)
+{
+    uint32_t w = (uint32_t)cfg.render_width;
+    uint32_t h = (uint32_t)cfg.render_height;
+    if (w == 0 || h == 0) {
+        w = 1920;
+        h = 1080;
+    }
+    switch (cfg.output_mode) {
+        case OutputMode::SbS:
+        case OutputMode::DualDisplay:
+        case OutputMode::DualDisplayFlip:
+        case OutputMode::LeiaSR:
+        case OutputMode::NvidiaDX9:
+        case OutputMode::WibbleWobble:
+            return {w * 2, h};
+        case OutputMode::TaB:
+        case OutputMode::FramePacked720p60:
+        case OutputMode::FramePacked1080p24:
+        case OutputMode::FramePacked1080p60:
+        case OutputMode::FramePacked1080p60CVT:
+            return {w, h * 2};
+        case OutputMode::VirtualDesktop:
+            return {w * 2, h * 2};
+        default:
+            // Interlaced, checkerboard, anaglyph and mono share one eye's frame.
+            return {w, h};
+    }
+}
+
+}  // namespace
+
+
+PipeWirePresenter::PipeWirePresenter() = default;
+
+
+PipeWirePresenter::~PipeWirePresenter()
+{
+    Shutdown();
+}
+
+
+bool PipeWirePresenter::LoadPipeWire()
+{
+    lib_ = dlopen("libpipewire-0.3.so.0", RTLD_NOW | RTLD_LOCAL);
+    if (!lib_) {
+        PresenterLog("PipeWirePresenter: libpipewire-0.3.so.0 not found — %s", dlerror());
+        return false;
+    }
+    api_ = std::make_unique<Api>();
+    bool ok = true;
+    auto load = [&](auto& fn, const char* name) {
+        fn = reinterpret_cast<std::remove_reference_t<decltype(fn)>>(dlsym(lib_, name));
+        ok = ok && fn != nullptr;
+    };
+    load(api_->init, "pw_init");
+    load(api_->thread_loop_new, "pw_thread_loop_new");
+    load(api_->thread_loop_get_loop, "pw_thread_loop_get_loop");
+    load(api_->thread_loop_start, "pw_thread_loop_start");
+    load(api_->thread_loop_stop, "pw_thread_loop_stop");
+    load(api_->thread_loop_destroy, "pw_thread_loop_destroy");
+    load(api_->thread_loop_lock, "pw_thread_loop_lock");
+    load(api_->thread_loop_unlock, "pw_thread_loop_unlock");
+    load(api_->context_new, "pw_context_new");
+    load(api_->context_connect, "pw_context_connect");
+    load(api_->context_destroy, "pw_context_destroy");
+    load(api_->core_disconnect, "pw_core_disconnect");
+    load(api_->properties_new, "pw_properties_new");
+    load(api_->stream_new, "pw_stream_new");
+    load(api_->stream_add_listener, "pw_stream_add_listener");
+    load(api_->stream_connect, "pw_stream_connect");
+    load(api_->stream_disconnect, "pw_stream_disconnect");
+    load(api_->stream_destroy, "pw_stream_destroy");
+    load(api_->stream_update_params, "pw_stream_update_params");
+    load(api_->stream_dequeue_buffer, "pw_stream_dequeue_buffer");
+    load(api_->stream_queue_buffer, "pw_stream_queue_buffer");
+    load(api_->stream_get_node_id, "pw_stream_get_node_id");
+    load(api_->stream_state_as_string, "pw_stream_state_as_string");
+    if (!ok) {
+        PresenterLog("PipeWirePresenter: libpipewire missing expected symbols");
+        return false;
+    }
+    return true;
+}
+
+
+bool PipeWirePresenter::Init(vrto3d::vk::DeviceCtx* ctx,
+                             const StereoDisplayDriverConfiguration& cfg)
+{
+    ctx_ = ctx;
+    extent_ = StreamExtent(cfg);
+    const std::string size = DriverSettingString("pipewire_size");
+    unsigned w = 0, h = 0;
+    if (!size.empty()) {
+        if (std::sscanf(size.c_str(), "%ux%u", &w, &h) == 2 && w > 0 && h > 0)
+            extent_ = {w, h};
+        else
+            PresenterLog("PipeWirePresenter: ignoring pipewire_size '%s' (want WxH)",
+                         size.c_str());
+    }
+    max_fps_ = cfg.display_frequency > 1.0f ? (uint32_t)(cfg.display_frequency + 0.5f) : 60u;
+
+    if (!LoadPipeWire())
+        return false;
+
+    get_memory_fd_ = (PFN_vkGetMemoryFdKHR)vkGetDeviceProcAddr(ctx_->device, "vkGetMemoryFdKHR");
+    get_image_modifier_ = (PFN_vkGetImageDrmFormatModifierPropertiesEXT)vkGetDeviceProcAddr(
+        ctx_->device, "vkGetImageDrmFormatModifierPropertiesEXT");
+    if (get_memory_fd_ && get_image_modifier_ &&
+        DriverSettingBool("pipewire_dmabuf", true)) {
+        renderable_ = vrto3d::vk::RenderableDrmModifiers(*ctx_, format_, extent_.width,
+                                                         extent_.height);
+        renderable_.erase(std::remove_if(renderable_.begin(), renderable_.end(),
+                                         [](const vrto3d::vk::DrmModifier& m) {
+                                             return m.planes > 4;
+                                         }),
+                          renderable_.end());
+    }
+
+    if (!CreateRenderPass())
+        return false;
+    VkCommandPoolCreateInfo cpci{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+    cpci.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    cpci.queueFamilyIndex = ctx_->queue_family;
+    vkCreateCommandPool(ctx_->device, &cpci, nullptr, &cmd_pool_);
+
+    api_->init(nullptr, nullptr);
+    loop_ = api_->thread_loop_new("vrto3d-pipewire", nullptr);
+    if (!loop_)
+        return false;
+    context_ = api_->context_new(api_->thread_loop_get_loop(loop_), nullptr, 0);
+    if (!context_ || api_->thread_loop_start(loop_) < 0) {
+        PresenterLog("PipeWirePresenter: couldn't start the PipeWire loop");
+        return false;
+    }
+
+    api_->thread_loop_lock(loop_);
+    core_ = api_->context_connect(context_, nullptr, 0);
+    if (!core_) {
+        api_->thread_loop_unlock(loop_);
+        PresenterLog("PipeWirePresenter: no PipeWire daemon to connect to");
+        return false;
+    }
+    pw_properties* props = api_->properties_new(
+        PW_KEY_MEDIA_CLASS, "Video/Source",
+        PW_KEY_NODE_NAME, "vrto3d",
+        PW_KEY_NODE_DESCRIPTION, "VRto3D stereo output",
+        nullptr);
+    stream_ = api_->stream_new(core_, "vrto3d", props);
+    if (!stream_) {
+        api_->thread_loop_unlock(loop_);
+        PresenterLog("PipeWirePresenter: pw_stream_new failed");
+        return false;
+    }
+    stream_listener_ = std::make_unique<spa_hook>();
+    api_->stream_add_listener(stream_, stream_listener_.get(), &StreamEvents(), this);
+
+    std::vector<uint64_t> modifiers;
+    for (const vrto3d::vk::DrmModifier& m : renderable_)
+        modifiers.push_back(m.modifier);
+    uint8_t buf[4096];
+    spa_pod_builder b = SPA_POD_BUILDER_INIT(buf, sizeof(buf));
+    const spa_pod* params[2];
+    const uint32_t n = BuildFormats(&b, params, modifiers);
+    const int res = api_->stream_connect(
+        stream_, PW_DIRECTION_OUTPUT, PW_ID_ANY,
+        static_cast<pw_stream_flags>(PW_STREAM_FLAG_DRIVER | PW_STREAM_FLAG_ALLOC_BUFFERS),
+        params, n);
+    api_->thread_loop_unlock(loop_);
+    if (res < 0) {
+        PresenterLog("PipeWirePresenter: pw_stream_connect failed (%d)", res);
+        return false;
+    }
+
+    PresenterLog("PipeWirePresenter: offering %ux%u BGRx up to %u fps, %zu dmabuf modifier(s)",
+                 extent_.width, extent_.height, max_fps_, modifiers.size());
+    return true;
+}
+
+
+bool PipeWirePresenter::CreateRenderPass()
+{
+    // Like the swapchain pass (the repack writes every pixel), but ends in
+    // COLOR_ATTACHMENT_OPTIMAL: Present() moves the image on to the consumer
+    // (dmabuf) or the readback copy (MemFd).
+    VkAttachmentDescription att{};
+    att.format         = format_;
+    att.samples        = VK_SAMPLE_COUNT_1_BIT;
+    att.loadOp         = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    att.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
+    att.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    att.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    att.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
+    att.finalLayout    = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    VkAttachmentReference ref{0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+    VkSubpassDescription sub{};
+    sub.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    sub.colorAttachmentCount = 1;
+    sub.pColorAttachments = &ref;
+    VkSubpassDependency dep{};
+    dep.srcSubpass    = VK_SUBPASS_EXTERNAL;
+    dep.dstSubpass    = 0;
+    dep.srcStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dep.dstStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dep.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    VkRenderPassCreateInfo rp{VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO};
+    rp.attachmentCount = 1;
+    rp.pAttachments = &att;
+    rp.subpassCount = 1;
+    rp.pSubpasses = &sub;
+    rp.dependencyCount = 1;
+    rp.pDependencies = &dep;
+    if (vkCreateRenderPass(ctx_->device, &rp, nullptr, &render_pass_) != VK_SUCCESS) {
+        PresenterLog("PipeWirePresenter: render pass creation failed");
+        return false;
+    }
+    return true;
+}
+
+
+uint32_t PipeWirePresenter::BuildFormats(spa_pod_builder* b, const spa_pod** params,
+                                         const std::vector<uint64_t>& modifiers)
+{
+    // The dmabuf offer comes first so consumers that can import one prefer
+    // it; the same format without a modifier is the MemFd fallback.
+    spa_rectangle size = SPA_RECTANGLE(extent_.width, extent_.height);
+    spa_fraction variable = SPA_FRACTION(0, 1);
+    spa_fraction min_rate = SPA_FRACTION(1, 1);
+    spa_fraction max_rate = SPA_FRACTION(max_fps_, 1);
+    auto build = [&](bool with_modifiers) {
+        spa_pod_frame f[2];
+        spa_pod_builder_push_object(b, &f[0], SPA_TYPE_OBJECT_Format, SPA_PARAM_EnumFormat);
+        spa_pod_builder_add(b, SPA_FORMAT_mediaType, SPA_POD_Id(SPA_MEDIA_TYPE_video), 0);
+        spa_pod_builder_add(b, SPA_FORMAT_mediaSubtype, SPA_POD_Id(SPA_MEDIA_SUBTYPE_raw), 0);
+        spa_pod_builder_add(b, SPA_FORMAT_VIDEO_format, SPA_POD_Id(SPA_VIDEO_FORMAT_BGRx), 0);
+        if (with_modifiers) {
+            if (modifiers.size() == 1) {
+                spa_pod_builder_prop(b, SPA_FORMAT_VIDEO_modifier, SPA_POD_PROP_FLAG_MANDATORY);
+                spa_pod_builder_long(b, (int64_t)modifiers[0]);
+            } else {
+                // Left open for the consumer; OnParamChanged fixes the pick.
+                spa_pod_builder_prop(b, SPA_FORMAT_VIDEO_modifier,
+                                     SPA_POD_PROP_FLAG_MANDATORY | SPA_POD_PROP_FLAG_DONT_FIXATE);
+                spa_pod_builder_push_choice(b, &f[1], SPA_CHOICE_Enum, 0);
+                spa_pod_builder_long(b, (int64_t)modifiers[0]);
+                for (uint64_t m : modifiers)
+                    spa_pod_builder_long(b, (int64_t)m);
+                spa_pod_builder_pop(b, &f[1]);
+            }
+        }
+        spa_pod_builder_add(b, SPA_FORMAT_VIDEO_size, SPA_POD_Rectangle(&size), 0);
+        spa_pod_builder_add(b, SPA_FORMAT_VIDEO_framerate, SPA_POD_Fraction(&variable), 0);
+        spa_pod_builder_add(b, SPA_FORMAT_VIDEO_maxFramerate,
+                            SPA_POD_CHOICE_RANGE_Fraction(&max_rate, &min_rate, &max_rate), 0);
+        return static_cast<const spa_pod*>(spa_pod_builder_pop(b, &f[0]));
+    };
+    uint32_t n = 0;
+    if (!modifiers.empty())
+        params[n++] = build(true);
+    params[n++] = build(false);
+    return n;
+}
+
+
+void PipeWirePresenter::OnStateChanged(int old_state, int state, const char* error)
+{
+    streaming_ = state == PW_STREAM_STATE_STREAMING;
+    if (old_state == PW_STREAM_STATE_CONNECTING && state == PW_STREAM_STATE_PAUSED) {
+        PresenterLog("PipeWirePresenter: published as node %u",
+                     api_->stream_get_node_id(stream_));
+    }
+    PresenterLog("PipeWirePresenter: stream %s -> %s%s%s",
+                 api_->stream_state_as_string(static_cast<pw_stream_state>(old_state)),
+                 api_->stream_state_as_string(static_cast<pw_stream_state>(state)),
+                 error ? ": " : "", error ? error : "");
+}
+
+
+void PipeWirePresenter::OnParamChanged(uint32_t id, const spa_pod* param)
+{
+    if (id != SPA_PARAM_Format || !param)
+        return;
+    spa_video_info_raw info{};
+    if (spa_format_video_raw_parse(param, &info) < 0)
+        return;
+
+    uint8_t buf[4096];
+    spa_pod_builder b = SPA_POD_BUILDER_INIT(buf, sizeof(buf));
+    const spa_pod_prop* mod_prop = spa_pod_find_prop(param, nullptr, SPA_FORMAT_VIDEO_modifier);
+    if (mod_prop && (mod_prop->flags & SPA_POD_PROP_FLAG_DONT_FIXATE)) {
+        // The consumer kept a choice of modifiers: fix it to the first of
+        // ours it accepts and offer again. PipeWire calls back with the
+        // fixed format.
+        uint32_t n_vals = 0, choice = 0;
+        const spa_pod* vals = spa_pod_get_values(&mod_prop->value, &n_vals, &choice);
+        const uint64_t* offered = static_cast<const uint64_t*>(SPA_POD_BODY_CONST(vals));
+        std::vector<uint64_t> pick;
+        for (const vrto3d::vk::DrmModifier& m : renderable_) {
+            if (std::find(offered, offered + n_vals, m.modifier) != offered + n_vals) {
+                pick.push_back(m.modifier);
+                break;
+            }
+        }
+        const spa_pod* params[2];
+        const uint32_t n = BuildFormats(&b, params, pick);
+        api_->stream_update_params(stream_, params, n);
+        return;
+    }
+
+    use_dmabuf_ = mod_prop != nullptr;
+    if (use_dmabuf_) {
+        modifier_ = info.modifier;
+        planes_ = 1;
+        for (const vrto3d::vk::DrmModifier& m : renderable_) {
+            if (m.modifier == modifier_) planes_ = m.planes;
+        }
+    }
+    stride_ = extent_.width * 4;
+
+    const spa_pod* params[2];
+    if (use_dmabuf_) {
+        params[0] = static_cast<const spa_pod*>(spa_pod_builder_add_object(&b,
+            SPA_TYPE_OBJECT_ParamBuffers, SPA_PARAM_Buffers,
+            SPA_PARAM_BUFFERS_buffers, SPA_POD_CHOICE_RANGE_Int(kRingDefault, 2, kRingMax),
+            SPA_PARAM_BUFFERS_blocks, SPA_POD_Int((int)planes_),
+            SPA_PARAM_BUFFERS_dataType, SPA_POD_CHOICE_FLAGS_Int(1 << SPA_DATA_DmaBuf)));
+    } else {
+        params[0] = static_cast<const spa_pod*>(spa_pod_builder_add_object(&b,
+            SPA_TYPE_OBJECT_ParamBuffers, SPA_PARAM_Buffers,
+            SPA_PARAM_BUFFERS_buffers, SPA_POD_CHOICE_RANGE_Int(kRingDefault, 2, kRingMax),
+            SPA_PARAM_BUFFERS_blocks, SPA_POD_Int(1),
+            SPA_PARAM_BUFFERS_size, SPA_POD_Int((int)(stride_ * extent_.height)),
+            SPA_PARAM_BUFFERS_stride, SPA_POD_Int((int)stride_),
+            SPA_PARAM_BUFFERS_dataType, SPA_POD_CHOICE_FLAGS_Int(1 << SPA_DATA_MemFd)));
+    }
+    params[1] = static_cast<const spa_pod*>(spa_pod_builder_add_object(&b,
+        SPA_TYPE_OBJECT_ParamMeta, SPA_PARAM_Meta,
+        SPA_PARAM_META_type, SPA_POD_Id(SPA_META_Header),
+        SPA_PARAM_META_size, SPA_POD_Int((int)sizeof(spa_meta_header))));
+    api_->stream_update_params(stream_, params, 2);
+
+    if (use_dmabuf_)
+        PresenterLog("PipeWirePresenter: consumer took dmabuf, modifier 0x%016llx",
+                     static_cast<unsigned long long>(modifier_));
+    else
+        PresenterLog("PipeWirePresenter: consumer took MemFd — frames are read back");
+}
+
+
+void PipeWirePresenter::OnAddBuffer(pw_buffer* buffer)
+{
+    int idx = -1;
+    {
+        std::lock_guard<std::mutex> lock(slots_mutex_);
+        for (int i = 0; i < kMaxSlots; ++i) {
+            if (!slots_[i].used) { idx = i; break; }
+        }
+        if (idx >= 0)
+            slots_[idx].used = true;
+    }
+    if (idx < 0) {
+        PresenterLog("PipeWirePresenter: out of buffer slots");
+        return;
+    }
+    Slot& slot = slots_[idx];
+    bool ok = use_dmabuf_ ? AllocateDmabuf(slot, buffer) : AllocateMemFd(slot, buffer);
+    if (ok) {
+        VkFramebufferCreateInfo fbi{VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO};
+        fbi.renderPass = render_pass_;
+        fbi.attachmentCount = 1;
+        fbi.pAttachments = &slot.view;
+        fbi.width = extent_.width;
+        fbi.height = extent_.height;
+        fbi.layers = 1;
+        ok = vkCreateFramebuffer(ctx_->device, &fbi, nullptr, &slot.framebuffer) == VK_SUCCESS;
+    }
+    if (!ok) {
+        PresenterLog("PipeWirePresenter: buffer allocation failed");
+        DestroySlot(slot);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    slot.buffer = buffer;
+    buffer->user_data = &slot;
+}
+
+
+void PipeWirePresenter::OnRemoveBuffer(pw_buffer* buffer)
+{
+    // The renderer may be drawing into it right now; the present thread
+    // frees it once it is no longer acquired.
+    Slot* slot = static_cast<Slot*>(buffer->user_data);
+    if (!slot)
+        return;
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    slot->buffer = nullptr;
+    buffer->user_data = nullptr;
+    retired_.push_back(static_cast<int>(slot - slots_));
+}
+
+
+bool PipeWirePresenter::AllocateDmabuf(Slot& slot, pw_buffer* buffer)
+{
+    spa_buffer* sb = buffer->buffer;
+    if (sb->n_datas < planes_ || !(sb->datas[0].type & (1u << SPA_DATA_DmaBuf)))
+        return false;
+
+    VkImageDrmFormatModifierListCreateInfoEXT mod_list{
+        VK_STRUCTURE_TYPE_IMAGE_DRM_FORMAT_MODIFIER_LIST_CREATE_INFO_EXT};
+    mod_list.drmFormatModifierCount = 1;
+    mod_list.pDrmFormatModifiers = &modifier_;
+    VkExternalMemoryImageCreateInfo ext{VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_IMAGE_CREATE_INFO};
+    ext.pNext = &mod_list;
+    ext.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT;
+    VkImageCreateInfo ici{VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+    ici.pNext = &ext;
+    ici.imageType = VK_IMAGE_TYPE_2D;
+    ici.format = format_;
+    ici.extent = {extent_.width, extent_.height, 1};
+    ici.mipLevels = 1;
+    ici.arrayLayers = 1;
+    ici.samples = VK_SAMPLE_COUNT_1_BIT;
+    ici.tiling = VK_IMAGE_TILING_DRM_FORMAT_MODIFIER_EXT;
+    ici.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    ici.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    ici.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    if (vrto3d::vk::LogIfFailed(vkCreateImage(ctx_->device, &ici, nullptr, &slot.image),
+                                "pipewire vkCreateImage") != VK_SUCCESS)
+        return false;
+
+    VkExportMemoryAllocateInfo export_info{VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO};
+    export_info.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT;
+    VkMemoryDedicatedAllocateInfo dedicated{VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO};
+    dedicated.pNext = &export_info;
+    dedicated.image = slot.image;
+    if (!vrto3d::vk::AllocateBindImageView(*ctx_, slot.image, format_,
+                                           VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &dedicated, 0,
+                                           /*make_view=*/true, &slot.memory, &slot.view))
+        return false;
+
+    VkMemoryGetFdInfoKHR gfi{VK_STRUCTURE_TYPE_MEMORY_GET_FD_INFO_KHR};
+    gfi.memory = slot.memory;
+    gfi.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT;
+    if (get_memory_fd_(ctx_->device, &gfi, &slot.fd) != VK_SUCCESS || slot.fd < 0)
+        return false;
+
+    VkMemoryRequirements reqs{};
+    vkGetImageMemoryRequirements(ctx_->device, slot.image, &reqs);
+    // Every plane lives in the one dedicated allocation.
+    for (uint32_t p = 0; p < planes_; ++p) {
+        VkImageSubresource sr{};
+        sr.aspectMask = static_cast<VkImageAspectFlags>(VK_IMAGE_ASPECT_MEMORY_PLANE_0_BIT_EXT << p);
+        VkSubresourceLayout layout{};
+        vkGetImageSubresourceLayout(ctx_->device, slot.image, &sr, &layout);
+        spa_data& d = sb->datas[p];
+        d.type = SPA_DATA_DmaBuf;
+        d.flags = SPA_DATA_FLAG_READABLE;
+        d.fd = slot.fd;
+        d.mapoffset = 0;
+        d.maxsize = (uint32_t)reqs.size;
+        d.data = nullptr;
+        d.chunk->offset = (uint32_t)layout.offset;
+        d.chunk->stride = (int32_t)layout.rowPitch;
+        d.chunk->size = (uint32_t)layout.size;
+    }
+    slot.dmabuf = true;
+    return true;
+}
+
+
+bool PipeWirePresenter::AllocateMemFd(Slot& slot, pw_buffer* buffer)
+{
+    spa_buffer* sb = buffer->buffer;
+    if (sb->n_datas < 1 || !(sb->datas[0].type & (1u << SPA_DATA_MemFd)))
+        return false;
+
+    vrto3d::vk::Image2D img;
+    if (!vrto3d::vk::CreateImage2D(*ctx_, extent_.width, extent_.height, format_,
+            VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+            VK_IMAGE_TILING_OPTIMAL, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            /*make_view=*/true, &img))
+        return false;
+    slot.image = img.image;
+    slot.memory = img.memory;
+    slot.view = img.view;
+
+    const VkDeviceSize size = (VkDeviceSize)stride_ * extent_.height;
+    VkBufferCreateInfo bci{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    bci.size = size;
+    bci.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateBuffer(ctx_->device, &bci, nullptr, &slot.staging) != VK_SUCCESS)
+        return false;
+    VkMemoryRequirements reqs{};
+    vkGetBufferMemoryRequirements(ctx_->device, slot.staging, &reqs);
+    VkMemoryAllocateInfo mai{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+    mai.allocationSize = reqs.size;
+    mai.memoryTypeIndex = ctx_->FindMemoryType(reqs.memoryTypeBits,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT |
+        VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+    if (mai.memoryTypeIndex == UINT32_MAX)
+        mai.memoryTypeIndex = ctx_->FindMemoryType(reqs.memoryTypeBits,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (mai.memoryTypeIndex == UINT32_MAX ||
+        vkAllocateMemory(ctx_->device, &mai, nullptr, &slot.staging_mem) != VK_SUCCESS)
+        return false;
+    vkBindBufferMemory(ctx_->device, slot.staging, slot.staging_mem, 0);
+    if (vkMapMemory(ctx_->device, slot.staging_mem, 0, VK_WHOLE_SIZE, 0, &slot.staging_ptr) !=
+        VK_SUCCESS)
+        return false;
+
+    slot.fd = memfd_create("vrto3d-pipewire", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (slot.fd < 0 || ftruncate(slot.fd, (off_t)size) < 0)
+        return false;
+    void* map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, slot.fd, 0);
+    if (map == MAP_FAILED)
+        return false;
+    slot.map = map;
+    slot.map_size = size;
+
+    spa_data& d = sb->datas[0];
+    d.type = SPA_DATA_MemFd;
+    d.flags = SPA_DATA_FLAG_READABLE | SPA_DATA_FLAG_MAPPABLE;
+    d.fd = slot.fd;
+    d.mapoffset = 0;
+    d.maxsize = (uint32_t)size;
+    d.data = slot.map;
+    d.chunk->offset = 0;
+    d.chunk->stride = (int32_t)stride_;
+    d.chunk->size = (uint32_t)size;
+    slot.dmabuf = false;
+    return true;
+}
+
+
+void PipeWirePresenter::DestroySlot(Slot& slot)
+{
+    if (slot.fence) vkDestroyFence(ctx_->device, slot.fence, nullptr);
+    if (slot.cmd) vkFreeCommandBuffers(ctx_->device, cmd_pool_, 1, &slot.cmd);
+    if (slot.framebuffer) vkDestroyFramebuffer(ctx_->device, slot.framebuffer, nullptr);
+    if (slot.view) vkDestroyImageView(ctx_->device, slot.view, nullptr);
+    if (slot.image) vkDestroyImage(ctx_->device, slot.image, nullptr);
+    if (slot.memory) vkFreeMemory(ctx_->device, slot.memory, nullptr);
+    if (slot.staging) vkDestroyBuffer(ctx_->device, slot.staging, nullptr);
+    if (slot.staging_mem) vkFreeMemory(ctx_->device, slot.staging_mem, nullptr);
+    if (slot.map) munmap(slot.map, slot.map_size);
+    if (slot.fd >= 0) close(slot.fd);
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    slot = Slot{};
+}
+
+
+void PipeWirePresenter::DestroyRetired()
+{
+    std::vector<int> ready;
+    {
+        std::lock_guard<std::mutex> lock(slots_mutex_);
+        auto keep = std::remove_if(retired_.begin(), retired_.end(), [&](int idx) {
+            if (slots_[idx].acquired)
+                return false;
+            ready.push_back(idx);
+            return true;
+        });
+        retired_.erase(keep, retired_.end());
+    }
+    for (int idx : ready)
+        DestroySlot(slots_[idx]);
+}
+
+
+bool PipeWirePresenter::PumpEvents()
+{
+    // PipeWire runs its own loop; this only frees buffers it dropped. A
+    // missing or departed consumer isn't a reason to stop presenting.
+    DestroyRetired();
+    return true;
+}
+
+
+bool PipeWirePresenter::AcquireNext(FrameTarget* out, VkSemaphore signal_sem)
+{
+    DestroyRetired();
+    if (!stream_)
+        return false;
+
+    Slot* slot = nullptr;
+    api_->thread_loop_lock(loop_);
+    pw_buffer* buffer = streaming_ ? api_->stream_dequeue_buffer(stream_) : nullptr;
+    if (buffer) {
+        slot = static_cast<Slot*>(buffer->user_data);
+        if (slot) {
+            std::lock_guard<std::mutex> lock(slots_mutex_);
+            slot->acquired = true;
+        } else {
+            // Allocation failed for this one; hand it straight back empty.
+            buffer->buffer->datas[0].chunk->size = 0;
+            buffer->buffer->datas[0].chunk->flags = SPA_CHUNK_FLAG_CORRUPTED;
+            api_->stream_queue_buffer(stream_, buffer);
+        }
+    }
+    api_->thread_loop_unlock(loop_);
+    if (!slot)
+        return false;  // no consumer, or it holds every buffer: drop the frame
+
+    if (!slot->cmd) {
+        VkCommandBufferAllocateInfo cbai{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+        cbai.commandPool = cmd_pool_;
+        cbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        cbai.commandBufferCount = 1;
+        vkAllocateCommandBuffers(ctx_->device, &cbai, &slot->cmd);
+        VkFenceCreateInfo fci{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+        fci.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+        vkCreateFence(ctx_->device, &fci, nullptr, &slot->fence);
+    }
+    // The image is idle (Present waits before queueing), but the renderer's
+    // submit waits on the binary semaphore, so it still needs a queue signal.
+    VkSubmitInfo sig{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+    sig.signalSemaphoreCount = 1;
+    sig.pSignalSemaphores = &signal_sem;
+    {
+        std::lock_guard<std::mutex> lock(ctx_->queue_mutex);
+        vkQueueSubmit(ctx_->queue, 1, &sig, VK_NULL_HANDLE);
+    }
+
+    out->image = slot->image;
+    out->view = slot->view;
+    out->framebuffer = slot->framebuffer;
+    out->index = static_cast<uint32_t>(slot - slots_);
+    return true;
+}
+
+
+bool PipeWirePresenter::Present(uint32_t image_index, VkSemaphore wait_sem)
+{
+    if (image_index >= (uint32_t)kMaxSlots)
+        return false;
+    Slot& slot = slots_[image_index];
+
+    vkResetFences(ctx_->device, 1, &slot.fence);
+    vkResetCommandBuffer(slot.cmd, 0);
+    VkCommandBufferBeginInfo begin{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(slot.cmd, &begin);
+    VkImageMemoryBarrier barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+    barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    barrier.image = slot.image;
+    barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    VkPipelineStageFlags wait_stage;
+    if (slot.dmabuf) {
+        // Hand the image to the consumer's GPU in GENERAL.
+        barrier.dstAccessMask = 0;
+        barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        barrier.srcQueueFamilyIndex = ctx_->queue_family;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_EXTERNAL;
+        vkCmdPipelineBarrier(slot.cmd, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                             VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr,
+                             1, &barrier);
+        wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    } else {
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        vkCmdPipelineBarrier(slot.cmd, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr,
+                             1, &barrier);
+        VkBufferImageCopy region{};
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        region.imageExtent = {extent_.width, extent_.height, 1};
+        vkCmdCopyImageToBuffer(slot.cmd, slot.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                               slot.staging, 1, &region);
+        VkBufferMemoryBarrier to_host{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+        to_host.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        to_host.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        to_host.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        to_host.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        to_host.buffer = slot.staging;
+        to_host.size = VK_WHOLE_SIZE;
+        vkCmdPipelineBarrier(slot.cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &to_host, 0, nullptr);
+        wait_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    }
+    vkEndCommandBuffer(slot.cmd);
+
+    VkSubmitInfo submit{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+    submit.waitSemaphoreCount = 1;
+    submit.pWaitSemaphores = &wait_sem;
+    submit.pWaitDstStageMask = &wait_stage;
+    submit.commandBufferCount = 1;
+    submit.pCommandBuffers = &slot.cmd;
+    {
+        std::lock_guard<std::mutex> lock(ctx_->queue_mutex);
+        if (vrto3d::vk::LogIfFailed(vkQueueSubmit(ctx_->queue, 1, &submit, slot.fence),
+                                    "pipewire vkQueueSubmit") != VK_SUCCESS) {
+            std::lock_guard<std::mutex> slots_lock(slots_mutex_);
+            slot.acquired = false;
+            return false;
+        }
+    }
+    // Consumers may sit on another GPU or map the buffer on the CPU, where
+    // implicit dmabuf sync can't be relied on: the frame is complete before
+    // it is queued.
+    vkWaitForFences(ctx_->device, 1, &slot.fence, VK_TRUE, UINT64_MAX);
+    if (!slot.dmabuf)
+        std::memcpy(slot.map, slot.staging_ptr, slot.map_size);
+
+    api_->thread_loop_lock(loop_);
+    if (slot.buffer) {
+        spa_buffer* sb = slot.buffer->buffer;
+        auto* header = static_cast<spa_meta_header*>(
+            spa_buffer_find_meta_data(sb, SPA_META_Header, sizeof(spa_meta_header)));
+        if (header) {
+            header->flags = 0;
+            header->offset = 0;
+            header->pts = (int64_t)(platform::MonotonicSeconds() * 1e9);
+            header->dts_offset = 0;
+            header->seq = seq_++;
+        }
+        sb->datas[0].chunk->flags = SPA_CHUNK_FLAG_NONE;
+        api_->stream_queue_buffer(stream_, slot.buffer);
+    }
+    {
+        std::lock_guard<std::mutex> lock(slots_mutex_);
+        slot.acquired = false;
+    }
+    api_->thread_loop_unlock(loop_);
+    return true;
+}
+
+
+void PipeWirePresenter::Shutdown()
+{
+    if (loop_) {
+        api_->thread_loop_lock(loop_);
+        if (stream_) {
+            api_->stream_disconnect(stream_);
+            spa_hook_remove(stream_listener_.get());
+            api_->stream_destroy(stream_);
+            stream_ = nullptr;
+        }
+        api_->thread_loop_unlock(loop_);
+        api_->thread_loop_stop(loop_);
+        if (core_) { api_->core_disconnect(core_); core_ = nullptr; }
+        if (context_) { api_->context_destroy(context_); context_ = nullptr; }
+        api_->thread_loop_destroy(loop_);
+        loop_ = nullptr;
+    }
+    if (ctx_ && ctx_->device != VK_NULL_HANDLE) {
+        {
+            std::lock_guard<std::mutex> lock(ctx_->queue_mutex);
+            vkQueueWaitIdle(ctx_->queue);
+        }
+        for (Slot& slot : slots_) {
+            if (slot.used)
+                DestroySlot(slot);
+        }
+        retired_.clear();
+        if (cmd_pool_) { vkDestroyCommandPool(ctx_->device, cmd_pool_, nullptr); cmd_pool_ = VK_NULL_HANDLE; }
+        if (render_pass_) { vkDestroyRenderPass(ctx_->device, render_pass_, nullptr); render_pass_ = VK_NULL_HANDLE; }
+    }
+    stream_listener_.reset();
+    api_.reset();
+    if (lib_) { dlclose(lib_); lib_ = nullptr; }
+}
+
+}  // namespace vrto3d
@@ -0,0 +1,152 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+// Linux PipeWire output: publishes the repacked frame as a "Video/Source"
+// node so OBS, gstreamer (pipewiresrc) or any recorder can take the 3D
+// output directly, without capturing a window off the desktop.
+//
+// Buffers are ours (PW_STREAM_FLAG_ALLOC_BUFFERS). The format offer lists
+// the renderable, exportable DRM modifiers for BGRx first: a consumer that
+// picks one gets the repack rendered straight into a ring of exported
+// dmabufs. A consumer without dmabuf import negotiates the plain offer and
+// gets MemFd buffers, filled by a readback copy after each frame.
+//
+// The stream drives its graph (PW_STREAM_FLAG_DRIVER), so frames go out at
+// the game's rate. With no consumer connected, or one that still holds
+// every buffer, AcquireNext() skips the frame rather than waiting.
+//
+// libpipewire-0.3 is dlopen'd — without PipeWire, Init fails gracefully
+// like the WibbleWobble handoff.
+//
+// Thread model: negotiation and buffer add/remove run on PipeWire's own
+// thread loop; they only create and export images. Everything that records
+// or submits runs on the present thread, and buffers removed while in use
+// are retired there.
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "presenter/vk_presenter.h"
+#include "vk/vk_context.h"
+
+struct pw_buffer;
+struct pw_context;
+struct pw_core;
+struct pw_stream;
+struct pw_thread_loop;
+struct spa_hook;
+struct spa_pod;
+struct spa_pod_builder;
+
+namespace vrto3d {
+
+class PipeWirePresenter final : public IVkPresenter {
+public:
+    PipeWirePresenter();
+    ~PipeWirePresenter() override;
+
+    bool Init(vrto3d::vk::DeviceCtx* ctx, const StereoDisplayDriverConfiguration& cfg) override;
+    void Shutdown() override;
+    bool PumpEvents() override;
+    bool AcquireNext(FrameTarget* out, VkSemaphore signal_sem) override;
+    bool Present(uint32_t image_index, VkSemaphore wait_sem) override;
+
+    VkRenderPass RenderPass() const override { return render_pass_; }
+    VkExtent2D   Extent() const override { return extent_; }
+    VkFormat     Format() const override { return format_; }
+    const char*  Name() const override { return "pipewire"; }
+
+    // Stream events, on the PipeWire thread (loop lock held).
+    void OnStateChanged(int old_state, int state, const char* error);
+    void OnParamChanged(uint32_t id, const spa_pod* param);
+    void OnAddBuffer(pw_buffer* buffer);
+    void OnRemoveBuffer(pw_buffer* buffer);
+
+private:
+    struct Slot {
+        bool           used = false;
+        bool           dmabuf = false;
+        pw_buffer*     buffer = nullptr;     // owning PipeWire buffer
+        VkImage        image = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkImageView    view = VK_NULL_HANDLE;
+        VkFramebuffer  framebuffer = VK_NULL_HANDLE;
+        int            fd = -1;              // dmabuf or memfd
+        // MemFd path: readback staging buffer and the shared mapping.
+        VkBuffer       staging = VK_NULL_HANDLE;
+        VkDeviceMemory staging_mem = VK_NULL_HANDLE;
+        void*          staging_ptr = nullptr;
+        void*          map = nullptr;
+        uint64_t       map_size = 0;
+        // Present thread only.
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        VkFence        fence = VK_NULL_HANDLE;
+        bool           acquired = false;     // handed to the renderer
+    };
+
+    bool LoadPipeWire();
+    bool CreateRenderPass();
+    uint32_t BuildFormats(spa_pod_builder* b, const spa_pod** params,
+                          const std::vector<uint64_t>& modifiers);
+    bool AllocateDmabuf(Slot& slot, pw_buffer* buffer);
+    bool AllocateMemFd(Slot& slot, pw_buffer* buffer);
+    void DestroySlot(Slot& slot);
+    void DestroyRetired();
+
+    vrto3d::vk::DeviceCtx* ctx_ = nullptr;
+    VkExtent2D   extent_{};
+    VkFormat     format_ = VK_FORMAT_B8G8R8A8_UNORM;
+    VkRenderPass render_pass_ = VK_NULL_HANDLE;
+    VkCommandPool cmd_pool_ = VK_NULL_HANDLE;
+    uint32_t     max_fps_ = 60;
+    PFN_vkGetMemoryFdKHR get_memory_fd_ = nullptr;
+    PFN_vkGetImageDrmFormatModifierPropertiesEXT get_image_modifier_ = nullptr;
+    std::vector<vrto3d::vk::DrmModifier> renderable_;
+
+    // Negotiated format (PipeWire thread; read by OnAddBuffer).
+    bool     use_dmabuf_ = false;
+    uint64_t modifier_ = 0;
+    uint32_t planes_ = 1;
+    uint32_t stride_ = 0;           // MemFd rows
+
+    // Buffer slots. The mutex guards `used`, `buffer`, `acquired` and the
+    // retired list between the PipeWire thread and the present thread.
+    static constexpr int kMaxSlots = 16;
+    std::mutex        slots_mutex_;
+    Slot              slots_[kMaxSlots];
+    std::vector<int>  retired_;     // removed while acquired; freed on present thread
+    bool              streaming_ = false;
+    uint64_t          seq_ = 0;
+
+    // libpipewire-0.3 (dlopen'd)
+    void*             lib_ = nullptr;
+    struct Api;
+    std::unique_ptr<Api> api_;
+    pw_thread_loop*   loop_ = nullptr;
+    pw_context*       context_ = nullptr;
+    pw_core*          core_ = nullptr;
+    pw_stream*        stream_ = nullptr;
+    std::unique_ptr<spa_hook> stream_listener_;
+};
+
+}  // namespace vrto3d
@@ -27,11 +27,20 @@ namespace vrto3d {
 // PumpEvents, SetAlwaysOnTop, SetInputCapture, Name) and populate ctx_ +
 // swapchain_ during Init. Presenters that don't own a swapchain (e.g.
 // WibbleWobblePresenter, which streams dmabufs) implement IVkPresenter directly.
+//
+// DualDisplay lockstep: a subclass that finds the right eye's monitor creates
+// a surface there and builds secondary_ on it (same device, same format, so
+// its framebuffers work with swapchain_'s render pass). The multi-target
+// calls then drive both bundles; with secondary_ unused they reduce to the
+// single-swapchain ones.
 class SwapchainPresenterBase : public IVkPresenter {
 public:
     bool AcquireNext(FrameTarget* out, VkSemaphore signal_sem) override {
         return swapchain_.AcquireNext(out, signal_sem);
     }
+    bool TryAcquireNext(FrameTarget* out, VkSemaphore signal_sem) override {
+        return swapchain_.AcquireNext(out, signal_sem, 0);
+    }
     bool Present(uint32_t image_index, VkSemaphore wait_sem) override {
         return swapchain_.Present(image_index, wait_sem);
     }
@@ -39,9 +48,31 @@ public:
     VkExtent2D   Extent() const override { return swapchain_.extent; }
     VkFormat     Format() const override { return swapchain_.format; }
 
+    uint32_t TargetCount() const override { return secondary_.ctx ? 2 : 1; }
+    bool AcquireTargets(FrameTarget* out, const VkSemaphore* signal_sems) override {
+        if (!AcquireNext(&out[0], signal_sems[0])) return false;
+        if (secondary_.ctx) {
+            // The primary image is ours now and has to be presented, so a
+            // secondary that is out of date just sits this frame out.
+            if (!secondary_.AcquireNext(&out[1], signal_sems[1])) out[1] = FrameTarget{};
+        }
+        return true;
+    }
+    bool PresentTargets(const FrameTarget* targets, VkSemaphore wait_sem) override {
+        if (!secondary_.ctx || targets[1].framebuffer == VK_NULL_HANDLE)
+            return Present(targets[0].index, wait_sem);
+        SwapchainBundle* bundles[2] = {&swapchain_, &secondary_};
+        const uint32_t indices[2] = {targets[0].index, targets[1].index};
+        return SwapchainBundle::PresentMany(bundles, indices, 2, wait_sem);
+    }
+    VkExtent2D TargetExtent(uint32_t target) const override {
+        return target == 1 && secondary_.ctx ? secondary_.extent : Extent();
+    }
+
 protected:
     vk::DeviceCtx*  ctx_ = nullptr;
     SwapchainBundle swapchain_;
+    SwapchainBundle secondary_;   // right eye's output in DualDisplay lockstep
 };
 
 }  // namespace vrto3d
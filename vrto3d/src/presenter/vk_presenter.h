@@ -28,13 +28,21 @@ struct DeviceCtx;
 
 namespace vrto3d {
 
+struct OutputProfileOptions;
+
 // Linux presenter seam: owns the native window/surface + Vulkan swapchain on
-// the chosen output. Two implementations: WaylandPresenter (layer-shell
-// overlay with xdg_toplevel fullscreen fallback) and X11Presenter (positioned
-// borderless topmost window, XRandR modelines).
+// the chosen output. Implementations: WaylandPresenter (layer-shell overlay
+// with xdg_toplevel fullscreen fallback), X11Presenter (positioned borderless
+// topmost window, XRandR modelines) and DrmDisplayPresenter (VK_KHR_display
+// scanout on a leased or directly opened DRM connector). The off-screen sinks
+// (WibbleWobblePresenter, PipeWirePresenter) render into their own buffer
+// rings instead of a swapchain.
 //
-// Thread model: ALL methods are called from the renderer's present thread
-// (which is also the thread that created the object via MakeVkPresenter).
+// Thread model: ALL methods of the primary presenter are called from the
+// renderer's present thread (which is also the thread that created the
+// object via MakeVkPresenter). A mirror's calls are split between the
+// present thread and the mirror's own thread (event pumping and Present),
+// but never overlap: the renderer serializes them with a per-mirror mutex.
 class IVkPresenter {
 public:
     virtual ~IVkPresenter() = default;
@@ -46,6 +54,24 @@ public:
         uint32_t      index = 0;
     };
 
+    // What the display server reported for one Present(). Times are
+    // CLOCK_MONOTONIC seconds (platform::MonotonicSeconds).
+    enum PresentFlags : uint32_t {
+        kPresentVsync        = 0x1,  // flipped on vblank (no tearing)
+        kPresentHwClock      = 0x2,  // timestamp from the display hardware
+        kPresentHwCompletion = 0x4,  // completion signalled by hardware
+        kPresentZeroCopy     = 0x8,  // scanned out directly, no composite copy
+    };
+    struct PresentTiming {
+        uint64_t frame_id = 0;          // presenter-local, one per Present()
+        double   submit_time = 0.0;     // when Present() was called
+        double   presented_time = 0.0;  // first light on screen; 0 if discarded
+        double   refresh_period = 0.0;  // to the next refresh; 0 = variable/unknown
+        uint64_t msc = 0;               // output vblank counter; 0 = none
+        uint32_t flags = 0;             // PresentFlags
+        bool     discarded = false;     // superseded, never shown
+    };
+
     // Creates the native window fullscreen-covering the output selected by
     // cfg.display_index (1-based; 0 = primary), the VkSurfaceKHR, a FIFO
     // swapchain, and a render pass targeting the swapchain format
@@ -57,15 +83,64 @@ public:
     // closed/destroyed and presenting must stop.
     virtual bool PumpEvents() = 0;
 
+    // Event-loop integration. EventFd() is the display connection the
+    // renderer adds to its epoll set (-1 = nothing to watch). Around each
+    // blocking wait the renderer calls PrepareEventWait(), which flushes
+    // outgoing requests and returns false if events are already queued
+    // client-side (the wait must not block then), and FinishEventWait()
+    // with whether the fd became readable. PumpEvents() runs after.
+    virtual int  EventFd() const { return -1; }
+    virtual bool PrepareEventWait() { return true; }
+    virtual void FinishEventWait(bool readable) {}
+
+    // Presentation feedback. HasPresentTiming() is true when the display
+    // server reports per-frame results; PopPresentTiming() then yields them
+    // oldest-first as they arrive (delivered through PumpEvents, usually a
+    // frame or two after the Present they describe).
+    virtual bool HasPresentTiming() const { return false; }
+    virtual bool PopPresentTiming(PresentTiming* out) { return false; }
+
     // Acquire the next swapchain image; `signal_sem` is signaled when the
     // image is ready to be rendered to. Handles OUT_OF_DATE by recreating
     // the swapchain internally (returns false for "skip this frame").
     virtual bool AcquireNext(FrameTarget* out, VkSemaphore signal_sem) = 0;
 
+    // AcquireNext for a mirror output: returns false instead of waiting when
+    // the consumer still holds every image, so a slow sink drops the frame
+    // rather than holding up the primary output. Presenters whose
+    // AcquireNext never blocks can keep the default.
+    virtual bool TryAcquireNext(FrameTarget* out, VkSemaphore signal_sem) {
+        return AcquireNext(out, signal_sem);
+    }
+
     // Queue the present for the acquired image, waiting on `wait_sem`.
     // FIFO mode: this is the frame-pacing block.
     virtual bool Present(uint32_t image_index, VkSemaphore wait_sem) = 0;
 
+    // Lockstep outputs. DualDisplay modes with both eyes' monitors found
+    // drive each one from its own surface and swapchain: TargetCount() is 2,
+    // target 0 shows the left half of the packed frame and target 1 the
+    // right. AcquireTargets fills out[0..TargetCount()), signalling
+    // signal_sems[i] for each; a target it had to skip (its swapchain is
+    // being recreated) comes back with a null framebuffer and its semaphore
+    // untouched. False means skip the whole frame, as with AcquireNext.
+    // PresentTargets queues every acquired target in one vkQueuePresentKHR
+    // waiting on `wait_sem` once, so both outputs take the same frame on
+    // their next vblank.
+    virtual uint32_t TargetCount() const { return 1; }
+    virtual bool AcquireTargets(FrameTarget* out, const VkSemaphore* signal_sems) {
+        return AcquireNext(out, signal_sems[0]);
+    }
+    virtual bool PresentTargets(const FrameTarget* targets, VkSemaphore wait_sem) {
+        return Present(targets[0].index, wait_sem);
+    }
+    virtual VkExtent2D TargetExtent(uint32_t target) const { return Extent(); }
+
+    // Packing the repack shader should produce for the configured mode.
+    // Presenters whose consumer takes a different layout than the mode's own
+    // (WibbleWobble's checkerboard source format) return that mode instead.
+    virtual OutputMode RepackMode(OutputMode configured) const { return configured; }
+
     virtual VkRenderPass RenderPass() const = 0;
     virtual VkExtent2D   Extent() const = 0;
     virtual VkFormat     Format() const = 0;
@@ -90,11 +165,28 @@ public:
     // OSD can be clicked/typed without leaking to the game. The OSD itself
     // reads input via evdev regardless; capture only shields the game.
     virtual void SetInputCapture(bool capture) {}
+
+    // Variable refresh. Asks the display path to let each Present() start a
+    // refresh instead of waiting for a fixed vblank (X11: _VARIABLE_REFRESH
+    // window property; Wayland: wp_content_type_v1 "game", which compositors
+    // with automatic VRR act on; KMS: the CRTC's VRR_ENABLED). Returns false
+    // when the path has no way to ask; true only means the request was made —
+    // the sink and driver still decide.
+    virtual bool SetVariableRefresh(bool enable) { return false; }
+
+    // Per-profile output options (profile_sidecar.h). Called once before
+    // Init() and again whenever the active profile's options change; the
+    // presenter rebuilds whatever depends on them. Extent() may change.
+    virtual void ApplyProfile(const OutputProfileOptions& opts) {}
 };
 
 // Session-based selection: Wayland when WAYLAND_DISPLAY is set and connectable
 // (unless cfg overrides via linux_presenter = "x11"/"wayland"), else X11 via
-// DISPLAY. Returns nullptr when neither display server is reachable.
+// DISPLAY, else DrmDisplayPresenter on the bare KMS device.
 std::unique_ptr<IVkPresenter> MakeVkPresenter(const StereoDisplayDriverConfiguration& cfg);
 
+// Backend by VRTO3D_PRESENTER name (x11|wayland|drm|wibblewobble|pipewire);
+// null for an unknown name. Used for the renderer's mirror outputs.
+std::unique_ptr<IVkPresenter> MakeVkPresenterByName(const char* name);
+
 }  // namespace vrto3d
@@ -19,6 +19,10 @@
 #include <cstdlib>
 #include <cstring>
 
+#include "presenter/drm_display_presenter.h"
+#ifdef VRTO3D_HAVE_PIPEWIRE
+#include "presenter/pipewire_presenter.h"
+#endif
 #include "presenter/vk_swapchain_util.h"
 #include "presenter/wayland_presenter.h"
 #include "presenter/wibblewobble_presenter_linux.h"
@@ -36,10 +40,27 @@ bool EnvSet(const char* name)
 
 }  // namespace
 
-// Session-based selection. VRTO3D_PRESENTER=x11|wayland|wibblewobble forces a
-// backend; otherwise output_mode==WibbleWobble routes to the WibbleWobbleLinux
+std::unique_ptr<IVkPresenter> MakeVkPresenterByName(const char* name)
+{
+    if (std::strcmp(name, "x11") == 0)
+        return std::make_unique<X11Presenter>();
+    if (std::strcmp(name, "wayland") == 0)
+        return std::make_unique<WaylandPresenter>();
+    if (std::strcmp(name, "drm") == 0)
+        return std::make_unique<DrmDisplayPresenter>();
+    if (std::strcmp(name, "wibblewobble") == 0)
+        return std::make_unique<WibbleWobblePresenter>();
+#ifdef VRTO3D_HAVE_PIPEWIRE
+    if (std::strcmp(name, "pipewire") == 0)
+        return std::make_unique<PipeWirePresenter>();
+#endif
+    return nullptr;
+}
+
+// Session-based selection. VRTO3D_PRESENTER=x11|wayland|drm|wibblewobble|pipewire
+// forces a backend; otherwise output_mode==WibbleWobble routes to the WibbleWobbleLinux
 // handoff, and the rest pick by session env (WAYLAND_DISPLAY -> Wayland, else
-// DISPLAY -> X11).
+// DISPLAY -> X11, else no display server -> direct KMS output).
 std::unique_ptr<IVkPresenter> MakeVkPresenter(const StereoDisplayDriverConfiguration& cfg)
 {
     const char* forced = std::getenv("VRTO3D_PRESENTER");
@@ -48,15 +69,11 @@ std::unique_ptr<IVkPresenter> MakeVkPresenter(const StereoDisplayDriverConfigura
         PresenterLog("MakeVkPresenter: WibbleWobble output — streaming to wwserver");
         return std::make_unique<WibbleWobblePresenter>();
     }
-    if (forced && std::strcmp(forced, "x11") == 0) {
-        PresenterLog("MakeVkPresenter: VRTO3D_PRESENTER=x11");
-        return std::make_unique<X11Presenter>();
-    }
-    if (forced && std::strcmp(forced, "wayland") == 0) {
-        PresenterLog("MakeVkPresenter: VRTO3D_PRESENTER=wayland");
-        return std::make_unique<WaylandPresenter>();
-    }
     if (forced && forced[0] != '\0') {
+        if (auto presenter = MakeVkPresenterByName(forced)) {
+            PresenterLog("MakeVkPresenter: VRTO3D_PRESENTER=%s", forced);
+            return presenter;
+        }
         PresenterLog("MakeVkPresenter: unknown VRTO3D_PRESENTER='%s' — using auto-detect", forced);
     }
 
@@ -69,8 +86,8 @@ std::unique_ptr<IVkPresenter> MakeVkPresenter(const StereoDisplayDriverConfigura
         return std::make_unique<X11Presenter>();
     }
 
-    PresenterLog("MakeVkPresenter: neither WAYLAND_DISPLAY nor DISPLAY set — no presenter");
-    return nullptr;
+    PresenterLog("MakeVkPresenter: neither WAYLAND_DISPLAY nor DISPLAY set — direct DRM presenter");
+    return std::make_unique<DrmDisplayPresenter>();
 }
 
 }  // namespace vrto3d
@@ -320,7 +320,8 @@ void SwapchainBundle::SetDesiredExtent(uint32_t w, uint32_t h)
 }
 
 
-bool SwapchainBundle::AcquireNext(IVkPresenter::FrameTarget* out, VkSemaphore signal_sem)
+bool SwapchainBundle::AcquireNext(IVkPresenter::FrameTarget* out, VkSemaphore signal_sem,
+                                  uint64_t timeout_ns)
 {
     if (!ctx) return false;
 
@@ -331,8 +332,12 @@ bool SwapchainBundle::AcquireNext(IVkPresenter::FrameTarget* out, VkSemaphore si
     }
 
     uint32_t index = 0;
-    VkResult r = vkAcquireNextImageKHR(ctx->device, swapchain, UINT64_MAX,
+    VkResult r = vkAcquireNextImageKHR(ctx->device, swapchain, timeout_ns,
                                        signal_sem, VK_NULL_HANDLE, &index);
+    if (r == VK_NOT_READY || r == VK_TIMEOUT) {
+        // Every image still queued or on screen; nothing was signaled.
+        return false;
+    }
     if (r == VK_ERROR_OUT_OF_DATE_KHR) {
         // Semaphore was NOT signaled — safe to recreate and skip the frame.
         needs_recreate = true;
@@ -357,32 +362,57 @@ bool SwapchainBundle::AcquireNext(IVkPresenter::FrameTarget* out, VkSemaphore si
 
 bool SwapchainBundle::Present(uint32_t image_index, VkSemaphore wait_sem)
 {
-    if (!ctx || swapchain == VK_NULL_HANDLE) return false;
+    SwapchainBundle* self = this;
+    return PresentMany(&self, &image_index, 1, wait_sem);
+}
+
+
+bool SwapchainBundle::PresentMany(SwapchainBundle* const* bundles, const uint32_t* image_indices,
+                                  uint32_t count, VkSemaphore wait_sem)
+{
+    constexpr uint32_t kMaxSwapchains = 4;
+    if (count == 0 || count > kMaxSwapchains) return false;
+    VkSwapchainKHR swapchains[kMaxSwapchains];
+    VkResult       results[kMaxSwapchains];
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!bundles[i]->ctx || bundles[i]->swapchain == VK_NULL_HANDLE) return false;
+        swapchains[i] = bundles[i]->swapchain;
+        results[i] = VK_SUCCESS;
+    }
+    vk::DeviceCtx* ctx = bundles[0]->ctx;
 
     VkPresentInfoKHR pi{ VK_STRUCTURE_TYPE_PRESENT_INFO_KHR };
     pi.waitSemaphoreCount = 1;
     pi.pWaitSemaphores    = &wait_sem;
-    pi.swapchainCount     = 1;
-    pi.pSwapchains        = &swapchain;
-    pi.pImageIndices      = &image_index;
+    pi.swapchainCount     = count;
+    pi.pSwapchains        = swapchains;
+    pi.pImageIndices      = image_indices;
+    pi.pResults           = results;
 
     VkResult r;
     {
         std::lock_guard<std::mutex> lock(ctx->queue_mutex);
         r = vkQueuePresentKHR(ctx->queue, &pi);
     }
-
-    if (r == VK_ERROR_OUT_OF_DATE_KHR || r == VK_SUBOPTIMAL_KHR) {
-        // Wait semaphore is still consumed by a rejected present (spec
-        // guarantees the wait executes), so just flag the recreate.
-        needs_recreate = true;
-        return true;
+    if (count == 1) results[0] = r;
+
+    bool ok = true;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (results[i] == VK_ERROR_OUT_OF_DATE_KHR || results[i] == VK_SUBOPTIMAL_KHR) {
+            // Wait semaphore is still consumed by a rejected present (spec
+            // guarantees the wait executes), so just flag the recreate.
+            bundles[i]->needs_recreate = true;
+        } else if (results[i] != VK_SUCCESS) {
+            PresenterLog("SwapchainBundle: vkQueuePresentKHR failed (r=%d, swapchain %u/%u)",
+                         static_cast<int>(results[i]), i + 1, count);
+            ok = false;
+        }
     }
-    if (r != VK_SUCCESS) {
+    if (ok && r != VK_SUCCESS && r != VK_SUBOPTIMAL_KHR && r != VK_ERROR_OUT_OF_DATE_KHR) {
         PresenterLog("SwapchainBundle: vkQueuePresentKHR failed (r=%d)", static_cast<int>(r));
-        return false;
+        ok = false;
     }
-    return true;
+    return ok;
 }
 
 }  // namespace vrto3d
@@ -76,9 +76,19 @@ struct SwapchainBundle {
 
     void Destroy();
 
-    bool AcquireNext(IVkPresenter::FrameTarget* out, VkSemaphore signal_sem);
+    // `timeout_ns` = 0 polls: false (semaphore untouched) when no image is
+    // free yet.
+    bool AcquireNext(IVkPresenter::FrameTarget* out, VkSemaphore signal_sem,
+                     uint64_t timeout_ns = UINT64_MAX);
     bool Present(uint32_t image_index, VkSemaphore wait_sem);
 
+    // One vkQueuePresentKHR for an image from each bundle, all waiting on
+    // `wait_sem`. Per-swapchain results flag recreates exactly as Present()
+    // does; false if any swapchain failed outright. All bundles must share
+    // the device.
+    static bool PresentMany(SwapchainBundle* const* bundles, const uint32_t* image_indices,
+                            uint32_t count, VkSemaphore wait_sem);
+
     // Update the fallback extent (called from native configure events).
     void SetDesiredExtent(uint32_t w, uint32_t h);
 
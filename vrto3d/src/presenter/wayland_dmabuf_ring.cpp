@@ -0,0 +1,704 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "presenter/wayland_dmabuf_ring.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <linux/dma-buf.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+#include <drm_fourcc.h>
+#include <wayland-client.h>
+
+#include "linux-dmabuf-v1-client-protocol.h"
+#include "presenter/vk_swapchain_util.h"  // PresenterLog
+#include "vk/vk_context.h"
+
+// Kernel headers before 6.0 lack the sync_file import; the ioctl itself
+// then fails with ENOTTY and Submit falls back to a CPU wait.
+#ifndef DMA_BUF_IOCTL_IMPORT_SYNC_FILE
+struct dma_buf_import_sync_file {
+    __u32 flags;
+    __s32 fd;
+};
+#define DMA_BUF_IOCTL_IMPORT_SYNC_FILE _IOW(DMA_BUF_BASE, 3, struct dma_buf_import_sync_file)
+#endif
+
+namespace vrto3d {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// C listener trampolines. Feedback events carry the ring; buffer events
+// carry their Buffer (the ring's vector is never resized while buffers are
+// live, so the pointers stay valid).
+// ---------------------------------------------------------------------------
+
+void FeedbackDone(void* data, zwp_linux_dmabuf_feedback_v1* /*feedback*/)
+{
+    static_cast<WaylandDmabufRing*>(data)->OnFeedbackDone();
+}
+
+void FeedbackFormatTable(void* data, zwp_linux_dmabuf_feedback_v1* /*feedback*/,
+                         int32_t fd, uint32_t size)
+{
+    static_cast<WaylandDmabufRing*>(data)->OnFormatTable(fd, size);
+}
+
+void FeedbackMainDevice(void* data, zwp_linux_dmabuf_feedback_v1* /*feedback*/,
+                        wl_array* device)
+{
+    static_cast<WaylandDmabufRing*>(data)->OnMainDevice(device);
+}
+
+void FeedbackTrancheDone(void* data, zwp_linux_dmabuf_feedback_v1* /*feedback*/)
+{
+    static_cast<WaylandDmabufRing*>(data)->OnTrancheDone();
+}
+
+void FeedbackTrancheTargetDevice(void* data, zwp_linux_dmabuf_feedback_v1* /*feedback*/,
+                                 wl_array* device)
+{
+    static_cast<WaylandDmabufRing*>(data)->OnTrancheTargetDevice(device);
+}
+
+void FeedbackTrancheFormats(void* data, zwp_linux_dmabuf_feedback_v1* /*feedback*/,
+                            wl_array* indices)
+{
+    static_cast<WaylandDmabufRing*>(data)->OnTrancheFormats(indices);
+}
+
+void FeedbackTrancheFlags(void* data, zwp_linux_dmabuf_feedback_v1* /*feedback*/,
+                          uint32_t flags)
+{
+    static_cast<WaylandDmabufRing*>(data)->OnTrancheFlags(flags);
+}
+
+const zwp_linux_dmabuf_feedback_v1_listener kFeedbackListener = {
+    FeedbackDone,
+    FeedbackFormatTable,
+    FeedbackMainDevice,
+    FeedbackTrancheDone,
+    FeedbackTrancheTargetDevice,
+    FeedbackTrancheFormats,
+    FeedbackTrancheFlags,
+};
+
+void ParamsCreated(void* data, zwp_linux_buffer_params_v1* params, wl_buffer* buffer);
+void ParamsFailed(void* data, zwp_linux_buffer_params_v1* params);
+
+const zwp_linux_buffer_params_v1_listener kParamsListener = {
+    ParamsCreated,
+    ParamsFailed,
+};
+
+void BufferRelease(void* data, wl_buffer* /*buffer*/)
+{
+    static_cast<WaylandDmabufRing::Buffer*>(data)->held = false;
+}
+
+const wl_buffer_listener kBufferListener = {
+    BufferRelease,
+};
+
+void ParamsCreated(void* data, zwp_linux_buffer_params_v1* params, wl_buffer* buffer)
+{
+    auto* buf = static_cast<WaylandDmabufRing::Buffer*>(data);
+    buf->wl = buffer;
+    wl_buffer_add_listener(buffer, &kBufferListener, buf);
+    zwp_linux_buffer_params_v1_destroy(params);
+    buf->params = nullptr;
+}
+
+void ParamsFailed(void* data, zwp_linux_buffer_params_v1* params)
+{
+    auto* buf = static_cast<WaylandDmabufRing::Buffer*>(data);
+    buf->failed = true;
+    zwp_linux_buffer_params_v1_destroy(params);
+    buf->params = nullptr;
+}
+
+dev_t DeviceFromArray(const wl_array* array)
+{
+    dev_t dev = 0;
+    if (array && array->size == sizeof(dev))
+        std::memcpy(&dev, array->data, sizeof(dev));
+    return dev;
+}
+
+// B8G8R8A8 in memory is XRGB8888/ARGB8888 in DRM terms; X first, since an
+// opaque format is what planes most often accept.
+constexpr uint32_t kDrmFormats[] = {DRM_FORMAT_XRGB8888, DRM_FORMAT_ARGB8888};
+
+// Round-trips allowed while waiting for the first feedback or for buffer
+// creation results.
+constexpr int kMaxRoundtrips = 10;
+
+}  // namespace
+
+
+WaylandDmabufRing::~WaylandDmabufRing()
+{
+    Destroy();
+}
+
+
+bool WaylandDmabufRing::Init(vk::DeviceCtx* ctx, wl_display* display, zwp_linux_dmabuf_v1* dmabuf,
+                             wl_surface* surface, uint32_t width, uint32_t height)
+{
+    ctx_ = ctx;
+    display_ = display;
+    dmabuf_ = dmabuf;
+    desired_extent_ = {width, height};
+
+    get_memory_fd_ = (PFN_vkGetMemoryFdKHR)vkGetDeviceProcAddr(ctx_->device, "vkGetMemoryFdKHR");
+    get_semaphore_fd_ =
+        (PFN_vkGetSemaphoreFdKHR)vkGetDeviceProcAddr(ctx_->device, "vkGetSemaphoreFdKHR");
+    get_image_modifier_ = (PFN_vkGetImageDrmFormatModifierPropertiesEXT)vkGetDeviceProcAddr(
+        ctx_->device, "vkGetImageDrmFormatModifierPropertiesEXT");
+    if (!get_memory_fd_ || !get_image_modifier_) {
+        PresenterLog("WaylandDmabufRing: dmabuf export entry points unavailable");
+        return false;
+    }
+
+    // The sync_file path also needs a semaphore that can be exported as one.
+    VkPhysicalDeviceExternalSemaphoreInfo sem_info{
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_SEMAPHORE_INFO};
+    sem_info.handleType = VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_SYNC_FD_BIT;
+    VkExternalSemaphoreProperties sem_props{VK_STRUCTURE_TYPE_EXTERNAL_SEMAPHORE_PROPERTIES};
+    vkGetPhysicalDeviceExternalSemaphoreProperties(ctx_->phys, &sem_info, &sem_props);
+    sync_file_import_ = get_semaphore_fd_ &&
+        (sem_props.externalSemaphoreFeatures & VK_EXTERNAL_SEMAPHORE_FEATURE_EXPORTABLE_BIT);
+
+    feedback_ = zwp_linux_dmabuf_v1_get_surface_feedback(dmabuf_, surface);
+    zwp_linux_dmabuf_feedback_v1_add_listener(feedback_, &kFeedbackListener, this);
+    for (int i = 0; i < kMaxRoundtrips && !feedback_received_; ++i) {
+        if (wl_display_roundtrip(display_) < 0)
+            return false;
+    }
+    if (!feedback_received_) {
+        PresenterLog("WaylandDmabufRing: no dmabuf feedback for the surface");
+        return false;
+    }
+
+    if (!CreateRenderPass())
+        return false;
+    VkCommandPoolCreateInfo cpci{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+    cpci.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    cpci.queueFamilyIndex = ctx_->queue_family;
+    if (vkCreateCommandPool(ctx_->device, &cpci, nullptr, &cmd_pool_) != VK_SUCCESS)
+        return false;
+
+    Choice choice;
+    if (!Choose(width, height, &choice)) {
+        PresenterLog("WaylandDmabufRing: no offered XRGB/ARGB8888 modifier is renderable here");
+        return false;
+    }
+    if (!Allocate(choice, width, height, &buffers_))
+        return false;
+    realloc_pending_ = false;
+    PresenterLog("WaylandDmabufRing: %ux%u, %zu tranche(s), main device %u:%u, sync %s",
+                 extent_.width, extent_.height, tranches_.size(),
+                 major(main_device_), minor(main_device_),
+                 sync_file_import_ ? "implicit (sync_file import)" : "CPU wait");
+    return true;
+}
+
+
+bool WaylandDmabufRing::CreateRenderPass()
+{
+    // Like the swapchain pass (the repack writes every pixel), but ends in
+    // COLOR_ATTACHMENT_OPTIMAL: Submit() moves the image to GENERAL while
+    // releasing it to the compositor.
+    VkAttachmentDescription att{};
+    att.format         = format_;
+    att.samples        = VK_SAMPLE_COUNT_1_BIT;
+    att.loadOp         = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    att.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
+    att.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    att.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    att.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
+    att.finalLayout    = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    VkAttachmentReference ref{0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+    VkSubpassDescription sub{};
+    sub.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    sub.colorAttachmentCount = 1;
+    sub.pColorAttachments = &ref;
+    VkSubpassDependency dep{};
+    dep.srcSubpass    = VK_SUBPASS_EXTERNAL;
+    dep.dstSubpass    = 0;
+    dep.srcStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dep.dstStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dep.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    VkRenderPassCreateInfo rp{VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO};
+    rp.attachmentCount = 1;
+    rp.pAttachments = &att;
+    rp.subpassCount = 1;
+    rp.pSubpasses = &sub;
+    rp.dependencyCount = 1;
+    rp.pDependencies = &dep;
+    if (vkCreateRenderPass(ctx_->device, &rp, nullptr, &render_pass_) != VK_SUCCESS) {
+        PresenterLog("WaylandDmabufRing: render pass creation failed");
+        return false;
+    }
+    return true;
+}
+
+
+bool WaylandDmabufRing::Choose(uint32_t width, uint32_t height, Choice* out) const
+{
+    const std::vector<VkModifier> renderable =
+        vk::RenderableDrmModifiers(*ctx_, format_, width, height);
+    // Tranches arrive most-preferred first; take the first with any usable
+    // pair, so a scanout tranche wins whenever the compositor offers one.
+    for (const Tranche& t : tranches_) {
+        for (uint32_t drm_format : kDrmFormats) {
+            Choice c;
+            c.drm_format = drm_format;
+            c.scanout = (t.flags & ZWP_LINUX_DMABUF_FEEDBACK_V1_TRANCHE_FLAGS_SCANOUT) != 0;
+            for (uint16_t idx : t.indices) {
+                if (idx >= table_.size() || table_[idx].format != drm_format)
+                    continue;
+                for (const VkModifier& m : renderable) {
+                    if (m.modifier == table_[idx].modifier)
+                        c.modifiers.push_back(m);
+                }
+            }
+            if (!c.modifiers.empty()) {
+                *out = std::move(c);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+bool WaylandDmabufRing::Allocate(const Choice& choice, uint32_t width, uint32_t height,
+                                 std::vector<Buffer>* out)
+{
+    std::vector<uint64_t> modifiers;
+    for (const VkModifier& m : choice.modifiers)
+        modifiers.push_back(m.modifier);
+
+    VkCommandBufferAllocateInfo cbai{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+    cbai.commandPool = cmd_pool_;
+    cbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    cbai.commandBufferCount = 1;
+
+    std::vector<Buffer>& ring = *out;
+    ring.resize(kRing);
+    uint64_t chosen_modifier = DRM_FORMAT_MOD_INVALID;
+    bool ok = true;
+    for (Buffer& b : ring) {
+        b.owner = this;
+
+        VkImageDrmFormatModifierListCreateInfoEXT mod_list{
+            VK_STRUCTURE_TYPE_IMAGE_DRM_FORMAT_MODIFIER_LIST_CREATE_INFO_EXT};
+        mod_list.drmFormatModifierCount = static_cast<uint32_t>(modifiers.size());
+        mod_list.pDrmFormatModifiers = modifiers.data();
+        VkExternalMemoryImageCreateInfo ext{VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_IMAGE_CREATE_INFO};
+        ext.pNext = &mod_list;
+        ext.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT;
+        VkImageCreateInfo ici{VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+        ici.pNext = &ext;
+        ici.imageType = VK_IMAGE_TYPE_2D;
+        ici.format = format_;
+        ici.extent = {width, height, 1};
+        ici.mipLevels = 1;
+        ici.arrayLayers = 1;
+        ici.samples = VK_SAMPLE_COUNT_1_BIT;
+        ici.tiling = VK_IMAGE_TILING_DRM_FORMAT_MODIFIER_EXT;
+        ici.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        ici.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        ici.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        if (vk::LogIfFailed(vkCreateImage(ctx_->device, &ici, nullptr, &b.image),
+                            "dmabuf ring vkCreateImage") != VK_SUCCESS) {
+            ok = false;
+            break;
+        }
+
+        VkExportMemoryAllocateInfo export_info{VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO};
+        export_info.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT;
+        VkMemoryDedicatedAllocateInfo dedicated{VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO};
+        dedicated.pNext = &export_info;
+        dedicated.image = b.image;
+        if (!vk::AllocateBindImageView(*ctx_, b.image, format_, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                       &dedicated, 0, /*make_view=*/true, &b.memory, &b.view)) {
+            ok = false;
+            break;
+        }
+
+        VkImageDrmFormatModifierPropertiesEXT mod_props{
+            VK_STRUCTURE_TYPE_IMAGE_DRM_FORMAT_MODIFIER_PROPERTIES_EXT};
+        get_image_modifier_(ctx_->device, b.image, &mod_props);
+        chosen_modifier = mod_props.drmFormatModifier;
+        uint32_t planes = 1;
+        for (const VkModifier& m : choice.modifiers) {
+            if (m.modifier == chosen_modifier) planes = m.planes;
+        }
+
+        VkMemoryGetFdInfoKHR gfi{VK_STRUCTURE_TYPE_MEMORY_GET_FD_INFO_KHR};
+        gfi.memory = b.memory;
+        gfi.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT;
+        if (get_memory_fd_(ctx_->device, &gfi, &b.dmabuf_fd) != VK_SUCCESS || b.dmabuf_fd < 0) {
+            PresenterLog("WaylandDmabufRing: dmabuf export failed");
+            ok = false;
+            break;
+        }
+
+        VkFramebufferCreateInfo fbi{VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO};
+        fbi.renderPass = render_pass_;
+        fbi.attachmentCount = 1;
+        fbi.pAttachments = &b.view;
+        fbi.width = width;
+        fbi.height = height;
+        fbi.layers = 1;
+        if (vkCreateFramebuffer(ctx_->device, &fbi, nullptr, &b.framebuffer) != VK_SUCCESS) {
+            ok = false;
+            break;
+        }
+
+        vkAllocateCommandBuffers(ctx_->device, &cbai, &b.cmd);
+        VkFenceCreateInfo fci{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+        fci.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+        vkCreateFence(ctx_->device, &fci, nullptr, &b.fence);
+        if (sync_file_import_) {
+            VkExportSemaphoreCreateInfo esci{VK_STRUCTURE_TYPE_EXPORT_SEMAPHORE_CREATE_INFO};
+            esci.handleTypes = VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_SYNC_FD_BIT;
+            VkSemaphoreCreateInfo sci{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+            sci.pNext = &esci;
+            vkCreateSemaphore(ctx_->device, &sci, nullptr, &b.sync_sem);
+        }
+
+        // One plane per memory plane of the modifier, all in the same
+        // (dedicated) allocation. libwayland dups the fd when sending.
+        b.params = zwp_linux_dmabuf_v1_create_params(dmabuf_);
+        zwp_linux_buffer_params_v1_add_listener(b.params, &kParamsListener, &b);
+        for (uint32_t p = 0; p < planes; ++p) {
+            VkImageSubresource sr{};
+            sr.aspectMask = static_cast<VkImageAspectFlags>(VK_IMAGE_ASPECT_MEMORY_PLANE_0_BIT_EXT << p);
+            VkSubresourceLayout layout{};
+            vkGetImageSubresourceLayout(ctx_->device, b.image, &sr, &layout);
+            zwp_linux_buffer_params_v1_add(b.params, b.dmabuf_fd, p,
+                                           static_cast<uint32_t>(layout.offset),
+                                           static_cast<uint32_t>(layout.rowPitch),
+                                           static_cast<uint32_t>(chosen_modifier >> 32),
+                                           static_cast<uint32_t>(chosen_modifier & 0xffffffffu));
+        }
+        zwp_linux_buffer_params_v1_create(b.params, static_cast<int32_t>(width),
+                                          static_cast<int32_t>(height), choice.drm_format, 0);
+    }
+
+    // Wait for every created/failed answer; async create keeps a rejected
+    // import from being a fatal protocol error.
+    auto pending = [&ring]() {
+        return std::any_of(ring.begin(), ring.end(),
+                           [](const Buffer& b) { return b.params != nullptr; });
+    };
+    for (int i = 0; i < kMaxRoundtrips && pending(); ++i) {
+        if (wl_display_roundtrip(display_) < 0)
+            break;
+    }
+    if (ok) {
+        for (const Buffer& b : ring) {
+            if (!b.wl) { ok = false; break; }
+        }
+        if (!ok)
+            PresenterLog("WaylandDmabufRing: compositor rejected %.4s modifier 0x%016llx",
+                         reinterpret_cast<const char*>(&choice.drm_format),
+                         static_cast<unsigned long long>(chosen_modifier));
+    }
+    if (!ok) {
+        DestroyBuffers(out);
+        return false;
+    }
+
+    extent_ = {width, height};
+    next_ = 0;
+    drm_format_ = choice.drm_format;
+    modifier_ = chosen_modifier;
+    scanout_ = choice.scanout;
+    PresenterLog("WaylandDmabufRing: %d x %.4s modifier 0x%016llx from %s tranche",
+                 kRing, reinterpret_cast<const char*>(&drm_format_),
+                 static_cast<unsigned long long>(modifier_),
+                 scanout_ ? "scanout" : "composited");
+    return true;
+}
+
+
+void WaylandDmabufRing::DestroyBuffers(std::vector<Buffer>* buffers)
+{
+    for (Buffer& b : *buffers) {
+        if (b.params) zwp_linux_buffer_params_v1_destroy(b.params);
+        // The compositor keeps its own reference to anything still on screen.
+        if (b.wl) wl_buffer_destroy(b.wl);
+        if (b.sync_sem) vkDestroySemaphore(ctx_->device, b.sync_sem, nullptr);
+        if (b.fence) vkDestroyFence(ctx_->device, b.fence, nullptr);
+        if (b.cmd) vkFreeCommandBuffers(ctx_->device, cmd_pool_, 1, &b.cmd);
+        if (b.framebuffer) vkDestroyFramebuffer(ctx_->device, b.framebuffer, nullptr);
+        if (b.view) vkDestroyImageView(ctx_->device, b.view, nullptr);
+        if (b.image) vkDestroyImage(ctx_->device, b.image, nullptr);
+        if (b.memory) vkFreeMemory(ctx_->device, b.memory, nullptr);
+        if (b.dmabuf_fd >= 0) close(b.dmabuf_fd);
+    }
+    buffers->clear();
+}
+
+
+void WaylandDmabufRing::Destroy()
+{
+    if (ctx_ && ctx_->device != VK_NULL_HANDLE) {
+        {
+            std::lock_guard<std::mutex> lock(ctx_->queue_mutex);
+            vkQueueWaitIdle(ctx_->queue);
+        }
+        DestroyBuffers(&buffers_);
+        if (cmd_pool_) vkDestroyCommandPool(ctx_->device, cmd_pool_, nullptr);
+        if (render_pass_) vkDestroyRenderPass(ctx_->device, render_pass_, nullptr);
+    }
+    cmd_pool_ = VK_NULL_HANDLE;
+    render_pass_ = VK_NULL_HANDLE;
+    if (feedback_) {
+        zwp_linux_dmabuf_feedback_v1_destroy(feedback_);
+        feedback_ = nullptr;
+    }
+    ctx_ = nullptr;
+    display_ = nullptr;
+    dmabuf_ = nullptr;
+}
+
+
+void WaylandDmabufRing::SetDesiredExtent(uint32_t width, uint32_t height)
+{
+    if (width == desired_extent_.width && height == desired_extent_.height)
+        return;
+    desired_extent_ = {width, height};
+    realloc_pending_ = true;
+}
+
+
+void WaylandDmabufRing::Reallocate()
+{
+    realloc_pending_ = false;
+    const uint32_t w = desired_extent_.width;
+    const uint32_t h = desired_extent_.height;
+    Choice choice;
+    if (!Choose(w, h, &choice))
+        return;  // keep what works
+    const bool same_size = w == extent_.width && h == extent_.height;
+    const bool still_offered = std::any_of(
+        choice.modifiers.begin(), choice.modifiers.end(),
+        [this](const VkModifier& m) { return m.modifier == modifier_; });
+    if (same_size && choice.drm_format == drm_format_ && choice.scanout == scanout_ &&
+        still_offered)
+        return;
+
+    std::vector<Buffer> fresh;
+    if (!Allocate(choice, w, h, &fresh)) {
+        PresenterLog("WaylandDmabufRing: reallocation failed — keeping the current ring");
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(ctx_->queue_mutex);
+        vkQueueWaitIdle(ctx_->queue);
+    }
+    DestroyBuffers(&buffers_);
+    buffers_ = std::move(fresh);
+}
+
+
+bool WaylandDmabufRing::HasFreeBuffer() const
+{
+    return std::any_of(buffers_.begin(), buffers_.end(),
+                       [](const Buffer& b) { return !b.held && !b.failed; });
+}
+
+
+bool WaylandDmabufRing::AcquireNext(IVkPresenter::FrameTarget* out, VkSemaphore signal_sem)
+{
+    if (realloc_pending_)
+        Reallocate();
+
+    const uint32_t n = static_cast<uint32_t>(buffers_.size());
+    int chosen = -1;
+    for (uint32_t t = 0; t < n; ++t) {
+        const uint32_t i = (next_ + t) % n;
+        if (!buffers_[i].held && !buffers_[i].failed) { chosen = static_cast<int>(i); break; }
+    }
+    if (chosen < 0)
+        return false;
+    next_ = (static_cast<uint32_t>(chosen) + 1) % n;
+    Buffer& b = buffers_[chosen];
+
+    if (b.in_flight) {
+        vkWaitForFences(ctx_->device, 1, &b.fence, VK_TRUE, UINT64_MAX);
+        b.in_flight = false;
+    }
+    // Nothing to wait for on the GPU side, but the renderer's submit waits
+    // on the semaphore, so it still needs a queue signal.
+    VkSubmitInfo sig{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+    sig.signalSemaphoreCount = 1;
+    sig.pSignalSemaphores = &signal_sem;
+    {
+        std::lock_guard<std::mutex> lock(ctx_->queue_mutex);
+        if (vkQueueSubmit(ctx_->queue, 1, &sig, VK_NULL_HANDLE) != VK_SUCCESS)
+            return false;
+    }
+
+    out->image = b.image;
+    out->view = b.view;
+    out->framebuffer = b.framebuffer;
+    out->index = static_cast<uint32_t>(chosen);
+    return true;
+}
+
+
+wl_buffer* WaylandDmabufRing::Submit(uint32_t index, VkSemaphore wait_sem)
+{
+    if (index >= buffers_.size())
+        return nullptr;
+    Buffer& b = buffers_[index];
+
+    vkResetFences(ctx_->device, 1, &b.fence);
+    vkResetCommandBuffer(b.cmd, 0);
+    VkCommandBufferBeginInfo begin{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(b.cmd, &begin);
+    VkImageMemoryBarrier release{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+    release.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    release.dstAccessMask = 0;
+    release.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    release.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    release.srcQueueFamilyIndex = ctx_->queue_family;
+    release.dstQueueFamilyIndex = VK_QUEUE_FAMILY_EXTERNAL;
+    release.image = b.image;
+    release.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    vkCmdPipelineBarrier(b.cmd, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                         VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr,
+                         1, &release);
+    vkEndCommandBuffer(b.cmd);
+
+    const bool export_sync = sync_file_import_ && b.sync_sem != VK_NULL_HANDLE;
+    VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    VkSubmitInfo submit{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+    submit.waitSemaphoreCount = 1;
+    submit.pWaitSemaphores = &wait_sem;
+    submit.pWaitDstStageMask = &wait_stage;
+    submit.commandBufferCount = 1;
+    submit.pCommandBuffers = &b.cmd;
+    submit.signalSemaphoreCount = export_sync ? 1u : 0u;
+    submit.pSignalSemaphores = &b.sync_sem;
+    {
+        std::lock_guard<std::mutex> lock(ctx_->queue_mutex);
+        if (vk::LogIfFailed(vkQueueSubmit(ctx_->queue, 1, &submit, b.fence),
+                            "dmabuf ring vkQueueSubmit") != VK_SUCCESS)
+            return nullptr;
+    }
+    b.in_flight = true;
+
+    bool fenced = false;
+    if (export_sync) {
+        // Exporting a SYNC_FD resets the semaphore, so it is ready for reuse.
+        VkSemaphoreGetFdInfoKHR gfi{VK_STRUCTURE_TYPE_SEMAPHORE_GET_FD_INFO_KHR};
+        gfi.semaphore = b.sync_sem;
+        gfi.handleType = VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_SYNC_FD_BIT;
+        int sync_fd = -1;
+        if (get_semaphore_fd_(ctx_->device, &gfi, &sync_fd) == VK_SUCCESS) {
+            dma_buf_import_sync_file import{};
+            import.flags = DMA_BUF_SYNC_WRITE;
+            import.fd = sync_fd;
+            fenced = ioctl(b.dmabuf_fd, DMA_BUF_IOCTL_IMPORT_SYNC_FILE, &import) == 0;
+            // -1 means already signaled; nothing to attach then.
+            fenced = fenced || sync_fd < 0;
+            if (sync_fd >= 0) close(sync_fd);
+        }
+        if (!fenced) {
+            PresenterLog("WaylandDmabufRing: sync_file import unsupported — waiting on the CPU");
+            sync_file_import_ = false;
+        }
+    }
+    if (!fenced) {
+        vkWaitForFences(ctx_->device, 1, &b.fence, VK_TRUE, UINT64_MAX);
+        b.in_flight = false;
+    }
+
+    b.held = true;
+    return b.wl;
+}
+
+
+void WaylandDmabufRing::OnFormatTable(int32_t fd, uint32_t size)
+{
+    table_.clear();
+    void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED) {
+        const auto* entries = static_cast<const TableEntry*>(map);
+        table_.assign(entries, entries + size / sizeof(TableEntry));
+        munmap(map, size);
+    }
+    close(fd);
+}
+
+
+void WaylandDmabufRing::OnMainDevice(wl_array* device)
+{
+    main_device_ = DeviceFromArray(device);
+}
+
+
+void WaylandDmabufRing::OnTrancheTargetDevice(wl_array* device)
+{
+    building_.target = DeviceFromArray(device);
+}
+
+
+void WaylandDmabufRing::OnTrancheFormats(wl_array* indices)
+{
+    const auto* idx = static_cast<const uint16_t*>(indices->data);
+    building_.indices.insert(building_.indices.end(), idx,
+                             idx + indices->size / sizeof(uint16_t));
+}
+
+
+void WaylandDmabufRing::OnTrancheFlags(uint32_t flags)
+{
+    building_.flags = flags;
+}
+
+
+void WaylandDmabufRing::OnTrancheDone()
+{
+    pending_tranches_.push_back(std::move(building_));
+    building_ = Tranche{};
+}
+
+
+void WaylandDmabufRing::OnFeedbackDone()
+{
+    tranches_ = std::move(pending_tranches_);
+    pending_tranches_.clear();
+    feedback_received_ = true;
+    // Before Init allocates there is nothing to re-check.
+    realloc_pending_ = !buffers_.empty();
+}
+
+}  // namespace vrto3d
@@ -0,0 +1,178 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <sys/types.h>
+
+#include <vulkan/vulkan.h>
+
+#include "presenter/vk_presenter.h"
+#include "vk/vk_context.h"
+
+struct wl_array;
+struct wl_buffer;
+struct wl_display;
+struct wl_surface;
+struct zwp_linux_buffer_params_v1;
+struct zwp_linux_dmabuf_feedback_v1;
+struct zwp_linux_dmabuf_v1;
+
+namespace vrto3d {
+
+// Zero-copy render targets for WaylandPresenter: a ring of dmabuf-backed
+// images the repack pass draws into directly, wrapped as wl_buffers through
+// zwp_linux_dmabuf_v1 so the compositor can put them on a plane instead of
+// compositing a WSI swapchain image into its own framebuffer first.
+//
+// Format and modifier come from the surface's dmabuf feedback (v4): the
+// first tranche, in the compositor's preference order, holding an
+// XRGB8888/ARGB8888 modifier this Vulkan device can render to and export.
+// Compositors put the scanout tranche first once the surface is eligible
+// for a plane and re-send feedback when that changes; the ring then
+// reallocates on the next AcquireNext (new ring first, so a failed
+// allocation keeps the old one).
+//
+// Sync: Submit() releases the image to the external queue family and, when
+// the kernel supports DMA_BUF_IOCTL_IMPORT_SYNC_FILE, attaches the render
+// fence to the dmabuf so the compositor's implicit sync waits for it.
+// Otherwise it waits for the GPU on the CPU before handing the buffer over.
+//
+// Thread model: the present thread only, like the owning presenter. The
+// presenter reads and dispatches the display's default queue; this class
+// just registers listeners on it.
+class WaylandDmabufRing {
+public:
+    ~WaylandDmabufRing();
+
+    // Requests surface feedback and round-trips until the first set arrives,
+    // then allocates. False when nothing usable was offered (the caller
+    // stays on the WSI swapchain).
+    bool Init(vk::DeviceCtx* ctx, wl_display* display, zwp_linux_dmabuf_v1* dmabuf,
+              wl_surface* surface, uint32_t width, uint32_t height);
+    void Destroy();
+
+    // Configure-driven size change; applied on the next AcquireNext.
+    void SetDesiredExtent(uint32_t width, uint32_t height);
+
+    // True when some buffer is neither held by the compositor nor failed.
+    bool HasFreeBuffer() const;
+
+    // Same contract as IVkPresenter::AcquireNext. Returns false (skip the
+    // frame, semaphore untouched) when every buffer is still held.
+    bool AcquireNext(IVkPresenter::FrameTarget* out, VkSemaphore signal_sem);
+
+    // Finishes image `index` after `wait_sem` and hands it to the
+    // compositor. Returns the wl_buffer to attach, or nullptr.
+    wl_buffer* Submit(uint32_t index, VkSemaphore wait_sem);
+
+    VkRenderPass RenderPass() const { return render_pass_; }
+    VkExtent2D   Extent() const { return extent_; }
+    VkFormat     Format() const { return format_; }
+
+    // --- listener plumbing (public for the C callback trampolines) ---
+    struct Buffer {
+        WaylandDmabufRing*          owner = nullptr;
+        VkImage                     image = VK_NULL_HANDLE;
+        VkDeviceMemory              memory = VK_NULL_HANDLE;
+        VkImageView                 view = VK_NULL_HANDLE;
+        VkFramebuffer               framebuffer = VK_NULL_HANDLE;
+        int                         dmabuf_fd = -1;
+        zwp_linux_buffer_params_v1* params = nullptr;   // until created/failed
+        wl_buffer*                  wl = nullptr;
+        bool                        failed = false;
+        bool                        held = false;       // attached, not yet released
+        VkCommandBuffer             cmd = VK_NULL_HANDLE;  // release barrier
+        VkFence                     fence = VK_NULL_HANDLE;
+        VkSemaphore                 sync_sem = VK_NULL_HANDLE;  // SYNC_FD-exportable
+        bool                        in_flight = false;
+    };
+
+    void OnFormatTable(int32_t fd, uint32_t size);
+    void OnMainDevice(wl_array* device);
+    void OnTrancheTargetDevice(wl_array* device);
+    void OnTrancheFormats(wl_array* indices);
+    void OnTrancheFlags(uint32_t flags);
+    void OnTrancheDone();
+    void OnFeedbackDone();
+
+private:
+    struct TableEntry {
+        uint32_t format;
+        uint32_t pad;
+        uint64_t modifier;
+    };
+    struct Tranche {
+        dev_t                 target = 0;
+        uint32_t              flags = 0;
+        std::vector<uint16_t> indices;
+    };
+    using VkModifier = vk::DrmModifier;
+    // What to allocate: one DRM format and the modifiers (from one tranche)
+    // the driver may pick from.
+    struct Choice {
+        uint32_t                drm_format = 0;
+        std::vector<VkModifier> modifiers;
+        bool                    scanout = false;
+    };
+
+    bool CreateRenderPass();
+    bool Choose(uint32_t width, uint32_t height, Choice* out) const;
+    bool Allocate(const Choice& choice, uint32_t width, uint32_t height,
+                  std::vector<Buffer>* out);
+    void DestroyBuffers(std::vector<Buffer>* buffers);
+    // Re-chooses after a feedback or size change; swaps rings when the
+    // choice differs from the live allocation.
+    void Reallocate();
+
+    vk::DeviceCtx*               ctx_ = nullptr;
+    wl_display*                  display_ = nullptr;
+    zwp_linux_dmabuf_v1*         dmabuf_ = nullptr;
+    zwp_linux_dmabuf_feedback_v1* feedback_ = nullptr;
+
+    VkFormat      format_ = VK_FORMAT_B8G8R8A8_SRGB;
+    VkRenderPass  render_pass_ = VK_NULL_HANDLE;
+    VkCommandPool cmd_pool_ = VK_NULL_HANDLE;
+    VkExtent2D    extent_{};
+    VkExtent2D    desired_extent_{};
+
+    static constexpr int kRing = 4;
+    std::vector<Buffer> buffers_;
+    uint32_t next_ = 0;
+    uint32_t drm_format_ = 0;      // live allocation
+    uint64_t modifier_ = 0;
+    bool     scanout_ = false;
+
+    // Feedback. Events between two `done`s build pending_*; `done`
+    // publishes them and flags a reallocation check.
+    std::vector<TableEntry> table_;
+    std::vector<Tranche>    tranches_;
+    std::vector<Tranche>    pending_tranches_;
+    Tranche                 building_;
+    dev_t                   main_device_ = 0;
+    bool                    feedback_received_ = false;
+    bool                    realloc_pending_ = false;
+
+    bool sync_file_import_ = true;   // cleared on the first ioctl failure
+    PFN_vkGetMemoryFdKHR    get_memory_fd_ = nullptr;
+    PFN_vkGetSemaphoreFdKHR get_semaphore_fd_ = nullptr;
+    PFN_vkGetImageDrmFormatModifierPropertiesEXT get_image_modifier_ = nullptr;
+};
+
+}  // namespace vrto3d
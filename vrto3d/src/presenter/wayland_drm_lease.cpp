@@ -0,0 +1,331 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "presenter/wayland_drm_lease.h"
+
+#include <cstring>
+
+#include <unistd.h>
+
+#include <wayland-client.h>
+
+#include "drm-lease-v1-client-protocol.h"
+#include "presenter/vk_swapchain_util.h"  // PresenterLog
+
+namespace vrto3d {
+
+namespace {
+
+// ---- wl_registry ----
+void RegistryGlobal(void* data, wl_registry* registry, uint32_t name,
+                    const char* interface, uint32_t version)
+{
+    static_cast<WaylandDrmLease*>(data)->OnGlobal(registry, name, interface, version);
+}
+
+void RegistryGlobalRemove(void*, wl_registry*, uint32_t) {}
+
+const wl_registry_listener kRegistryListener = {
+    RegistryGlobal,
+    RegistryGlobalRemove,
+};
+
+// ---- wp_drm_lease_device_v1 ----
+void DeviceDrmFd(void* data, wp_drm_lease_device_v1* device, int32_t fd)
+{
+    static_cast<WaylandDrmLease*>(data)->OnDeviceFd(device, fd);
+}
+
+void DeviceConnector(void* data, wp_drm_lease_device_v1* device, wp_drm_lease_connector_v1* id)
+{
+    static_cast<WaylandDrmLease*>(data)->OnConnector(device, id);
+}
+
+void DeviceDone(void*, wp_drm_lease_device_v1*) {}
+void DeviceReleased(void*, wp_drm_lease_device_v1*) {}
+
+const wp_drm_lease_device_v1_listener kDeviceListener = {
+    DeviceDrmFd,
+    DeviceConnector,
+    DeviceDone,
+    DeviceReleased,
+};
+
+// ---- wp_drm_lease_connector_v1 ----
+void ConnectorName(void* data, wp_drm_lease_connector_v1* connector, const char* name)
+{
+    static_cast<WaylandDrmLease*>(data)->OnConnectorName(connector, name);
+}
+
+void ConnectorDescription(void*, wp_drm_lease_connector_v1*, const char*) {}
+
+void ConnectorId(void* data, wp_drm_lease_connector_v1* connector, uint32_t id)
+{
+    static_cast<WaylandDrmLease*>(data)->OnConnectorId(connector, id);
+}
+
+void ConnectorDone(void*, wp_drm_lease_connector_v1*) {}
+
+void ConnectorWithdrawn(void* data, wp_drm_lease_connector_v1* connector)
+{
+    static_cast<WaylandDrmLease*>(data)->OnConnectorWithdrawn(connector);
+}
+
+const wp_drm_lease_connector_v1_listener kConnectorListener = {
+    ConnectorName,
+    ConnectorDescription,
+    ConnectorId,
+    ConnectorDone,
+    ConnectorWithdrawn,
+};
+
+// ---- wp_drm_lease_v1 ----
+void LeaseFd(void* data, wp_drm_lease_v1*, int32_t fd)
+{
+    static_cast<WaylandDrmLease*>(data)->OnLeaseFd(fd);
+}
+
+void LeaseFinished(void* data, wp_drm_lease_v1*)
+{
+    static_cast<WaylandDrmLease*>(data)->OnLeaseFinished();
+}
+
+const wp_drm_lease_v1_listener kLeaseListener = {
+    LeaseFd,
+    LeaseFinished,
+};
+
+}  // namespace
+
+
+WaylandDrmLease::~WaylandDrmLease()
+{
+    Release();
+}
+
+
+void WaylandDrmLease::OnGlobal(wl_registry* registry, uint32_t name,
+                               const char* interface, uint32_t version)
+{
+    if (std::strcmp(interface, wp_drm_lease_device_v1_interface.name) == 0) {
+        auto* device = static_cast<wp_drm_lease_device_v1*>(
+            wl_registry_bind(registry, name, &wp_drm_lease_device_v1_interface, 1));
+        wp_drm_lease_device_v1_add_listener(device, &kDeviceListener, this);
+        devices_.push_back(device);
+    }
+}
+
+
+void WaylandDrmLease::OnDeviceFd(wp_drm_lease_device_v1*, int32_t fd)
+{
+    // A non-master fd for enumeration only; the connector ids we need
+    // arrive with each connector, so nothing keeps it.
+    if (fd >= 0) close(fd);
+}
+
+
+void WaylandDrmLease::OnConnector(wp_drm_lease_device_v1* device, wp_drm_lease_connector_v1* connector)
+{
+    auto c = std::make_unique<Connector>();
+    c->device = device;
+    c->proxy = connector;
+    wp_drm_lease_connector_v1_add_listener(connector, &kConnectorListener, this);
+    connectors_.push_back(std::move(c));
+}
+
+
+WaylandDrmLease::Connector* WaylandDrmLease::FindConnector(wp_drm_lease_connector_v1* proxy)
+{
+    for (auto& c : connectors_)
+        if (c->proxy == proxy) return c.get();
+    return nullptr;
+}
+
+
+void WaylandDrmLease::OnConnectorName(wp_drm_lease_connector_v1* connector, const char* name)
+{
+    if (Connector* c = FindConnector(connector))
+        c->name = name ? name : "";
+}
+
+
+void WaylandDrmLease::OnConnectorId(wp_drm_lease_connector_v1* connector, uint32_t id)
+{
+    if (Connector* c = FindConnector(connector))
+        c->id = id;
+}
+
+
+void WaylandDrmLease::OnConnectorWithdrawn(wp_drm_lease_connector_v1* connector)
+{
+    if (Connector* c = FindConnector(connector))
+        c->withdrawn = true;
+}
+
+
+void WaylandDrmLease::OnLeaseFd(int32_t fd)
+{
+    if (lease_fd_ >= 0) close(lease_fd_);
+    lease_fd_ = fd;
+}
+
+
+void WaylandDrmLease::OnLeaseFinished()
+{
+    if (!finished_)
+        PresenterLog("WaylandDrmLease: lease on '%s' finished by the compositor",
+                     connector_name_.c_str());
+    finished_ = true;
+}
+
+
+bool WaylandDrmLease::Acquire(int32_t display_index)
+{
+    Release();
+
+    display_ = wl_display_connect(nullptr);
+    if (!display_) return false;
+
+    registry_ = wl_display_get_registry(display_);
+    wl_registry_add_listener(registry_, &kRegistryListener, this);
+    // First roundtrip binds the lease devices, the second delivers their
+    // drm_fd / connector / done burst.
+    wl_display_roundtrip(display_);
+    if (devices_.empty()) {
+        PresenterLog("WaylandDrmLease: compositor offers no wp_drm_lease_device_v1");
+        Release();
+        return false;
+    }
+    wl_display_roundtrip(display_);
+
+    std::vector<Connector*> offered;
+    for (auto& c : connectors_)
+        if (!c->withdrawn) offered.push_back(c.get());
+    if (offered.empty()) {
+        PresenterLog("WaylandDrmLease: no leasable connectors (compositors usually only "
+                     "offer outputs flagged non-desktop)");
+        Release();
+        return false;
+    }
+    for (size_t i = 0; i < offered.size(); ++i)
+        PresenterLog("WaylandDrmLease: [%zu] '%s' (connector %u)", i + 1,
+                     offered[i]->name.c_str(), offered[i]->id);
+
+    Connector* chosen = offered.front();
+    if (display_index > 0) {
+        if (static_cast<size_t>(display_index) > offered.size()) {
+            PresenterLog("WaylandDrmLease: display_index=%d out of range", display_index);
+            Release();
+            return false;
+        }
+        chosen = offered[static_cast<size_t>(display_index - 1)];
+    }
+
+    wp_drm_lease_request_v1* request = wp_drm_lease_device_v1_create_lease_request(chosen->device);
+    wp_drm_lease_request_v1_request_connector(request, chosen->proxy);
+    lease_ = wp_drm_lease_request_v1_submit(request);
+    wp_drm_lease_v1_add_listener(lease_, &kLeaseListener, this);
+    connector_id_ = chosen->id;
+    connector_name_ = chosen->name;
+
+    for (int i = 0; i < 4 && lease_fd_ < 0 && !finished_; ++i) {
+        if (wl_display_roundtrip(display_) < 0) break;
+    }
+    if (lease_fd_ < 0) {
+        PresenterLog("WaylandDrmLease: compositor refused the lease on '%s'", connector_name_.c_str());
+        Release();
+        return false;
+    }
+
+    PresenterLog("WaylandDrmLease: leased '%s' (connector %u)", connector_name_.c_str(), connector_id_);
+    return true;
+}
+
+
+void WaylandDrmLease::Release()
+{
+    if (read_prepared_) {
+        wl_display_cancel_read(display_);
+        read_prepared_ = false;
+    }
+    if (lease_) {
+        wp_drm_lease_v1_destroy(lease_);
+        lease_ = nullptr;
+    }
+    if (lease_fd_ >= 0) {
+        close(lease_fd_);
+        lease_fd_ = -1;
+    }
+    for (auto& c : connectors_)
+        wp_drm_lease_connector_v1_destroy(c->proxy);
+    connectors_.clear();
+    for (wp_drm_lease_device_v1* device : devices_) {
+        wp_drm_lease_device_v1_release(device);
+        wp_drm_lease_device_v1_destroy(device);
+    }
+    devices_.clear();
+    if (registry_) {
+        wl_registry_destroy(registry_);
+        registry_ = nullptr;
+    }
+    if (display_) {
+        wl_display_flush(display_);
+        wl_display_disconnect(display_);
+        display_ = nullptr;
+    }
+    connector_id_ = 0;
+    connector_name_.clear();
+    finished_ = false;
+}
+
+
+int WaylandDrmLease::EventFd() const
+{
+    return display_ ? wl_display_get_fd(display_) : -1;
+}
+
+
+bool WaylandDrmLease::PrepareEventWait()
+{
+    if (!display_) return true;
+    if (wl_display_prepare_read(display_) != 0) return false;
+    read_prepared_ = true;
+    wl_display_flush(display_);
+    return true;
+}
+
+
+void WaylandDrmLease::FinishEventWait(bool readable)
+{
+    if (!read_prepared_) return;
+    read_prepared_ = false;
+    if (readable)
+        wl_display_read_events(display_);
+    else
+        wl_display_cancel_read(display_);
+}
+
+
+void WaylandDrmLease::Dispatch()
+{
+    if (!display_) return;
+    wl_display_dispatch_pending(display_);
+    wl_display_flush(display_);
+    if (wl_display_get_error(display_) != 0)
+        finished_ = true;
+}
+
+}  // namespace vrto3d
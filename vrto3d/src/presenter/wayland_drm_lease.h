@@ -0,0 +1,98 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct wl_display;
+struct wl_registry;
+struct wp_drm_lease_connector_v1;
+struct wp_drm_lease_device_v1;
+struct wp_drm_lease_v1;
+
+namespace vrto3d {
+
+// Client side of wp_drm_lease_device_v1: asks the running Wayland compositor
+// to hand over one of its connectors (typically one it flags non-desktop)
+// together with a DRM fd scoped to that connector. DrmDisplayPresenter then
+// drives the connector directly through VK_EXT_acquire_drm_display.
+//
+// The Wayland connection stays open for the lifetime of the lease: closing it
+// revokes the lease, and the compositor reports a revocation (hotplug, VT
+// switch) through the `finished` event, which Finished() surfaces.
+class WaylandDrmLease {
+public:
+    WaylandDrmLease() = default;
+    ~WaylandDrmLease();
+    WaylandDrmLease(const WaylandDrmLease&) = delete;
+    WaylandDrmLease& operator=(const WaylandDrmLease&) = delete;
+
+    // Connects to WAYLAND_DISPLAY and leases the connector selected by
+    // display_index (1-based across all lease devices; 0 = the first one
+    // offered). False when the compositor offers no lease device/connector
+    // or rejects the request.
+    bool Acquire(int32_t display_index);
+    void Release();
+
+    int         LeaseFd() const { return lease_fd_; }       // owned, closed by Release()
+    uint32_t    ConnectorId() const { return connector_id_; }
+    const std::string& ConnectorName() const { return connector_name_; }
+    bool        Finished() const { return finished_; }
+
+    // Same event-loop contract as IVkPresenter (see vk_presenter.h).
+    int  EventFd() const;
+    bool PrepareEventWait();
+    void FinishEventWait(bool readable);
+    void Dispatch();
+
+    // Listener entry points (C trampolines in the .cpp).
+    void OnGlobal(wl_registry* registry, uint32_t name, const char* interface, uint32_t version);
+    void OnDeviceFd(wp_drm_lease_device_v1* device, int32_t fd);
+    void OnConnector(wp_drm_lease_device_v1* device, wp_drm_lease_connector_v1* connector);
+    void OnConnectorName(wp_drm_lease_connector_v1* connector, const char* name);
+    void OnConnectorId(wp_drm_lease_connector_v1* connector, uint32_t id);
+    void OnConnectorWithdrawn(wp_drm_lease_connector_v1* connector);
+    void OnLeaseFd(int32_t fd);
+    void OnLeaseFinished();
+
+private:
+    struct Connector {
+        wp_drm_lease_device_v1*    device = nullptr;
+        wp_drm_lease_connector_v1* proxy = nullptr;
+        std::string                name;
+        uint32_t                   id = 0;
+        bool                       withdrawn = false;
+    };
+    Connector* FindConnector(wp_drm_lease_connector_v1* proxy);
+
+    wl_display*  display_ = nullptr;
+    wl_registry* registry_ = nullptr;
+    std::vector<wp_drm_lease_device_v1*> devices_;
+    std::vector<std::unique_ptr<Connector>> connectors_;
+    wp_drm_lease_v1* lease_ = nullptr;
+
+    int         lease_fd_ = -1;
+    uint32_t    connector_id_ = 0;
+    std::string connector_name_;
+    bool        finished_ = false;
+    bool        read_prepared_ = false;
+};
+
+}  // namespace vrto3d
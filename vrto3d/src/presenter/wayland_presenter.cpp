@@ -16,10 +16,17 @@
  */
 #include "presenter/wayland_presenter.h"
 
+#include <algorithm>
 #include <cstring>
+#include <ctime>
+
+#include <poll.h>
 
 #include <wayland-client.h>
 
+#include "content-type-v1-client-protocol.h"
+#include "linux-dmabuf-v1-client-protocol.h"
+#include "presentation-time-client-protocol.h"
 #include "xdg-shell-client-protocol.h"
 
 // The canonical wlr-layer-shell XML names get_layer_surface's last argument
@@ -37,6 +44,9 @@
 #include <vulkan/vulkan.h>
 #include <vulkan/vulkan_wayland.h>
 
+#include "driver_settings.h"
+#include "platform.h"
+
 namespace vrto3d {
 
 namespace {
@@ -150,6 +160,18 @@ const zwlr_layer_surface_v1_listener kLayerSurfaceListener = {
     LayerSurfaceClosed,
 };
 
+void SecondaryLayerSurfaceConfigure(void* data, zwlr_layer_surface_v1* /*surface*/,
+                                    uint32_t serial, uint32_t width, uint32_t height)
+{
+    static_cast<WaylandPresenter*>(data)->OnSecondaryLayerConfigure(serial, width, height);
+}
+
+// Closing either eye's surface stops presenting, as for the primary.
+const zwlr_layer_surface_v1_listener kSecondaryLayerSurfaceListener = {
+    SecondaryLayerSurfaceConfigure,
+    LayerSurfaceClosed,
+};
+
 void XdgSurfaceConfigure(void* data, xdg_surface* /*surface*/, uint32_t serial)
 {
     static_cast<WaylandPresenter*>(data)->OnXdgSurfaceConfigure(serial);
@@ -187,6 +209,81 @@ const xdg_toplevel_listener kXdgToplevelListener = {
     XdgToplevelWmCapabilities,
 };
 
+void PresentationClockId(void* data, wp_presentation* /*presentation*/, uint32_t clk_id)
+{
+    static_cast<WaylandPresenter*>(data)->OnPresentationClock(clk_id);
+}
+
+const wp_presentation_listener kPresentationListener = {
+    PresentationClockId,
+};
+
+// The presented flags are passed through as IVkPresenter::PresentFlags.
+static_assert(WP_PRESENTATION_FEEDBACK_KIND_VSYNC == IVkPresenter::kPresentVsync, "");
+static_assert(WP_PRESENTATION_FEEDBACK_KIND_HW_CLOCK == IVkPresenter::kPresentHwClock, "");
+static_assert(WP_PRESENTATION_FEEDBACK_KIND_HW_COMPLETION == IVkPresenter::kPresentHwCompletion, "");
+static_assert(WP_PRESENTATION_FEEDBACK_KIND_ZERO_COPY == IVkPresenter::kPresentZeroCopy, "");
+
+void FeedbackSyncOutput(void* /*data*/, wp_presentation_feedback* /*feedback*/,
+                        wl_output* /*output*/)
+{
+}
+
+void FeedbackPresented(void* data, wp_presentation_feedback* /*feedback*/,
+                       uint32_t tv_sec_hi, uint32_t tv_sec_lo, uint32_t tv_nsec,
+                       uint32_t refresh, uint32_t seq_hi, uint32_t seq_lo, uint32_t flags)
+{
+    auto* rec = static_cast<WaylandPresenter::FeedbackRecord*>(data);
+    const uint64_t sec = (static_cast<uint64_t>(tv_sec_hi) << 32) | tv_sec_lo;
+    rec->timing.presented_time = rec->owner->ToMonotonic(sec, tv_nsec);
+    rec->timing.refresh_period = static_cast<double>(refresh) * 1e-9;
+    rec->timing.msc = (static_cast<uint64_t>(seq_hi) << 32) | seq_lo;
+    rec->timing.flags = flags;
+    rec->owner->OnFeedbackDone(rec);
+}
+
+void FeedbackDiscarded(void* data, wp_presentation_feedback* /*feedback*/)
+{
+    auto* rec = static_cast<WaylandPresenter::FeedbackRecord*>(data);
+    rec->timing.discarded = true;
+    rec->owner->OnFeedbackDone(rec);
+}
+
+const wp_presentation_feedback_listener kFeedbackListener = {
+    FeedbackSyncOutput,
+    FeedbackPresented,
+    FeedbackDiscarded,
+};
+
+void FrameDone(void* data, wl_callback* /*callback*/, uint32_t /*time_ms*/)
+{
+    static_cast<WaylandPresenter*>(data)->OnFrameDone();
+}
+
+const wl_callback_listener kFrameListener = {
+    FrameDone,
+};
+
+double ClockSeconds(clockid_t clock)
+{
+    timespec ts{};
+    clock_gettime(clock, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9;
+}
+
+// Feedback objects outstanding at once. The compositor answers each one
+// within a refresh or two; more than this means it stopped answering
+// (e.g. surface hidden), and the oldest are dropped.
+constexpr size_t kMaxFeedbackInflight = 16;
+// Completed timings kept for PopPresentTiming.
+constexpr size_t kMaxTimingsQueued = 64;
+
+// Dmabuf path waits. A frame callback normally arrives within a refresh;
+// hidden surfaces may get none, so the wait gives up and commits anyway.
+// Buffers come back once the compositor latches a newer one.
+constexpr int kFrameCallbackTimeoutMs = 100;
+constexpr int kBufferReleaseTimeoutMs = 100;
+
 }  // namespace
 
 
@@ -212,6 +309,21 @@ void WaylandPresenter::OnGlobal(wl_registry* registry, uint32_t name,
         uint32_t v = version < 4 ? version : 4;
         layer_shell_ = static_cast<zwlr_layer_shell_v1*>(
             wl_registry_bind(registry, name, &zwlr_layer_shell_v1_interface, v));
+    } else if (std::strcmp(interface, wp_presentation_interface.name) == 0) {
+        presentation_ = static_cast<wp_presentation*>(
+            wl_registry_bind(registry, name, &wp_presentation_interface, 1));
+        wp_presentation_add_listener(presentation_, &kPresentationListener, this);
+    } else if (std::strcmp(interface, zwp_linux_dmabuf_v1_interface.name) == 0 && version >= 4) {
+        // v4 for per-surface feedback; older versions can't tell us what scans out.
+        linux_dmabuf_ = static_cast<zwp_linux_dmabuf_v1*>(
+            wl_registry_bind(registry, name, &zwp_linux_dmabuf_v1_interface, 4));
+    } else if (std::strcmp(interface, wp_content_type_manager_v1_interface.name) == 0) {
+        content_type_manager_ = static_cast<wp_content_type_manager_v1*>(
+            wl_registry_bind(registry, name, &wp_content_type_manager_v1_interface, 1));
+    } else if (std::strcmp(interface, "wp_fifo_manager_v1") == 0) {
+        has_fifo_v1_ = true;
+    } else if (std::strcmp(interface, "wp_commit_timing_manager_v1") == 0) {
+        has_commit_timing_v1_ = true;
     } else if (std::strcmp(interface, wl_output_interface.name) == 0) {
         uint32_t v = version < 4 ? version : 4;
         OutputInfo info;
@@ -241,7 +353,7 @@ void WaylandPresenter::OnLayerConfigure(uint32_t serial, uint32_t width, uint32_
     zwlr_layer_surface_v1_ack_configure(layer_surface_, serial);
     if (width != 0 && height != 0) {
         if (configured_ && (width != surf_width_ || height != surf_height_)) {
-            swapchain_.SetDesiredExtent(width, height);
+            ApplyConfigureSize(width, height);
         }
         surf_width_ = width;
         surf_height_ = height;
@@ -250,6 +362,20 @@ void WaylandPresenter::OnLayerConfigure(uint32_t serial, uint32_t width, uint32_
 }
 
 
+void WaylandPresenter::OnSecondaryLayerConfigure(uint32_t serial, uint32_t width, uint32_t height)
+{
+    zwlr_layer_surface_v1_ack_configure(secondary_layer_surface_, serial);
+    if (width != 0 && height != 0) {
+        if (secondary_configured_ && (width != surf2_width_ || height != surf2_height_)) {
+            secondary_.SetDesiredExtent(width, height);
+        }
+        surf2_width_ = width;
+        surf2_height_ = height;
+    }
+    secondary_configured_ = true;
+}
+
+
 void WaylandPresenter::OnLayerClosed()
 {
     closed_ = true;
@@ -271,7 +397,7 @@ void WaylandPresenter::OnXdgSurfaceConfigure(uint32_t serial)
         const uint32_t w = static_cast<uint32_t>(pending_xdg_w_);
         const uint32_t h = static_cast<uint32_t>(pending_xdg_h_);
         if (configured_ && (w != surf_width_ || h != surf_height_)) {
-            swapchain_.SetDesiredExtent(w, h);
+            ApplyConfigureSize(w, h);
         }
         surf_width_ = w;
         surf_height_ = h;
@@ -286,6 +412,15 @@ void WaylandPresenter::OnXdgToplevelClose()
 }
 
 
+void WaylandPresenter::ApplyConfigureSize(uint32_t width, uint32_t height)
+{
+    if (dmabuf_ring_)
+        dmabuf_ring_->SetDesiredExtent(width, height);
+    else
+        swapchain_.SetDesiredExtent(width, height);
+}
+
+
 bool WaylandPresenter::ConnectAndBind()
 {
     display_ = wl_display_connect(nullptr);
@@ -336,21 +471,126 @@ bool WaylandPresenter::CreateLayerSurface(wl_output* output)
     zwlr_layer_surface_v1_set_exclusive_zone(layer_surface_, -1);
     zwlr_layer_surface_v1_set_keyboard_interactivity(
         layer_surface_, ZWLR_LAYER_SURFACE_V1_KEYBOARD_INTERACTIVITY_NONE);
-    SetSurfaceInputRegion(false);  // click-through by default (menu closed)
+    SetSurfaceInputRegion(surface_, false);  // click-through by default (menu closed)
     wl_surface_commit(surface_);
     return WaitForConfigure();
 }
 
-void WaylandPresenter::SetSurfaceInputRegion(bool capture)
+
+const WaylandPresenter::OutputInfo* WaylandPresenter::FindRightEyeOutput(const OutputInfo& left) const
 {
-    if (!surface_) return;
+    // platform enumerates on its own connection (XRandR when DISPLAY is set,
+    // so also under XWayland) with the primary moved first. Find our output
+    // in that list by name, else by geometry, and resolve its neighbor from
+    // there so both sides agree on which monitor is the left eye's.
+    auto same = [](const OutputInfo& o, const platform::MonitorInfo& m) {
+        const std::string& name = !o.name.empty() ? o.name : o.model;
+        if (!name.empty() && name == m.device_name) return true;
+        return o.x == m.x && o.y == m.y && o.width > 0 && o.height > 0
+            && static_cast<uint32_t>(o.width) == m.width
+            && static_cast<uint32_t>(o.height) == m.height;
+    };
+    const std::vector<platform::MonitorInfo> monitors = platform::EnumerateMonitors();
+    auto it = std::find_if(monitors.begin(), monitors.end(),
+                           [&](const platform::MonitorInfo& m) { return same(left, m); });
+    platform::MonitorInfo primary, secondary;
+    if (it == monitors.end()
+        || !platform::ResolveTargetMonitors(it->index, true, primary, secondary)
+        || secondary.width == 0) {
+        return nullptr;
+    }
+    for (const auto& o : outputs_) {
+        if (&o != &left && same(o, secondary)) return &o;
+    }
+    return nullptr;
+}
+
+
+bool WaylandPresenter::CreateSecondaryOutput(wl_output* output)
+{
+    secondary_surface_ = wl_compositor_create_surface(compositor_);
+    if (!secondary_surface_) return false;
+    secondary_layer_surface_ = zwlr_layer_shell_v1_get_layer_surface(
+        layer_shell_, secondary_surface_, output, ZWLR_LAYER_SHELL_V1_LAYER_OVERLAY, "vrto3d");
+    if (!secondary_layer_surface_) return false;
+    zwlr_layer_surface_v1_add_listener(secondary_layer_surface_,
+                                       &kSecondaryLayerSurfaceListener, this);
+    zwlr_layer_surface_v1_set_anchor(secondary_layer_surface_,
+                                     ZWLR_LAYER_SURFACE_V1_ANCHOR_TOP
+                                     | ZWLR_LAYER_SURFACE_V1_ANCHOR_BOTTOM
+                                     | ZWLR_LAYER_SURFACE_V1_ANCHOR_LEFT
+                                     | ZWLR_LAYER_SURFACE_V1_ANCHOR_RIGHT);
+    zwlr_layer_surface_v1_set_exclusive_zone(secondary_layer_surface_, -1);
+    zwlr_layer_surface_v1_set_keyboard_interactivity(
+        secondary_layer_surface_, ZWLR_LAYER_SURFACE_V1_KEYBOARD_INTERACTIVITY_NONE);
+    SetSurfaceInputRegion(secondary_surface_, false);
+    wl_surface_commit(secondary_surface_);
+
+    for (int i = 0; i < 100 && !secondary_configured_ && !closed_; ++i) {
+        if (wl_display_roundtrip(display_) < 0) return false;
+    }
+    if (!secondary_configured_ || closed_) {
+        PresenterLog("WaylandPresenter: right eye surface never configured");
+        return false;
+    }
+
+    VkWaylandSurfaceCreateInfoKHR sci{ VK_STRUCTURE_TYPE_WAYLAND_SURFACE_CREATE_INFO_KHR };
+    sci.display = display_;
+    sci.surface = secondary_surface_;
+    VkResult r = vkCreateWaylandSurfaceKHR(ctx_->instance, &sci, nullptr, &vk_surface2_);
+    if (r != VK_SUCCESS) {
+        PresenterLog("WaylandPresenter: vkCreateWaylandSurfaceKHR (right eye) failed (r=%d)",
+                     static_cast<int>(r));
+        return false;
+    }
+    // Both swapchains render through the primary's render pass.
+    if (!secondary_.Create(ctx_, vk_surface2_, surf2_width_, surf2_height_)
+        || secondary_.format != swapchain_.format) {
+        PresenterLog("WaylandPresenter: right eye swapchain unusable (format %d vs %d)",
+                     static_cast<int>(secondary_.format), static_cast<int>(swapchain_.format));
+        return false;
+    }
+    return true;
+}
+
+
+void WaylandPresenter::DestroySecondaryOutput()
+{
+    if (secondary_.ctx) {
+        secondary_.Destroy();
+    }
+    if (vk_surface2_ != VK_NULL_HANDLE && ctx_ && ctx_->instance != VK_NULL_HANDLE) {
+        vkDestroySurfaceKHR(ctx_->instance, vk_surface2_, nullptr);
+    }
+    vk_surface2_ = VK_NULL_HANDLE;
+    if (secondary_content_type_) {
+        wp_content_type_v1_destroy(secondary_content_type_);
+        secondary_content_type_ = nullptr;
+    }
+    if (secondary_layer_surface_) {
+        zwlr_layer_surface_v1_destroy(secondary_layer_surface_);
+        secondary_layer_surface_ = nullptr;
+    }
+    if (secondary_surface_) {
+        wl_surface_destroy(secondary_surface_);
+        secondary_surface_ = nullptr;
+    }
+    secondary_configured_ = false;
+    surf2_width_ = 0;
+    surf2_height_ = 0;
+}
+
+
+void WaylandPresenter::SetSurfaceInputRegion(wl_surface* surface, bool capture)
+{
+    if (!surface) return;
     if (capture) {
         // null region = whole surface receives pointer input (game shielded).
-        wl_surface_set_input_region(surface_, nullptr);
+        wl_surface_set_input_region(surface, nullptr);
     } else {
         // empty region = input-transparent; pointer falls through to the game.
         wl_region* region = wl_compositor_create_region(compositor_);
-        wl_surface_set_input_region(surface_, region);
+        wl_surface_set_input_region(surface, region);
         wl_region_destroy(region);
     }
 }
@@ -360,19 +600,49 @@ void WaylandPresenter::SetAlwaysOnTop(bool on_top)
     // Layer-shell (v2+): drop to the BACKGROUND layer to reveal the flat game
     // (a normal xdg_toplevel sits above background), OVERLAY to restore. Surface
     // stays mapped/presentable — we keep rendering behind it.
+    const uint32_t layer = on_top ? ZWLR_LAYER_SHELL_V1_LAYER_OVERLAY
+                                  : ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND;
     if (layer_surface_) {
-        zwlr_layer_surface_v1_set_layer(
-            layer_surface_,
-            on_top ? ZWLR_LAYER_SHELL_V1_LAYER_OVERLAY : ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND);
+        zwlr_layer_surface_v1_set_layer(layer_surface_, layer);
         wl_surface_commit(surface_);
     }
+    if (secondary_layer_surface_) {
+        zwlr_layer_surface_v1_set_layer(secondary_layer_surface_, layer);
+        wl_surface_commit(secondary_surface_);
+    }
     // xdg_toplevel fallback (GNOME): z-order is compositor policy; the peek
     // toggle is a no-op there (documented).
 }
 
+bool WaylandPresenter::SetVariableRefresh(bool enable)
+{
+    // No Wayland protocol turns VRR on directly; KWin (and others with an
+    // "automatic" adaptive-sync policy) enable it for fullscreen/overlay
+    // surfaces that declare game content.
+    if (!content_type_manager_ || !surface_) return false;
+    const uint32_t type = enable ? WP_CONTENT_TYPE_V1_TYPE_GAME : WP_CONTENT_TYPE_V1_TYPE_NONE;
+    if (!content_type_)
+        content_type_ = wp_content_type_manager_v1_get_surface_content_type(content_type_manager_, surface_);
+    wp_content_type_v1_set_content_type(content_type_, type);
+    wl_surface_commit(surface_);
+    if (secondary_surface_) {
+        if (!secondary_content_type_)
+            secondary_content_type_ = wp_content_type_manager_v1_get_surface_content_type(
+                content_type_manager_, secondary_surface_);
+        wp_content_type_v1_set_content_type(secondary_content_type_, type);
+        wl_surface_commit(secondary_surface_);
+    }
+    wl_display_flush(display_);
+    return true;
+}
+
 void WaylandPresenter::SetInputCapture(bool capture)
 {
-    SetSurfaceInputRegion(capture);
+    SetSurfaceInputRegion(surface_, capture);
+    if (secondary_surface_) {
+        SetSurfaceInputRegion(secondary_surface_, capture);
+        wl_surface_commit(secondary_surface_);
+    }
     if (layer_surface_) {
         // Take keyboard while the OSD is open so text entry doesn't leak into
         // the game; release (NONE) otherwise so the game keeps keys.
@@ -443,11 +713,8 @@ bool WaylandPresenter::Init(vrto3d::vk::DeviceCtx* ctx, const StereoDisplayDrive
                  out.width, out.height, out.refresh_mhz / 1000.0,
                  cfg.display_index);
 
-    if (cfg.output_mode == OutputMode::DualDisplay
-        || cfg.output_mode == OutputMode::DualDisplayFlip) {
-        PresenterLog("WaylandPresenter: DualDisplay spanning is not possible on Wayland "
-                     "(one surface per output) — rendering SbS on the chosen output only");
-    }
+    const bool dual = cfg.output_mode == OutputMode::DualDisplay
+                      || cfg.output_mode == OutputMode::DualDisplayFlip;
 
     surface_ = wl_compositor_create_surface(compositor_);
     if (!surface_) {
@@ -487,6 +754,33 @@ bool WaylandPresenter::Init(vrto3d::vk::DeviceCtx* ctx, const StereoDisplayDrive
         surf_height_ = out.height > 0 ? static_cast<uint32_t>(out.height) : 1080u;
     }
 
+    // DualDisplay: no surface can span two outputs, so the right eye gets an
+    // overlay surface of its own on the neighbor output. Both swapchains go
+    // out in one vkQueuePresentKHR, which rules out the dmabuf ring here.
+    wl_output* right_output = nullptr;
+    if (dual) {
+        const OutputInfo* right = layer_surface_ ? FindRightEyeOutput(out) : nullptr;
+        if (right) {
+            right_output = right->output;
+            PresenterLog("WaylandPresenter: DualDisplay right eye on '%s'",
+                         !right->name.empty() ? right->name.c_str() : right->model.c_str());
+        } else {
+            PresenterLog("WaylandPresenter: DualDisplay without %s — rendering SbS on the "
+                         "chosen output only",
+                         layer_surface_ ? "a matching right neighbor output" : "layer-shell");
+        }
+    }
+
+    if (!right_output && InitDmabufRing()) {
+        wl_display_flush(display_);
+        PresenterLog("WaylandPresenter: up via zwlr_layer_shell_v1 (overlay), %ux%u, "
+                     "dmabuf buffers (no WSI swapchain)",
+                     dmabuf_ring_->Extent().width, dmabuf_ring_->Extent().height);
+        PresenterLog("WaylandPresenter: wp_presentation %s",
+                     presentation_ ? "bound" : "unavailable");
+        return true;
+    }
+
     VkWaylandSurfaceCreateInfoKHR sci{ VK_STRUCTURE_TYPE_WAYLAND_SURFACE_CREATE_INFO_KHR };
     sci.display = display_;
     sci.surface = surface_;
@@ -503,16 +797,71 @@ bool WaylandPresenter::Init(vrto3d::vk::DeviceCtx* ctx, const StereoDisplayDrive
         return false;
     }
 
+    if (right_output && !CreateSecondaryOutput(right_output)) {
+        PresenterLog("WaylandPresenter: right eye output unavailable — left output shows both eyes");
+        DestroySecondaryOutput();
+    }
+
     wl_display_flush(display_);
-    PresenterLog("WaylandPresenter: up via %s, %ux%u",
+    PresenterLog("WaylandPresenter: up via %s, %ux%u%s",
                  layer_surface_ ? "zwlr_layer_shell_v1 (overlay)" : "xdg_toplevel fullscreen",
-                 swapchain_.extent.width, swapchain_.extent.height);
+                 swapchain_.extent.width, swapchain_.extent.height,
+                 secondary_.ctx ? " + right eye swapchain (lockstep present)" : "");
+    PresenterLog("WaylandPresenter: wp_presentation %s, fifo-v1 %s, commit-timing-v1 %s (WSI-owned)",
+                 presentation_ ? "bound" : "unavailable",
+                 has_fifo_v1_ ? "advertised" : "absent",
+                 has_commit_timing_v1_ ? "advertised" : "absent");
+    return true;
+}
+
+
+bool WaylandPresenter::InitDmabufRing()
+{
+    // Only the fullscreen layer surface: an xdg_toplevel's size and plane
+    // eligibility are up to the window manager, and the WSI copes with that.
+    if (!layer_surface_ || !linux_dmabuf_)
+        return false;
+    if (!DriverSettingBool("wayland_dmabuf", true)) {
+        PresenterLog("WaylandPresenter: wayland_dmabuf off — using the WSI swapchain");
+        return false;
+    }
+    auto ring = std::make_unique<WaylandDmabufRing>();
+    if (!ring->Init(ctx_, display_, linux_dmabuf_, surface_, surf_width_, surf_height_)) {
+        PresenterLog("WaylandPresenter: dmabuf path unavailable — using the WSI swapchain");
+        return false;
+    }
+    dmabuf_ring_ = std::move(ring);
     return true;
 }
 
 
 void WaylandPresenter::DestroyNative()
 {
+    if (frame_callback_) {
+        wl_callback_destroy(frame_callback_);
+        frame_callback_ = nullptr;
+    }
+    if (content_type_) {
+        wp_content_type_v1_destroy(content_type_);
+        content_type_ = nullptr;
+    }
+    if (content_type_manager_) {
+        wp_content_type_manager_v1_destroy(content_type_manager_);
+        content_type_manager_ = nullptr;
+    }
+    if (linux_dmabuf_) {
+        zwp_linux_dmabuf_v1_destroy(linux_dmabuf_);
+        linux_dmabuf_ = nullptr;
+    }
+    for (auto& rec : feedback_inflight_) {
+        wp_presentation_feedback_destroy(rec->proxy);
+    }
+    feedback_inflight_.clear();
+    timings_.clear();
+    if (presentation_) {
+        wp_presentation_destroy(presentation_);
+        presentation_ = nullptr;
+    }
     if (layer_surface_) {
         zwlr_layer_surface_v1_destroy(layer_surface_);
         layer_surface_ = nullptr;
@@ -559,6 +908,9 @@ void WaylandPresenter::DestroyNative()
 
 void WaylandPresenter::Shutdown()
 {
+    // The ring's wl_buffers go before the connection does.
+    dmabuf_ring_.reset();
+    DestroySecondaryOutput();
     if (swapchain_.ctx) {
         swapchain_.Destroy();
     }
@@ -569,6 +921,7 @@ void WaylandPresenter::Shutdown()
     DestroyNative();
     configured_ = false;
     closed_ = false;
+    zero_copy_ = false;
     ctx_ = nullptr;
 }
 
@@ -592,7 +945,216 @@ bool WaylandPresenter::PumpEvents()
 }
 
 
-// AcquireNext / Present / RenderPass / Extent / Format inherited from
-// SwapchainPresenterBase (delegate to swapchain_).
+int WaylandPresenter::EventFd() const
+{
+    return display_ ? wl_display_get_fd(display_) : -1;
+}
+
+
+bool WaylandPresenter::PrepareEventWait()
+{
+    if (!display_ || closed_) return false;
+    // Fails while the default queue still holds undispatched events (e.g.
+    // ones the WSI read during the last present): report them as pending so
+    // the caller skips the wait and PumpEvents dispatches them.
+    if (wl_display_prepare_read(display_) != 0) return false;
+    read_prepared_ = true;
+    wl_display_flush(display_);
+    return true;
+}
+
+
+void WaylandPresenter::FinishEventWait(bool readable)
+{
+    if (!read_prepared_) return;
+    read_prepared_ = false;
+    if (readable)
+        wl_display_read_events(display_);
+    else
+        wl_display_cancel_read(display_);
+}
+
+
+void WaylandPresenter::RequestPresentationFeedback()
+{
+    if (!presentation_ || !surface_) return;
+    if (feedback_inflight_.size() >= kMaxFeedbackInflight) {
+        wp_presentation_feedback_destroy(feedback_inflight_.front()->proxy);
+        feedback_inflight_.erase(feedback_inflight_.begin());
+    }
+    auto rec = std::make_unique<FeedbackRecord>();
+    rec->owner = this;
+    rec->timing.frame_id = ++next_frame_id_;
+    rec->timing.submit_time = ClockSeconds(CLOCK_MONOTONIC);
+    rec->proxy = wp_presentation_feedback(presentation_, surface_);
+    wp_presentation_feedback_add_listener(rec->proxy, &kFeedbackListener, rec.get());
+    feedback_inflight_.push_back(std::move(rec));
+}
+
+
+bool WaylandPresenter::WaitForDisplay(const std::function<bool()>& done, int timeout_ms)
+{
+    const double deadline = ClockSeconds(CLOCK_MONOTONIC) + timeout_ms * 1e-3;
+    const int fd = wl_display_get_fd(display_);
+    while (!done()) {
+        while (wl_display_prepare_read(display_) != 0) {
+            if (wl_display_dispatch_pending(display_) < 0) return false;
+        }
+        if (done()) {
+            wl_display_cancel_read(display_);
+            return true;
+        }
+        wl_display_flush(display_);
+        const int left_ms = static_cast<int>((deadline - ClockSeconds(CLOCK_MONOTONIC)) * 1e3);
+        if (left_ms <= 0) {
+            wl_display_cancel_read(display_);
+            return false;
+        }
+        pollfd pfd{fd, POLLIN, 0};
+        if (poll(&pfd, 1, left_ms) > 0 && (pfd.revents & POLLIN)) {
+            if (wl_display_read_events(display_) < 0) return false;
+        } else {
+            wl_display_cancel_read(display_);
+        }
+        if (wl_display_dispatch_pending(display_) < 0) return false;
+    }
+    return true;
+}
+
+
+bool WaylandPresenter::AcquireNext(FrameTarget* out, VkSemaphore signal_sem)
+{
+    if (!dmabuf_ring_)
+        return SwapchainPresenterBase::AcquireNext(out, signal_sem);
+    if (!dmabuf_ring_->HasFreeBuffer())
+        WaitForDisplay([this] { return dmabuf_ring_->HasFreeBuffer() || closed_; },
+                       kBufferReleaseTimeoutMs);
+    return dmabuf_ring_->AcquireNext(out, signal_sem);
+}
+
+
+bool WaylandPresenter::TryAcquireNext(FrameTarget* out, VkSemaphore signal_sem)
+{
+    if (!dmabuf_ring_)
+        return SwapchainPresenterBase::TryAcquireNext(out, signal_sem);
+    return dmabuf_ring_->HasFreeBuffer() && dmabuf_ring_->AcquireNext(out, signal_sem);
+}
+
+
+bool WaylandPresenter::Present(uint32_t image_index, VkSemaphore wait_sem)
+{
+    if (!dmabuf_ring_) {
+        // Feedback is surface state applied by the next wl_surface.commit —
+        // the one the WSI sends inside vkQueuePresentKHR on this thread.
+        RequestPresentationFeedback();
+        return SwapchainPresenterBase::Present(image_index, wait_sem);
+    }
+
+    wl_buffer* buffer = dmabuf_ring_->Submit(image_index, wait_sem);
+    if (!buffer) return false;
+
+    // FIFO: at most one commit per refresh, so don't replace a frame the
+    // compositor hasn't picked up yet.
+    if (frame_callback_ &&
+        !WaitForDisplay([this] { return frame_callback_ == nullptr || closed_; },
+                        kFrameCallbackTimeoutMs)) {
+        wl_callback_destroy(frame_callback_);
+        frame_callback_ = nullptr;
+    }
+    if (closed_) return false;
+
+    RequestPresentationFeedback();
+    frame_callback_ = wl_surface_frame(surface_);
+    wl_callback_add_listener(frame_callback_, &kFrameListener, this);
+    wl_surface_attach(surface_, buffer, 0, 0);
+    if (wl_surface_get_version(surface_) >= WL_SURFACE_DAMAGE_BUFFER_SINCE_VERSION)
+        wl_surface_damage_buffer(surface_, 0, 0, INT32_MAX, INT32_MAX);
+    else
+        wl_surface_damage(surface_, 0, 0, INT32_MAX, INT32_MAX);
+    wl_surface_commit(surface_);
+    wl_display_flush(display_);
+    return true;
+}
+
+
+bool WaylandPresenter::PresentTargets(const FrameTarget* targets, VkSemaphore wait_sem)
+{
+    if (!secondary_.ctx || targets[1].framebuffer == VK_NULL_HANDLE)
+        return Present(targets[0].index, wait_sem);
+    // Feedback rides on the left eye's commit; the WSI commits both surfaces
+    // from the same vkQueuePresentKHR.
+    RequestPresentationFeedback();
+    return SwapchainPresenterBase::PresentTargets(targets, wait_sem);
+}
+
+
+void WaylandPresenter::OnFrameDone()
+{
+    wl_callback_destroy(frame_callback_);
+    frame_callback_ = nullptr;
+}
+
+
+VkRenderPass WaylandPresenter::RenderPass() const
+{
+    return dmabuf_ring_ ? dmabuf_ring_->RenderPass() : swapchain_.render_pass;
+}
+
+
+VkExtent2D WaylandPresenter::Extent() const
+{
+    return dmabuf_ring_ ? dmabuf_ring_->Extent() : swapchain_.extent;
+}
+
+
+VkFormat WaylandPresenter::Format() const
+{
+    return dmabuf_ring_ ? dmabuf_ring_->Format() : swapchain_.format;
+}
+
+
+void WaylandPresenter::OnFeedbackDone(FeedbackRecord* record)
+{
+    if (!record->timing.discarded) {
+        const bool zero_copy = (record->timing.flags & kPresentZeroCopy) != 0;
+        if (zero_copy != zero_copy_) {
+            PresenterLog("WaylandPresenter: %s", zero_copy
+                ? "compositor scans the surface out directly (zero-copy)"
+                : "compositor composites the surface again");
+            zero_copy_ = zero_copy;
+        }
+    }
+    if (timings_.size() >= kMaxTimingsQueued) timings_.pop_front();
+    timings_.push_back(record->timing);
+    // Feedback objects are one-shot; the server already forgot this one.
+    wp_presentation_feedback_destroy(record->proxy);
+    auto it = std::find_if(feedback_inflight_.begin(), feedback_inflight_.end(),
+                           [record](const std::unique_ptr<FeedbackRecord>& r) {
+                               return r.get() == record;
+                           });
+    if (it != feedback_inflight_.end()) feedback_inflight_.erase(it);
+}
+
+
+bool WaylandPresenter::PopPresentTiming(PresentTiming* out)
+{
+    if (timings_.empty()) return false;
+    *out = timings_.front();
+    timings_.pop_front();
+    return true;
+}
+
+
+double WaylandPresenter::ToMonotonic(uint64_t sec, uint32_t nsec) const
+{
+    const double t = static_cast<double>(sec) + static_cast<double>(nsec) * 1e-9;
+    if (presentation_clock_ == CLOCK_MONOTONIC) return t;
+    // Other presentation clocks (CLOCK_MONOTONIC_RAW on some compositors)
+    // run at a slightly different rate; re-anchoring on each event keeps
+    // the error to the rate difference over a frame or two.
+    const auto clock = static_cast<clockid_t>(presentation_clock_);
+    return t - (ClockSeconds(clock) - ClockSeconds(CLOCK_MONOTONIC));
+}
+
 
 }  // namespace vrto3d
@@ -17,11 +17,15 @@
 #pragma once
 
 #include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "presenter/swapchain_presenter_base.h"
 #include "presenter/vk_swapchain_util.h"
+#include "presenter/wayland_dmabuf_ring.h"
 
 // Raw libwayland-client types (from wayland-client-protocol.h and the
 // generated protocol headers) — forward-declared here so the header stays
@@ -31,11 +35,17 @@ struct wl_registry;
 struct wl_compositor;
 struct wl_surface;
 struct wl_output;
+struct wl_callback;
 struct xdg_wm_base;
 struct xdg_surface;
 struct xdg_toplevel;
 struct zwlr_layer_shell_v1;
 struct zwlr_layer_surface_v1;
+struct wp_presentation;
+struct wp_presentation_feedback;
+struct zwp_linux_dmabuf_v1;
+struct wp_content_type_manager_v1;
+struct wp_content_type_v1;
 
 namespace vrto3d {
 
@@ -50,8 +60,31 @@ namespace vrto3d {
 // Event handling: PumpEvents() only does wl_display_dispatch_pending +
 // wl_display_flush — never a blocking dispatch. The Vulkan WSI runs its own
 // wl_event_queue and reads the socket during FIFO presents, which also
-// queues our default-queue events for the next dispatch_pending. Blocking
+// queues our default-queue events for the next dispatch_pending. While the
+// renderer is idle it blocks on the socket between PrepareEventWait
+// (wl_display_prepare_read) and FinishEventWait (read_events/cancel_read),
+// so configure/close events are read the moment they arrive. Blocking
 // roundtrips are confined to Init().
+//
+// Presentation timing: when the compositor offers wp_presentation, every
+// Present() requests a feedback object on surface_ just before the WSI's
+// wl_surface.commit, so it describes exactly that frame. wp_fifo_v1 and
+// wp_commit_timing_v1 are detected but not bound: they allow one object per
+// surface and current Mesa WSI creates its own, so pacing through them is
+// the WSI's (VK_EXT_present_timing) business.
+//
+// Zero-copy path: on a layer-shell surface with zwp_linux_dmabuf_v1 v4, no
+// VkSurfaceKHR is created at all. Frames render straight into a
+// WaylandDmabufRing picked from the surface's dmabuf feedback and are
+// attached with wl_surface.attach/commit, so a compositor that can put the
+// surface on a plane skips its composite copy. Present() then does the FIFO
+// pacing itself: it waits for the previous commit's frame callback before
+// committing, as Mesa's FIFO present does. driver_vrto3d/wayland_dmabuf
+// set to false keeps the WSI swapchain.
+//
+// DualDisplay: with layer-shell and the chosen output's right neighbor
+// bound, the right eye gets a second overlay surface on that output, and
+// both WSI swapchains are presented together (see SwapchainPresenterBase).
 class WaylandPresenter final : public SwapchainPresenterBase {
 public:
     WaylandPresenter() = default;
@@ -61,8 +94,19 @@ public:
     void Shutdown() override;
 
     bool PumpEvents() override;
-    // AcquireNext/Present/RenderPass/Extent/Format inherited from
-    // SwapchainPresenterBase (delegate to swapchain_).
+    int  EventFd() const override;
+    bool PrepareEventWait() override;
+    void FinishEventWait(bool readable) override;
+    bool AcquireNext(FrameTarget* out, VkSemaphore signal_sem) override;
+    bool TryAcquireNext(FrameTarget* out, VkSemaphore signal_sem) override;
+    bool Present(uint32_t image_index, VkSemaphore wait_sem) override;
+    bool PresentTargets(const FrameTarget* targets, VkSemaphore wait_sem) override;
+    bool HasPresentTiming() const override { return presentation_ != nullptr; }
+    bool PopPresentTiming(PresentTiming* out) override;
+    // Swapchain or dmabuf ring, whichever Init settled on.
+    VkRenderPass RenderPass() const override;
+    VkExtent2D   Extent() const override;
+    VkFormat     Format() const override;
     const char*  Name() const override { return "WaylandPresenter"; }
 
     // Layer-shell overlay surfaces are inherently topmost; xdg fullscreen
@@ -72,6 +116,7 @@ public:
     void ReleaseTopmost() override {}
     void SetAlwaysOnTop(bool on_top) override;
     void SetInputCapture(bool capture) override;
+    bool SetVariableRefresh(bool enable) override;
 
     // --- listener plumbing (public for the C callback trampolines) ---
     struct OutputInfo {
@@ -91,11 +136,22 @@ public:
     void OnGlobal(wl_registry* registry, uint32_t name, const char* interface, uint32_t version);
     void OnGlobalRemove(uint32_t name);
     void OnLayerConfigure(uint32_t serial, uint32_t width, uint32_t height);
+    void OnSecondaryLayerConfigure(uint32_t serial, uint32_t width, uint32_t height);
     void OnLayerClosed();
     void OnXdgSurfaceConfigure(uint32_t serial);
     void OnXdgToplevelConfigure(int32_t width, int32_t height);
     void OnXdgToplevelClose();
 
+    struct FeedbackRecord {
+        WaylandPresenter*         owner = nullptr;
+        wp_presentation_feedback* proxy = nullptr;
+        PresentTiming             timing;
+    };
+    void OnPresentationClock(uint32_t clk_id) { presentation_clock_ = clk_id; }
+    void OnFeedbackDone(FeedbackRecord* record);
+    double ToMonotonic(uint64_t sec, uint32_t nsec) const;
+    void OnFrameDone();
+
     std::vector<OutputInfo>& Outputs() { return outputs_; }
 
 private:
@@ -104,9 +160,22 @@ private:
     bool CreateXdgFullscreenSurface(wl_output* output);
     bool WaitForConfigure();
     void DestroyNative();
-    // Empty input region on surface_ = click-through; null = capture whole
-    // surface. Shared by surface init and SetInputCapture.
-    void SetSurfaceInputRegion(bool capture);
+    // Empty input region = click-through; null = capture the whole surface.
+    // Shared by surface init and SetInputCapture.
+    void SetSurfaceInputRegion(wl_surface* surface, bool capture);
+    // DualDisplay: the output platform::ResolveTargetMonitors pairs with
+    // `left` as its right neighbor, if we have it bound.
+    const OutputInfo* FindRightEyeOutput(const OutputInfo& left) const;
+    // Layer surface + secondary_ swapchain for the right eye on `output`.
+    bool CreateSecondaryOutput(wl_output* output);
+    void DestroySecondaryOutput();
+    // New configure size for whichever target is live.
+    void ApplyConfigureSize(uint32_t width, uint32_t height);
+    bool InitDmabufRing();
+    void RequestPresentationFeedback();
+    // Reads and dispatches the default queue until `done` or the timeout.
+    // Only for the dmabuf path, where no WSI shares the connection.
+    bool WaitForDisplay(const std::function<bool()>& done, int timeout_ms);
 
     // ctx_ + swapchain_ live in SwapchainPresenterBase.
 
@@ -124,6 +193,16 @@ private:
 
     VkSurfaceKHR    vk_surface_ = VK_NULL_HANDLE;
 
+    // DualDisplay lockstep: the right eye's overlay on its own output,
+    // presented through secondary_ (layer-shell + WSI only).
+    wl_surface*            secondary_surface_ = nullptr;
+    zwlr_layer_surface_v1* secondary_layer_surface_ = nullptr;
+    wp_content_type_v1*    secondary_content_type_ = nullptr;
+    VkSurfaceKHR           vk_surface2_ = VK_NULL_HANDLE;
+    bool                   secondary_configured_ = false;
+    uint32_t               surf2_width_ = 0;
+    uint32_t               surf2_height_ = 0;
+
     // Configure-driven state.
     bool     configured_ = false;
     bool     closed_ = false;
@@ -131,6 +210,29 @@ private:
     uint32_t surf_height_ = 0;
     int32_t  pending_xdg_w_ = 0;   // xdg_toplevel configure is buffered until
     int32_t  pending_xdg_h_ = 0;   // the matching xdg_surface configure
+
+    bool     read_prepared_ = false;  // between PrepareEventWait and FinishEventWait
+
+    // Presentation feedback. Records live in feedback_inflight_ until their
+    // presented/discarded event, then their timing moves to timings_ (capped
+    // so an undrained queue can't grow without bound).
+    wp_presentation* presentation_ = nullptr;
+    uint32_t         presentation_clock_ = 1;  // CLOCK_MONOTONIC until told otherwise
+    std::vector<std::unique_ptr<FeedbackRecord>> feedback_inflight_;
+    std::deque<PresentTiming> timings_;
+    uint64_t         next_frame_id_ = 0;
+    bool             has_fifo_v1_ = false;
+    bool             has_commit_timing_v1_ = false;
+    bool             zero_copy_ = false;  // last presented frame skipped composition
+
+    // VRR hint (content type "game").
+    wp_content_type_manager_v1* content_type_manager_ = nullptr;
+    wp_content_type_v1*         content_type_ = nullptr;
+
+    // Zero-copy dmabuf path (null = WSI swapchain).
+    zwp_linux_dmabuf_v1* linux_dmabuf_ = nullptr;
+    std::unique_ptr<WaylandDmabufRing> dmabuf_ring_;
+    wl_callback*     frame_callback_ = nullptr;  // from the last commit, until done
 };
 
 }  // namespace vrto3d
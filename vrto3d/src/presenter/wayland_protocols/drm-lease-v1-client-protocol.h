@@ -0,0 +1,490 @@
+/* Generated by wayland-scanner 1.24.0 */
+
+#ifndef DRM_LEASE_V1_CLIENT_PROTOCOL_H
+#define DRM_LEASE_V1_CLIENT_PROTOCOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "wayland-client.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @page page_drm_lease_v1 The drm_lease_v1 protocol
+ * @section page_ifaces_drm_lease_v1 Interfaces
+ * - @subpage page_iface_wp_drm_lease_device_v1 - lease device
+ * - @subpage page_iface_wp_drm_lease_connector_v1 - a leasable DRM connector
+ * - @subpage page_iface_wp_drm_lease_request_v1 - DRM lease request
+ * - @subpage page_iface_wp_drm_lease_v1 - a DRM lease
+ * @section page_copyright_drm_lease_v1 Copyright
+ * <pre>
+ *
+ * Copyright © 2018 NXP
+ * Copyright © 2019 Status Research & Development GmbH.
+ * Copyright © 2021 Xaver Hugl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ * </pre>
+ */
+struct wp_drm_lease_connector_v1;
+struct wp_drm_lease_device_v1;
+struct wp_drm_lease_request_v1;
+struct wp_drm_lease_v1;
+
+#ifndef WP_DRM_LEASE_DEVICE_V1_INTERFACE
+#define WP_DRM_LEASE_DEVICE_V1_INTERFACE
+/**
+ * @page page_iface_wp_drm_lease_device_v1 wp_drm_lease_device_v1
+ * @section page_iface_wp_drm_lease_device_v1_api API
+ * See @ref iface_wp_drm_lease_device_v1.
+ */
+/**
+ * @defgroup iface_wp_drm_lease_device_v1 The wp_drm_lease_device_v1 interface
+ *
+ * lease device
+ */
+extern const struct wl_interface wp_drm_lease_device_v1_interface;
+#endif
+#ifndef WP_DRM_LEASE_CONNECTOR_V1_INTERFACE
+#define WP_DRM_LEASE_CONNECTOR_V1_INTERFACE
+/**
+ * @page page_iface_wp_drm_lease_connector_v1 wp_drm_lease_connector_v1
+ * @section page_iface_wp_drm_lease_connector_v1_api API
+ * See @ref iface_wp_drm_lease_connector_v1.
+ */
+/**
+ * @defgroup iface_wp_drm_lease_connector_v1 The wp_drm_lease_connector_v1 interface
+ *
+ * a leasable DRM connector
+ */
+extern const struct wl_interface wp_drm_lease_connector_v1_interface;
+#endif
+#ifndef WP_DRM_LEASE_REQUEST_V1_INTERFACE
+#define WP_DRM_LEASE_REQUEST_V1_INTERFACE
+/**
+ * @page page_iface_wp_drm_lease_request_v1 wp_drm_lease_request_v1
+ * @section page_iface_wp_drm_lease_request_v1_api API
+ * See @ref iface_wp_drm_lease_request_v1.
+ */
+/**
+ * @defgroup iface_wp_drm_lease_request_v1 The wp_drm_lease_request_v1 interface
+ *
+ * DRM lease request
+ */
+extern const struct wl_interface wp_drm_lease_request_v1_interface;
+#endif
+#ifndef WP_DRM_LEASE_V1_INTERFACE
+#define WP_DRM_LEASE_V1_INTERFACE
+/**
+ * @page page_iface_wp_drm_lease_v1 wp_drm_lease_v1
+ * @section page_iface_wp_drm_lease_v1_api API
+ * See @ref iface_wp_drm_lease_v1.
+ */
+/**
+ * @defgroup iface_wp_drm_lease_v1 The wp_drm_lease_v1 interface
+ *
+ * a DRM lease
+ */
+extern const struct wl_interface wp_drm_lease_v1_interface;
+#endif
+/**
+ * @ingroup iface_wp_drm_lease_device_v1
+ * @struct wp_drm_lease_device_v1_listener
+ */
+struct wp_drm_lease_device_v1_listener {
+	/**
+	 * open a non-master fd for this DRM node
+	 */
+	void (*drm_fd)(void *data,
+		struct wp_drm_lease_device_v1 *wp_drm_lease_device_v1,
+		int32_t fd);
+	/**
+	 * advertise connectors available for leases
+	 */
+	void (*connector)(void *data,
+		struct wp_drm_lease_device_v1 *wp_drm_lease_device_v1,
+		struct wp_drm_lease_connector_v1 *id);
+	/**
+	 * signals grouping of connectors
+	 */
+	void (*done)(void *data,
+		struct wp_drm_lease_device_v1 *wp_drm_lease_device_v1);
+	/**
+	 * the compositor has finished using the device
+	 */
+	void (*released)(void *data,
+		struct wp_drm_lease_device_v1 *wp_drm_lease_device_v1);
+};
+
+/**
+ * @ingroup iface_wp_drm_lease_device_v1
+ */
+static inline int
+wp_drm_lease_device_v1_add_listener(struct wp_drm_lease_device_v1 *wp_drm_lease_device_v1,
+		const struct wp_drm_lease_device_v1_listener *listener, void *data)
+{
+	return wl_proxy_add_listener((struct wl_proxy *) wp_drm_lease_device_v1,
+				     (void (**)(void)) listener, data);
+}
+
+#define WP_DRM_LEASE_DEVICE_V1_CREATE_LEASE_REQUEST 0
+#define WP_DRM_LEASE_DEVICE_V1_RELEASE 1
+
+/**
+ * @ingroup iface_wp_drm_lease_device_v1
+ */
+#define WP_DRM_LEASE_DEVICE_V1_DRM_FD_SINCE_VERSION 1
+/**
+ * @ingroup iface_wp_drm_lease_device_v1
+ */
+#define WP_DRM_LEASE_DEVICE_V1_CONNECTOR_SINCE_VERSION 1
+/**
+ * @ingroup iface_wp_drm_lease_device_v1
+ */
+#define WP_DRM_LEASE_DEVICE_V1_DONE_SINCE_VERSION 1
+/**
+ * @ingroup iface_wp_drm_lease_device_v1
+ */
+#define WP_DRM_LEASE_DEVICE_V1_RELEASED_SINCE_VERSION 1
+/**
+ * @ingroup iface_wp_drm_lease_device_v1
+ */
+#define WP_DRM_LEASE_DEVICE_V1_CREATE_LEASE_REQUEST_SINCE_VERSION 1
+/**
+ * @ingroup iface_wp_drm_lease_device_v1
+ */
+#define WP_DRM_LEASE_DEVICE_V1_RELEASE_SINCE_VERSION 1
+
+/** @ingroup iface_wp_drm_lease_device_v1 */
+static inline void
+wp_drm_lease_device_v1_set_user_data(struct wp_drm_lease_device_v1 *wp_drm_lease_device_v1, void *user_data)
+{
+	wl_proxy_set_user_data((struct wl_proxy *) wp_drm_lease_device_v1, user_data);
+}
+
+/** @ingroup iface_wp_drm_lease_device_v1 */
+static inline void *
+wp_drm_lease_device_v1_get_user_data(struct wp_drm_lease_device_v1 *wp_drm_lease_device_v1)
+{
+	return wl_proxy_get_user_data((struct wl_proxy *) wp_drm_lease_device_v1);
+}
+
+static inline uint32_t
+wp_drm_lease_device_v1_get_version(struct wp_drm_lease_device_v1 *wp_drm_lease_device_v1)
+{
+	return wl_proxy_get_version((struct wl_proxy *) wp_drm_lease_device_v1);
+}
+
+/**
+ * @ingroup iface_wp_drm_lease_device_v1
+ *
+ * Creates a lease request object.
+ */
+static inline struct wp_drm_lease_request_v1 *
+wp_drm_lease_device_v1_create_lease_request(struct wp_drm_lease_device_v1 *wp_drm_lease_device_v1)
+{
+	struct wl_proxy *id;
+
+	id = wl_proxy_marshal_flags((struct wl_proxy *) wp_drm_lease_device_v1,
+			 WP_DRM_LEASE_DEVICE_V1_CREATE_LEASE_REQUEST, &wp_drm_lease_request_v1_interface, wl_proxy_get_version((struct wl_proxy *) wp_drm_lease_device_v1), 0, NULL);
+
+	return (struct wp_drm_lease_request_v1 *) id;
+}
+
+/**
+ * @ingroup iface_wp_drm_lease_device_v1
+ *
+ * Indicates the client no longer wishes to use this object. In response
+ * the compositor will immediately send the released event and destroy
+ * this object.
+ */
+static inline void
+wp_drm_lease_device_v1_release(struct wp_drm_lease_device_v1 *wp_drm_lease_device_v1)
+{
+	wl_proxy_marshal_flags((struct wl_proxy *) wp_drm_lease_device_v1,
+			 WP_DRM_LEASE_DEVICE_V1_RELEASE, NULL, wl_proxy_get_version((struct wl_proxy *) wp_drm_lease_device_v1), 0);
+}
+
+/** @ingroup iface_wp_drm_lease_device_v1 */
+static inline void
+wp_drm_lease_device_v1_destroy(struct wp_drm_lease_device_v1 *wp_drm_lease_device_v1)
+{
+	wl_proxy_destroy((struct wl_proxy *) wp_drm_lease_device_v1);
+}
+
+/**
+ * @ingroup iface_wp_drm_lease_connector_v1
+ * @struct wp_drm_lease_connector_v1_listener
+ */
+struct wp_drm_lease_connector_v1_listener {
+	/**
+	 * name
+	 */
+	void (*name)(void *data,
+		struct wp_drm_lease_connector_v1 *wp_drm_lease_connector_v1,
+		const char *name);
+	/**
+	 * description
+	 */
+	void (*description)(void *data,
+		struct wp_drm_lease_connector_v1 *wp_drm_lease_connector_v1,
+		const char *description);
+	/**
+	 * connector_id
+	 */
+	void (*connector_id)(void *data,
+		struct wp_drm_lease_connector_v1 *wp_drm_lease_connector_v1,
+		uint32_t connector_id);
+	/**
+	 * all properties have been sent
+	 */
+	void (*done)(void *data,
+		struct wp_drm_lease_connector_v1 *wp_drm_lease_connector_v1);
+	/**
+	 * lease offer withdrawn
+	 */
+	void (*withdrawn)(void *data,
+		struct wp_drm_lease_connector_v1 *wp_drm_lease_connector_v1);
+};
+
+/**
+ * @ingroup iface_wp_drm_lease_connector_v1
+ */
+static inline int
+wp_drm_lease_connector_v1_add_listener(struct wp_drm_lease_connector_v1 *wp_drm_lease_connector_v1,
+		const struct wp_drm_lease_connector_v1_listener *listener, void *data)
+{
+	return wl_proxy_add_listener((struct wl_proxy *) wp_drm_lease_connector_v1,
+				     (void (**)(void)) listener, data);
+}
+
+#define WP_DRM_LEASE_CONNECTOR_V1_DESTROY 0
+
+/**
+ * @ingroup iface_wp_drm_lease_connector_v1
+ */
+#define WP_DRM_LEASE_CONNECTOR_V1_NAME_SINCE_VERSION 1
+/**
+ * @ingroup iface_wp_drm_lease_connector_v1
+ */
+#define WP_DRM_LEASE_CONNECTOR_V1_DESCRIPTION_SINCE_VERSION 1
+/**
+ * @ingroup iface_wp_drm_lease_connector_v1
+ */
+#define WP_DRM_LEASE_CONNECTOR_V1_CONNECTOR_ID_SINCE_VERSION 1
+/**
+ * @ingroup iface_wp_drm_lease_connector_v1
+ */
+#define WP_DRM_LEASE_CONNECTOR_V1_DONE_SINCE_VERSION 1
+/**
+ * @ingroup iface_wp_drm_lease_connector_v1
+ */
+#define WP_DRM_LEASE_CONNECTOR_V1_WITHDRAWN_SINCE_VERSION 1
+/**
+ * @ingroup iface_wp_drm_lease_connector_v1
+ */
+#define WP_DRM_LEASE_CONNECTOR_V1_DESTROY_SINCE_VERSION 1
+
+/** @ingroup iface_wp_drm_lease_connector_v1 */
+static inline void
+wp_drm_lease_connector_v1_set_user_data(struct wp_drm_lease_connector_v1 *wp_drm_lease_connector_v1, void *user_data)
+{
+	wl_proxy_set_user_data((struct wl_proxy *) wp_drm_lease_connector_v1, user_data);
+}
+
+/** @ingroup iface_wp_drm_lease_connector_v1 */
+static inline void *
+wp_drm_lease_connector_v1_get_user_data(struct wp_drm_lease_connector_v1 *wp_drm_lease_connector_v1)
+{
+	return wl_proxy_get_user_data((struct wl_proxy *) wp_drm_lease_connector_v1);
+}
+
+static inline uint32_t
+wp_drm_lease_connector_v1_get_version(struct wp_drm_lease_connector_v1 *wp_drm_lease_connector_v1)
+{
+	return wl_proxy_get_version((struct wl_proxy *) wp_drm_lease_connector_v1);
+}
+
+/**
+ * @ingroup iface_wp_drm_lease_connector_v1
+ *
+ * The client may send this request to indicate that it will not use
+ * this connector.
+ */
+static inline void
+wp_drm_lease_connector_v1_destroy(struct wp_drm_lease_connector_v1 *wp_drm_lease_connector_v1)
+{
+	wl_proxy_marshal_flags((struct wl_proxy *) wp_drm_lease_connector_v1,
+			 WP_DRM_LEASE_CONNECTOR_V1_DESTROY, NULL, wl_proxy_get_version((struct wl_proxy *) wp_drm_lease_connector_v1), WL_MARSHAL_FLAG_DESTROY);
+}
+
+#define WP_DRM_LEASE_REQUEST_V1_REQUEST_CONNECTOR 0
+#define WP_DRM_LEASE_REQUEST_V1_SUBMIT 1
+
+/**
+ * @ingroup iface_wp_drm_lease_request_v1
+ */
+#define WP_DRM_LEASE_REQUEST_V1_REQUEST_CONNECTOR_SINCE_VERSION 1
+/**
+ * @ingroup iface_wp_drm_lease_request_v1
+ */
+#define WP_DRM_LEASE_REQUEST_V1_SUBMIT_SINCE_VERSION 1
+
+/** @ingroup iface_wp_drm_lease_request_v1 */
+static inline void
+wp_drm_lease_request_v1_set_user_data(struct wp_drm_lease_request_v1 *wp_drm_lease_request_v1, void *user_data)
+{
+	wl_proxy_set_user_data((struct wl_proxy *) wp_drm_lease_request_v1, user_data);
+}
+
+/** @ingroup iface_wp_drm_lease_request_v1 */
+static inline void *
+wp_drm_lease_request_v1_get_user_data(struct wp_drm_lease_request_v1 *wp_drm_lease_request_v1)
+{
+	return wl_proxy_get_user_data((struct wl_proxy *) wp_drm_lease_request_v1);
+}
+
+static inline uint32_t
+wp_drm_lease_request_v1_get_version(struct wp_drm_lease_request_v1 *wp_drm_lease_request_v1)
+{
+	return wl_proxy_get_version((struct wl_proxy *) wp_drm_lease_request_v1);
+}
+
+/**
+ * @ingroup iface_wp_drm_lease_request_v1
+ *
+ * Indicates that the client would like to lease the given connector.
+ */
+static inline void
+wp_drm_lease_request_v1_request_connector(struct wp_drm_lease_request_v1 *wp_drm_lease_request_v1, struct wp_drm_lease_connector_v1 *connector)
+{
+	wl_proxy_marshal_flags((struct wl_proxy *) wp_drm_lease_request_v1,
+			 WP_DRM_LEASE_REQUEST_V1_REQUEST_CONNECTOR, NULL, wl_proxy_get_version((struct wl_proxy *) wp_drm_lease_request_v1), 0, connector);
+}
+
+/**
+ * @ingroup iface_wp_drm_lease_request_v1
+ *
+ * Submits the lease request and creates a new wp_drm_lease_v1 object.
+ * The request object is destroyed.
+ */
+static inline struct wp_drm_lease_v1 *
+wp_drm_lease_request_v1_submit(struct wp_drm_lease_request_v1 *wp_drm_lease_request_v1)
+{
+	struct wl_proxy *id;
+
+	id = wl_proxy_marshal_flags((struct wl_proxy *) wp_drm_lease_request_v1,
+			 WP_DRM_LEASE_REQUEST_V1_SUBMIT, &wp_drm_lease_v1_interface, wl_proxy_get_version((struct wl_proxy *) wp_drm_lease_request_v1), WL_MARSHAL_FLAG_DESTROY, NULL);
+
+	return (struct wp_drm_lease_v1 *) id;
+}
+
+/** @ingroup iface_wp_drm_lease_request_v1 */
+static inline void
+wp_drm_lease_request_v1_destroy(struct wp_drm_lease_request_v1 *wp_drm_lease_request_v1)
+{
+	wl_proxy_destroy((struct wl_proxy *) wp_drm_lease_request_v1);
+}
+
+/**
+ * @ingroup iface_wp_drm_lease_v1
+ * @struct wp_drm_lease_v1_listener
+ */
+struct wp_drm_lease_v1_listener {
+	/**
+	 * shares the DRM file descriptor
+	 */
+	void (*lease_fd)(void *data,
+		struct wp_drm_lease_v1 *wp_drm_lease_v1,
+		int32_t leased_fd);
+	/**
+	 * sent when the lease has been revoked
+	 */
+	void (*finished)(void *data,
+		struct wp_drm_lease_v1 *wp_drm_lease_v1);
+};
+
+/**
+ * @ingroup iface_wp_drm_lease_v1
+ */
+static inline int
+wp_drm_lease_v1_add_listener(struct wp_drm_lease_v1 *wp_drm_lease_v1,
+		const struct wp_drm_lease_v1_listener *listener, void *data)
+{
+	return wl_proxy_add_listener((struct wl_proxy *) wp_drm_lease_v1,
+				     (void (**)(void)) listener, data);
+}
+
+#define WP_DRM_LEASE_V1_DESTROY 0
+
+/**
+ * @ingroup iface_wp_drm_lease_v1
+ */
+#define WP_DRM_LEASE_V1_LEASE_FD_SINCE_VERSION 1
+/**
+ * @ingroup iface_wp_drm_lease_v1
+ */
+#define WP_DRM_LEASE_V1_FINISHED_SINCE_VERSION 1
+/**
+ * @ingroup iface_wp_drm_lease_v1
+ */
+#define WP_DRM_LEASE_V1_DESTROY_SINCE_VERSION 1
+
+/** @ingroup iface_wp_drm_lease_v1 */
+static inline void
+wp_drm_lease_v1_set_user_data(struct wp_drm_lease_v1 *wp_drm_lease_v1, void *user_data)
+{
+	wl_proxy_set_user_data((struct wl_proxy *) wp_drm_lease_v1, user_data);
+}
+
+/** @ingroup iface_wp_drm_lease_v1 */
+static inline void *
+wp_drm_lease_v1_get_user_data(struct wp_drm_lease_v1 *wp_drm_lease_v1)
+{
+	return wl_proxy_get_user_data((struct wl_proxy *) wp_drm_lease_v1);
+}
+
+static inline uint32_t
+wp_drm_lease_v1_get_version(struct wp_drm_lease_v1 *wp_drm_lease_v1)
+{
+	return wl_proxy_get_version((struct wl_proxy *) wp_drm_lease_v1);
+}
+
+/**
+ * @ingroup iface_wp_drm_lease_v1
+ *
+ * The client should send this to indicate that it no longer wishes to
+ * use this lease. The compositor should use drmModeRevokeLease on the
+ * appropriate file descriptor, if necessary.
+ */
+static inline void
+wp_drm_lease_v1_destroy(struct wp_drm_lease_v1 *wp_drm_lease_v1)
+{
+	wl_proxy_marshal_flags((struct wl_proxy *) wp_drm_lease_v1,
+			 WP_DRM_LEASE_V1_DESTROY, NULL, wl_proxy_get_version((struct wl_proxy *) wp_drm_lease_v1), WL_MARSHAL_FLAG_DESTROY);
+}
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif
@@ -19,14 +19,34 @@
 #include <dlfcn.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <mutex>
+#include <string>
+
 #include <drm_fourcc.h>
 
+#include "driver_settings.h"
+#include "profile_sidecar.h"
 #include "vk/vk_context.h"
 #include "presenter/vk_swapchain_util.h"  // PresenterLog
-#include "presenter/wwclient.h"  // WWSF_* format constants
 
 namespace vrto3d {
 
+namespace {
+
+int ParseSourceFormat(const std::string& name)
+{
+    if (name == "half")
+        return WWSF_SIDE_BY_SIDE_HALF;
+    if (name == "checkerboard")
+        return WWSF_CHECKERBOARD;
+    if (name != "full")
+        PresenterLog("wibblewobble: unknown ww_source \"%s\" — using full SbS", name.c_str());
+    return WWSF_SIDE_BY_SIDE_FULL;
+}
+
+}  // namespace
+
 WibbleWobblePresenter::~WibbleWobblePresenter()
 {
     Shutdown();
@@ -49,6 +69,7 @@ bool WibbleWobblePresenter::LoadClient()
     p_regbuf_  = (decltype(p_regbuf_))dlsym(lib_, "WWClient_RegisterBuffer");
     p_present_ = (decltype(p_present_))dlsym(lib_, "WWClient_PresentFrame");
     p_busy_    = (decltype(p_busy_))dlsym(lib_, "WWClient_BufferBusy");
+    p_regplanes_ = (decltype(p_regplanes_))dlsym(lib_, "WWClient_RegisterBufferPlanes");
     if (!p_create_ || !p_running_ || !p_destroy_ || !p_setfmt_ || !p_regbuf_ || !p_present_ ||
         !p_busy_) {
         PresenterLog("wibblewobble: libwwclient missing expected symbols");
@@ -65,16 +86,25 @@ bool WibbleWobblePresenter::Init(vrto3d::vk::DeviceCtx* ctx,
     // told to render and what out_sbs_ ends up being). If the live frame
     // differs the repack scales into this — matching wwserver's expectation of
     // a full side-by-side WWSF_SideBySideFull frame.
-    extent_ = {(uint32_t)cfg.render_width * 2u, (uint32_t)cfg.render_height};
-    if (extent_.width == 0 || extent_.height == 0)
-        extent_ = {3840, 1080};
+    // source_format_ was set by ApplyProfile() beforehand.
+    full_extent_ = {(uint32_t)cfg.render_width * 2u, (uint32_t)cfg.render_height};
+    if (full_extent_.width == 0 || full_extent_.height == 0)
+        full_extent_ = {3840, 1080};
 
     if (!LoadClient())
         return false;
 
+    get_memory_fd_ = (PFN_vkGetMemoryFdKHR)vkGetDeviceProcAddr(ctx_->device, "vkGetMemoryFdKHR");
+    get_image_modifier_ = (PFN_vkGetImageDrmFormatModifierPropertiesEXT)vkGetDeviceProcAddr(
+        ctx_->device, "vkGetImageDrmFormatModifierPropertiesEXT");
+    if (!get_memory_fd_ || !get_image_modifier_) {
+        PresenterLog("wibblewobble: dmabuf export entry points unavailable");
+        return false;
+    }
+
     // Render pass matching the swapchain presenters (loadOp DONT_CARE — the
-    // repack overwrites every pixel; final layout COLOR_ATTACHMENT so we can
-    // blit out of it afterwards).
+    // repack overwrites every pixel), left in COLOR_ATTACHMENT_OPTIMAL:
+    // Present() moves the image to GENERAL while releasing it to wwserver.
     VkAttachmentDescription att{};
     att.format = format_;
     att.samples = VK_SAMPLE_COUNT_1_BIT;
@@ -83,7 +113,7 @@ bool WibbleWobblePresenter::Init(vrto3d::vk::DeviceCtx* ctx,
     att.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     att.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     att.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    att.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    att.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
     VkAttachmentReference ref{0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
     VkSubpassDescription sub{};
     sub.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
@@ -112,113 +142,209 @@ bool WibbleWobblePresenter::Init(vrto3d::vk::DeviceCtx* ctx,
     cpci.queueFamilyIndex = ctx_->queue_family;
     vkCreateCommandPool(ctx_->device, &cpci, nullptr, &cmd_pool_);
 
-    if (!CreateFrames())
-        return false;
-
     ww_ = reinterpret_cast<WWClientOpaque*>(p_create_("vrto3d"));
     if (!ww_) {
         PresenterLog("wibblewobble: WWClient_Create failed");
         return false;
     }
-    // XRGB8888 <- B8G8R8A8_UNORM. Full side-by-side.
-    p_setfmt_(ww_, WWSF_SIDE_BY_SIDE_FULL, extent_.width, extent_.height,
-              DRM_FORMAT_XRGB8888, DRM_FORMAT_MOD_LINEAR);
-    for (int i = 0; i < kRing; ++i) {
-        const int idx = p_regbuf_(ww_, frames_[i].dmabuf_fd, frames_[i].stride, 0,
-                                  (uint64_t)frames_[i].stride * extent_.height);
-        if (idx != i)
-            PresenterLog("wibblewobble: buffer %d registered as %d", i, idx);
+    return BuildRing();
+}
+
+void WibbleWobblePresenter::ApplyProfile(const OutputProfileOptions& opts)
+{
+    const int source = ParseSourceFormat(opts.ww_source);
+    if (source == source_format_)
+        return;
+    source_format_ = source;
+    if (!ww_)
+        return;  // before Init(): BuildRing picks it up
+
+    // wwserver drops buffers registered under the old format when
+    // RegisterFrames re-declares it.
+    {
+        std::lock_guard<std::mutex> lock(ctx_->queue_mutex);
+        vkQueueWaitIdle(ctx_->queue);
     }
-    PresenterLog("wibblewobble: streaming %ux%u SbS to wwserver", extent_.width, extent_.height);
-    return true;
+    DestroyFrames();
+    if (!BuildRing())
+        PresenterLog("wibblewobble: ring rebuild failed — output stopped until the next profile change");
 }
 
-bool WibbleWobblePresenter::CreateFrames()
+bool WibbleWobblePresenter::BuildRing()
 {
-    frames_.resize(kRing);
-    auto* get_fd = (PFN_vkGetMemoryFdKHR)vkGetDeviceProcAddr(ctx_->device, "vkGetMemoryFdKHR");
-    if (!get_fd) {
-        PresenterLog("wibblewobble: vkGetMemoryFdKHR unavailable");
+    // Half SbS and checkerboard both fit the two eyes in one eye's worth of
+    // pixels; the repack resamples straight into that.
+    extent_ = full_extent_;
+    if (source_format_ != WWSF_SIDE_BY_SIDE_FULL)
+        extent_.width /= 2;
+
+    std::vector<Modifier> candidates = RenderableModifiers();
+    if (DriverSettingBool("wibblewobble_linear", false)) {
+        PresenterLog("wibblewobble: wibblewobble_linear set — skipping tiled modifiers");
+        candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                        [](const Modifier& m) {
+                                            return m.modifier != DRM_FORMAT_MOD_LINEAR;
+                                        }),
+                         candidates.end());
+    }
+    if (candidates.empty()) {
+        PresenterLog("wibblewobble: no renderable, exportable modifier for this format");
+        return false;
+    }
+    if (!CreateFrames(candidates)) {
+        DestroyFrames();
         return false;
     }
+    if (!RegisterFrames() && modifier_ != DRM_FORMAT_MOD_LINEAR) {
+        // wwserver couldn't import the tiled layout; linear always imports.
+        PresenterLog("wibblewobble: wwserver rejected modifier 0x%016llx — retrying linear",
+                     static_cast<unsigned long long>(modifier_));
+        DestroyFrames();
+        if (!CreateFrames({Modifier{DRM_FORMAT_MOD_LINEAR, 1}}) || !RegisterFrames()) {
+            DestroyFrames();
+            return false;
+        }
+    }
+    static const char* const kSourceNames[] = {"single", "half SbS", "checkerboard", "full SbS"};
+    PresenterLog("wibblewobble: streaming %ux%u %s to wwserver, modifier 0x%016llx",
+                 extent_.width, extent_.height, kSourceNames[source_format_],
+                 static_cast<unsigned long long>(modifier_));
+    return true;
+}
+
+OutputMode WibbleWobblePresenter::RepackMode(OutputMode configured) const
+{
+    // The shader's WibbleWobble path is a plain horizontal split, which is
+    // right for both SbS widths; checkerboard needs the per-pixel packing.
+    return source_format_ == WWSF_CHECKERBOARD ? OutputMode::Checkerboard : configured;
+}
+
+std::vector<WibbleWobblePresenter::Modifier> WibbleWobblePresenter::RenderableModifiers() const
+{
+    std::vector<Modifier> out =
+        vrto3d::vk::RenderableDrmModifiers(*ctx_, format_, extent_.width, extent_.height);
+    // Multi-plane layouts (CCS and friends) need the planes entry point.
+    out.erase(std::remove_if(out.begin(), out.end(),
+                             [this](const Modifier& m) {
+                                 return m.planes > 4 || (m.planes > 1 && !p_regplanes_);
+                             }),
+              out.end());
+    return out;
+}
+
+bool WibbleWobblePresenter::CreateFrames(const std::vector<Modifier>& candidates)
+{
+    std::vector<uint64_t> modifiers;
+    for (const Modifier& m : candidates)
+        modifiers.push_back(m.modifier);
 
     VkCommandBufferAllocateInfo cbai{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
     cbai.commandPool = cmd_pool_;
     cbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
     cbai.commandBufferCount = 1;
 
+    frames_.resize(kRing);
     for (auto& f : frames_) {
-        // ---- render target (OPTIMAL, COLOR_ATTACHMENT + TRANSFER_SRC) ----
-        vrto3d::vk::Image2D render;
-        if (!vrto3d::vk::CreateImage2D(*ctx_, extent_.width, extent_.height, format_,
-                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
-                VK_IMAGE_TILING_OPTIMAL, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                /*make_view=*/true, &render))
-            return false;
-        f.render_img = render.image;
-        f.render_mem = render.memory;
-        f.render_view = render.view;
-        VkFramebufferCreateInfo fbi{VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO};
-        fbi.renderPass = render_pass_;
-        fbi.attachmentCount = 1;
-        fbi.pAttachments = &f.render_view;
-        fbi.width = extent_.width;
-        fbi.height = extent_.height;
-        fbi.layers = 1;
-        if (vkCreateFramebuffer(ctx_->device, &fbi, nullptr, &f.framebuffer) != VK_SUCCESS)
-            return false;
-
-        // ---- exportable LINEAR dmabuf (TRANSFER_DST) handed to wwserver ----
+        // The driver picks its preferred layout from the list; every frame
+        // gets the same one since the inputs are identical.
+        VkImageDrmFormatModifierListCreateInfoEXT mod_list{
+            VK_STRUCTURE_TYPE_IMAGE_DRM_FORMAT_MODIFIER_LIST_CREATE_INFO_EXT};
+        mod_list.drmFormatModifierCount = static_cast<uint32_t>(modifiers.size());
+        mod_list.pDrmFormatModifiers = modifiers.data();
         VkExternalMemoryImageCreateInfo ext{VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_IMAGE_CREATE_INFO};
+        ext.pNext = &mod_list;
         ext.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT;
-        VkImageCreateInfo dici{VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
-        dici.pNext = &ext;
-        dici.imageType = VK_IMAGE_TYPE_2D;
-        dici.format = format_;
-        dici.extent = {extent_.width, extent_.height, 1};
-        dici.mipLevels = 1;
-        dici.arrayLayers = 1;
-        dici.samples = VK_SAMPLE_COUNT_1_BIT;
-        dici.tiling = VK_IMAGE_TILING_LINEAR;  // portable cross-process import
-        dici.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-        dici.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        if (vkCreateImage(ctx_->device, &dici, nullptr, &f.dmabuf_img) != VK_SUCCESS)
+        VkImageCreateInfo ici{VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+        ici.pNext = &ext;
+        ici.imageType = VK_IMAGE_TYPE_2D;
+        ici.format = format_;
+        ici.extent = {extent_.width, extent_.height, 1};
+        ici.mipLevels = 1;
+        ici.arrayLayers = 1;
+        ici.samples = VK_SAMPLE_COUNT_1_BIT;
+        ici.tiling = VK_IMAGE_TILING_DRM_FORMAT_MODIFIER_EXT;
+        ici.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        ici.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        ici.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        if (vrto3d::vk::LogIfFailed(vkCreateImage(ctx_->device, &ici, nullptr, &f.image),
+                                    "wibblewobble vkCreateImage") != VK_SUCCESS)
             return false;
-        VkMemoryRequirements dreqs{};
-        vkGetImageMemoryRequirements(ctx_->device, f.dmabuf_img, &dreqs);
+
         VkExportMemoryAllocateInfo emai{VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO};
         emai.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT;
         VkMemoryDedicatedAllocateInfo ded{VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO};
-        ded.image = f.dmabuf_img;
         ded.pNext = &emai;
-        VkMemoryAllocateInfo dmai{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
-        dmai.pNext = &ded;
-        dmai.allocationSize = dreqs.size;
-        dmai.memoryTypeIndex = ctx_->FindMemoryType(dreqs.memoryTypeBits,
-                                                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-        if (dmai.memoryTypeIndex == UINT32_MAX)
-            dmai.memoryTypeIndex = ctx_->FindMemoryType(dreqs.memoryTypeBits, 0);
-        if (vkAllocateMemory(ctx_->device, &dmai, nullptr, &f.dmabuf_mem) != VK_SUCCESS)
+        ded.image = f.image;
+        if (!vrto3d::vk::AllocateBindImageView(*ctx_, f.image, format_,
+                                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &ded, 0,
+                                               /*make_view=*/true, &f.memory, &f.view))
             return false;
-        vkBindImageMemory(ctx_->device, f.dmabuf_img, f.dmabuf_mem, 0);
+
+        VkImageDrmFormatModifierPropertiesEXT mod_props{
+            VK_STRUCTURE_TYPE_IMAGE_DRM_FORMAT_MODIFIER_PROPERTIES_EXT};
+        get_image_modifier_(ctx_->device, f.image, &mod_props);
+        modifier_ = mod_props.drmFormatModifier;
+        for (const Modifier& m : candidates) {
+            if (m.modifier == modifier_) f.planes = m.planes;
+        }
+        for (uint32_t p = 0; p < f.planes; ++p) {
+            VkImageSubresource sr{};
+            sr.aspectMask = static_cast<VkImageAspectFlags>(VK_IMAGE_ASPECT_MEMORY_PLANE_0_BIT_EXT << p);
+            VkSubresourceLayout layout{};
+            vkGetImageSubresourceLayout(ctx_->device, f.image, &sr, &layout);
+            f.strides[p] = static_cast<uint32_t>(layout.rowPitch);
+            f.offsets[p] = static_cast<uint32_t>(layout.offset);
+            f.sizes[p] = layout.size;
+        }
 
         VkMemoryGetFdInfoKHR gfi{VK_STRUCTURE_TYPE_MEMORY_GET_FD_INFO_KHR};
-        gfi.memory = f.dmabuf_mem;
+        gfi.memory = f.memory;
         gfi.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT;
-        if (get_fd(ctx_->device, &gfi, &f.dmabuf_fd) != VK_SUCCESS || f.dmabuf_fd < 0) {
+        if (get_memory_fd_(ctx_->device, &gfi, &f.dmabuf_fd) != VK_SUCCESS || f.dmabuf_fd < 0) {
             PresenterLog("wibblewobble: dmabuf export failed");
             return false;
         }
-        VkImageSubresource sr{VK_IMAGE_ASPECT_COLOR_BIT, 0, 0};
-        VkSubresourceLayout layout{};
-        vkGetImageSubresourceLayout(ctx_->device, f.dmabuf_img, &sr, &layout);
-        f.stride = (uint32_t)layout.rowPitch;
+
+        VkFramebufferCreateInfo fbi{VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO};
+        fbi.renderPass = render_pass_;
+        fbi.attachmentCount = 1;
+        fbi.pAttachments = &f.view;
+        fbi.width = extent_.width;
+        fbi.height = extent_.height;
+        fbi.layers = 1;
+        if (vkCreateFramebuffer(ctx_->device, &fbi, nullptr, &f.framebuffer) != VK_SUCCESS)
+            return false;
 
         vkAllocateCommandBuffers(ctx_->device, &cbai, &f.cmd);
         VkFenceCreateInfo fci{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
         fci.flags = VK_FENCE_CREATE_SIGNALED_BIT;
         vkCreateFence(ctx_->device, &fci, nullptr, &f.fence);
     }
+    next_ = 0;
+    return true;
+}
+
+bool WibbleWobblePresenter::RegisterFrames()
+{
+    // XRGB8888 <- B8G8R8A8_UNORM. Re-declaring the format drops anything
+    // registered under a previous modifier.
+    p_setfmt_(ww_, source_format_, extent_.width, extent_.height,
+              DRM_FORMAT_XRGB8888, modifier_);
+    for (int i = 0; i < kRing; ++i) {
+        const Frame& f = frames_[i];
+        int idx;
+        if (f.planes == 1) {
+            idx = p_regbuf_(ww_, f.dmabuf_fd, f.strides[0], f.offsets[0], f.sizes[0]);
+        } else {
+            // All planes live in the one dedicated allocation.
+            const int fds[4] = {f.dmabuf_fd, f.dmabuf_fd, f.dmabuf_fd, f.dmabuf_fd};
+            idx = p_regplanes_(ww_, (int)f.planes, fds, f.strides, f.offsets, f.sizes);
+        }
+        if (idx < 0)
+            return false;
+        if (idx != i)
+            PresenterLog("wibblewobble: buffer %d registered as %d", i, idx);
+    }
     return true;
 }
 
@@ -232,6 +358,8 @@ bool WibbleWobblePresenter::PumpEvents()
 
 bool WibbleWobblePresenter::AcquireNext(FrameTarget* out, VkSemaphore signal_sem)
 {
+    if (frames_.empty())
+        return false;  // a profile switch failed to rebuild the ring
     // Round-robin, skipping buffers wwserver still holds.
     int chosen = -1;
     for (int t = 0; t < kRing; ++t) {
@@ -243,7 +371,7 @@ bool WibbleWobblePresenter::AcquireNext(FrameTarget* out, VkSemaphore signal_sem
     next_ = (chosen + 1) % kRing;
     Frame& f = frames_[chosen];
 
-    // Wait for our own prior blit on this slot to finish, then signal the
+    // Wait for our own prior release on this slot to finish, then signal the
     // renderer's acquire semaphore (our images are ready as soon as the fence
     // clears — but the binary semaphore still needs a queue signal).
     if (f.in_flight) {
@@ -258,61 +386,51 @@ bool WibbleWobblePresenter::AcquireNext(FrameTarget* out, VkSemaphore signal_sem
         vkQueueSubmit(ctx_->queue, 1, &sig, VK_NULL_HANDLE);
     }
 
-    out->image = f.render_img;
-    out->view = f.render_view;
+    out->image = f.image;
+    out->view = f.view;
     out->framebuffer = f.framebuffer;
     out->index = (uint32_t)chosen;
     return true;
 }
 
+bool WibbleWobblePresenter::TryAcquireNext(FrameTarget* out, VkSemaphore signal_sem)
+{
+    // As a mirror, don't overwrite a buffer wwserver is still reading.
+    for (int i = 0; i < (int)frames_.size(); ++i) {
+        if (!p_busy_(ww_, i))
+            return AcquireNext(out, signal_sem);
+    }
+    return false;
+}
+
 bool WibbleWobblePresenter::Present(uint32_t image_index, VkSemaphore wait_sem)
 {
     Frame& f = frames_[image_index];
 
-    // Blit the just-rendered SbS (TRANSFER_SRC after the render pass) into the
-    // linear dmabuf, waiting on the repack's render semaphore (consumes it).
+    // The repack rendered straight into the exported image; all that is left
+    // is handing it to the importing process (wwserver) in GENERAL, waiting
+    // on the repack's render semaphore (consumes it). Implicit dmabuf sync
+    // orders the server's read after this.
     vkResetFences(ctx_->device, 1, &f.fence);
     vkResetCommandBuffer(f.cmd, 0);
     VkCommandBufferBeginInfo begin{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
     begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
     vkBeginCommandBuffer(f.cmd, &begin);
-
-    VkImageMemoryBarrier to_dst{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
-    to_dst.srcAccessMask = 0;
-    to_dst.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    to_dst.oldLayout = f.dmabuf_initialized ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_UNDEFINED;
-    to_dst.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    to_dst.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    to_dst.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    to_dst.image = f.dmabuf_img;
-    to_dst.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
-    vkCmdPipelineBarrier(f.cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                         0, 0, nullptr, 0, nullptr, 1, &to_dst);
-
-    VkImageCopy copy{};
-    copy.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
-    copy.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
-    copy.extent = {extent_.width, extent_.height, 1};
-    vkCmdCopyImage(f.cmd, f.render_img, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, f.dmabuf_img,
-                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy);
-
-    // Hand back to GENERAL so the importing process (wwserver) samples a
-    // well-defined layout; implicit dmabuf sync orders its read after this.
-    VkImageMemoryBarrier to_general{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
-    to_general.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    to_general.dstAccessMask = 0;
-    to_general.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    to_general.newLayout = VK_IMAGE_LAYOUT_GENERAL;
-    to_general.srcQueueFamilyIndex = ctx_->queue_family;
-    to_general.dstQueueFamilyIndex = VK_QUEUE_FAMILY_EXTERNAL;
-    to_general.image = f.dmabuf_img;
-    to_general.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
-    vkCmdPipelineBarrier(f.cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-                         0, 0, nullptr, 0, nullptr, 1, &to_general);
+    VkImageMemoryBarrier release{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+    release.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    release.dstAccessMask = 0;
+    release.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    release.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    release.srcQueueFamilyIndex = ctx_->queue_family;
+    release.dstQueueFamilyIndex = VK_QUEUE_FAMILY_EXTERNAL;
+    release.image = f.image;
+    release.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    vkCmdPipelineBarrier(f.cmd, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                         VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr,
+                         1, &release);
     vkEndCommandBuffer(f.cmd);
-    f.dmabuf_initialized = true;
 
-    VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
     VkSubmitInfo submit{VK_STRUCTURE_TYPE_SUBMIT_INFO};
     submit.waitSemaphoreCount = 1;
     submit.pWaitSemaphores = &wait_sem;
@@ -335,12 +453,11 @@ void WibbleWobblePresenter::DestroyFrames()
 {
     for (auto& f : frames_) {
         if (f.fence) vkDestroyFence(ctx_->device, f.fence, nullptr);
+        if (f.cmd) vkFreeCommandBuffers(ctx_->device, cmd_pool_, 1, &f.cmd);
         if (f.framebuffer) vkDestroyFramebuffer(ctx_->device, f.framebuffer, nullptr);
-        if (f.render_view) vkDestroyImageView(ctx_->device, f.render_view, nullptr);
-        if (f.render_img) vkDestroyImage(ctx_->device, f.render_img, nullptr);
-        if (f.render_mem) vkFreeMemory(ctx_->device, f.render_mem, nullptr);
-        if (f.dmabuf_img) vkDestroyImage(ctx_->device, f.dmabuf_img, nullptr);
-        if (f.dmabuf_mem) vkFreeMemory(ctx_->device, f.dmabuf_mem, nullptr);
+        if (f.view) vkDestroyImageView(ctx_->device, f.view, nullptr);
+        if (f.image) vkDestroyImage(ctx_->device, f.image, nullptr);
+        if (f.memory) vkFreeMemory(ctx_->device, f.memory, nullptr);
         // dmabuf_fd ownership passed to libwwclient (it dup'd); close ours.
         if (f.dmabuf_fd >= 0) close(f.dmabuf_fd);
     }
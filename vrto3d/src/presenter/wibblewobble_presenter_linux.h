@@ -19,9 +19,22 @@
 // Linux WibbleWobble output: instead of presenting to a local display, hand the
 // composited side-by-side frame to a running WibbleWobbleLinux server
 // (wwserver) over libwwclient, which does the frame-sequential presentation +
-// shutter-glasses sync. VRto3D's repack pass renders the canonical SbS into a
-// ring of exportable dmabuf images (this presenter's FrameTargets); Present()
-// blits into a linear dmabuf and announces it to wwserver as WWSF_SideBySideFull.
+// shutter-glasses sync. VRto3D's repack pass renders the canonical SbS
+// straight into a ring of exportable dmabuf images (this presenter's
+// FrameTargets), allocated with a DRM format modifier so the GPU renders and
+// wwserver samples in the driver's native tiling. Present() only releases the
+// image to the external queue and announces it to wwserver.
+//
+// The profile's ww_source key picks the source format: "full" (default, 2W x H
+// WWSF_SideBySideFull), "half" (W x H WWSF_SideBySideHalf, each eye squeezed
+// to half width) or "checkerboard" (W x H WWSF_Checkerboard, eyes alternating
+// per pixel). The repack writes the packing directly, so the smaller formats
+// halve the buffers, the GPU's writes and wwserver's sampling.
+//
+// The modifier is the driver's pick among the renderable, exportable ones.
+// libwwclient can't report what wwserver imports, so a rejected registration
+// falls back to DRM_FORMAT_MOD_LINEAR; driver_vrto3d/wibblewobble_linear
+// forces that.
 //
 // libwwclient is dlopen'd — if WibbleWobbleLinux isn't installed, Init fails
 // gracefully (the driver logs and the output mode is inert).
@@ -32,6 +45,8 @@
 #include <vulkan/vulkan.h>
 
 #include "presenter/vk_presenter.h"
+#include "presenter/wwclient.h"  // WWSF_* format constants
+#include "vk/vk_context.h"
 
 namespace vrto3d {
 
@@ -43,40 +58,55 @@ public:
     void Shutdown() override;
     bool PumpEvents() override;
     bool AcquireNext(FrameTarget* out, VkSemaphore signal_sem) override;
+    bool TryAcquireNext(FrameTarget* out, VkSemaphore signal_sem) override;
     bool Present(uint32_t image_index, VkSemaphore wait_sem) override;
 
     VkRenderPass RenderPass() const override { return render_pass_; }
     VkExtent2D   Extent() const override { return extent_; }
     VkFormat     Format() const override { return format_; }
     const char*  Name() const override { return "wibblewobble"; }
+    OutputMode   RepackMode(OutputMode configured) const override;
+    // ww_source: rebuilds and re-registers the ring when it changes.
+    void         ApplyProfile(const OutputProfileOptions& opts) override;
 
 private:
     struct Frame {
-        // Render target the repack pass draws the SbS into (OPTIMAL).
-        VkImage        render_img = VK_NULL_HANDLE;
-        VkDeviceMemory render_mem = VK_NULL_HANDLE;
-        VkImageView    render_view = VK_NULL_HANDLE;
+        // Exportable, modifier-tiled image the repack pass draws the SbS into
+        // and wwserver imports.
+        VkImage        image = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkImageView    view = VK_NULL_HANDLE;
         VkFramebuffer  framebuffer = VK_NULL_HANDLE;
-        // Exportable linear dmabuf handed to wwserver.
-        VkImage        dmabuf_img = VK_NULL_HANDLE;
-        VkDeviceMemory dmabuf_mem = VK_NULL_HANDLE;
         int            dmabuf_fd = -1;
-        uint32_t       stride = 0;
-        bool           dmabuf_initialized = false;  // layout tracking for blit
-        VkCommandBuffer cmd = VK_NULL_HANDLE;        // blit + acquire-signal
+        uint32_t       planes = 1;
+        uint32_t       strides[4] = {};
+        uint32_t       offsets[4] = {};
+        uint64_t       sizes[4] = {};
+        VkCommandBuffer cmd = VK_NULL_HANDLE;        // external release
         VkFence        fence = VK_NULL_HANDLE;
         bool           in_flight = false;
     };
+    using Modifier = vrto3d::vk::DrmModifier;
 
     bool LoadClient();
-    bool CreateFrames();
+    // Sizes extent_ for source_format_, then creates and registers the ring
+    // (falling back to linear if wwserver rejects the tiled layout).
+    bool BuildRing();
+    std::vector<Modifier> RenderableModifiers() const;
+    bool CreateFrames(const std::vector<Modifier>& candidates);
+    bool RegisterFrames();
     void DestroyFrames();
 
     vrto3d::vk::DeviceCtx* ctx_ = nullptr;
     VkExtent2D  extent_{};
+    VkExtent2D  full_extent_{};  // full SbS; extent_ halves it for half/checkerboard
     VkFormat    format_ = VK_FORMAT_B8G8R8A8_UNORM;
     VkRenderPass render_pass_ = VK_NULL_HANDLE;
     VkCommandPool cmd_pool_ = VK_NULL_HANDLE;
+    int         source_format_ = WWSF_SIDE_BY_SIDE_FULL;
+    uint64_t    modifier_ = 0;  // DRM_FORMAT_MOD_* of the current ring
+    PFN_vkGetMemoryFdKHR get_memory_fd_ = nullptr;
+    PFN_vkGetImageDrmFormatModifierPropertiesEXT get_image_modifier_ = nullptr;
 
     static constexpr int kRing = 3;
     std::vector<Frame> frames_;
@@ -92,6 +122,9 @@ private:
     void  (*p_destroy_)(void*) = nullptr;
     void  (*p_setfmt_)(void*, int, uint32_t, uint32_t, uint32_t, uint64_t) = nullptr;
     int   (*p_regbuf_)(void*, int, uint32_t, uint32_t, uint64_t) = nullptr;
+    // optional (older libwwclient): without it only single-plane modifiers
+    int   (*p_regplanes_)(void*, int, const int*, const uint32_t*, const uint32_t*,
+                          const uint64_t*) = nullptr;
     int   (*p_present_)(void*, int, uint64_t) = nullptr;
     int   (*p_busy_)(void*, int) = nullptr;
 };
@@ -25,6 +25,7 @@
 
 #include "dx11_renderer.h"
 #include "focus_policy.h"
+#include "process_watch.h"
 #include "hmd_device_driver.h"
 #include "vrto3dlib/debug_log.hpp"
 #include "vrto3dlib/win32_helper.hpp"
@@ -839,7 +840,7 @@ void WindowPresenter::FocusThreadLoop()
             nudged = true;
         }
 
-        const bool app_running = platform::IsProcessRunning(pid);
+        const bool app_running = vrto3d::ProcessWatch::Instance().IsRunning(pid);
 
         // Shared decision (see focus_policy.h) — kept identical to the Linux
         // VkRenderer focus block so the two can't drift.
@@ -15,6 +15,7 @@
  * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
  */
 #include "presenter/x11_modeline.h"
+#include "presenter/frame_pack_mode.h"
 
 #include <X11/Xlib.h>
 #include <X11/extensions/Xrandr.h>
@@ -93,8 +94,7 @@ bool ApplyFramePackedModeX11(void* xdisplay, int32_t display_index,
     state.prev_y = crtc_info->y;
     state.prev_rotation = crtc_info->rotation;
 
-    const unsigned long dot_clock =
-        (unsigned long)spec.h_total * spec.v_total * (unsigned long)(spec.refresh_hz + 0.5f);
+    const unsigned long dot_clock = (unsigned long)FramePackDotClock(spec);
 
     // Reuse an existing mode with matching geometry + clock if present
     // (e.g. from a previous run that didn't clean up).
@@ -17,12 +17,16 @@
 #include "presenter/x11_presenter.h"
 #include "presenter/x11_modeline.h"
 
+#include <cmath>
+#include <cstdio>
 #include <cstring>
+#include <initializer_list>
 #include <mutex>
 
 #include <X11/Xlib.h>
 #include <X11/Xatom.h>
 #include <X11/Xutil.h>
+#include <X11/extensions/Xpresent.h>
 #include <X11/extensions/Xrandr.h>
 #include <X11/extensions/shape.h>
 
@@ -30,6 +34,9 @@
 #include <vulkan/vulkan.h>
 #include <vulkan/vulkan_xlib.h>
 
+#include "driver_settings.h"
+#include "platform.h"
+
 namespace vrto3d {
 
 namespace {
@@ -50,6 +57,12 @@ constexpr unsigned long kMwmHintsDecorations = 1ul << 1;
 
 std::once_flag g_xinit_once;
 
+// Our presents awaiting a CompleteNotify. FIFO keeps two or three in
+// flight; more means completions stopped arriving (window unmapped).
+constexpr size_t kMaxPendingPresents = 8;
+// Completed timings kept for PopPresentTiming.
+constexpr size_t kMaxTimingsQueued = 64;
+
 }  // namespace
 
 
@@ -109,14 +122,15 @@ std::vector<X11Presenter::OutputGeom> X11Presenter::EnumerateOutputs() const
 }
 
 
-void X11Presenter::SendNetWmState(long action, unsigned long property, unsigned long property2) const
+void X11Presenter::SendNetWmState(unsigned long window, long action, unsigned long property,
+                                  unsigned long property2) const
 {
-    if (!dpy_ || !window_) return;
+    if (!dpy_ || !window) return;
     Display* dpy = dpy_;
 
     XEvent ev{};
     ev.xclient.type         = ClientMessage;
-    ev.xclient.window       = static_cast<Window>(window_);
+    ev.xclient.window       = static_cast<Window>(window);
     ev.xclient.message_type = XInternAtom(dpy, "_NET_WM_STATE", False);
     ev.xclient.format       = 32;
     ev.xclient.data.l[0]    = action;
@@ -208,8 +222,16 @@ bool X11Presenter::Init(vrto3d::vk::DeviceCtx* ctx, const StereoDisplayDriverCon
         }
     }
 
-    width_  = chosen->width + (secondary ? secondary->width : 0);
+    // Lockstep: one window + swapchain per output, both presented by one
+    // vkQueuePresentKHR so each eye gets its monitor at native resolution
+    // with matching timing. driver_vrto3d/dual_swapchain set to false keeps
+    // the single window spanning both (one swapchain whose flip can only
+    // follow one CRTC).
+    const bool lockstep = secondary && DriverSettingBool("dual_swapchain", true);
+
+    width_  = chosen->width + (secondary && !lockstep ? secondary->width : 0);
     height_ = chosen->height;
+    float refresh_hz = chosen->refresh_hz;
 
     // Frame-packed output: switch the target output to the HDMI 1.4 custom
     // timing at runtime (the Linux analog of the NVAPI/CRU path). Restored in
@@ -220,15 +242,80 @@ bool X11Presenter::Init(vrto3d::vk::DeviceCtx* ctx, const StereoDisplayDriverCon
         if (ApplyFramePackedModeX11(dpy, cfg.display_index, *spec, modeline_state_)) {
             width_ = spec->active_w;
             height_ = spec->active_h;
+            refresh_hz = spec->refresh_hz;
         }
     }
 
     PresenterLog("X11Presenter: output '%s' %ux%u+%d+%d @%.2fHz%s (display_index=%d)",
                  chosen->name.c_str(), width_, height_, chosen->x, chosen->y,
-                 chosen->refresh_hz, secondary ? " (spanning two outputs)" : "",
+                 chosen->refresh_hz,
+                 !secondary ? "" : lockstep ? " (left eye; right eye on its neighbor)"
+                                            : " (spanning two outputs)",
                  cfg.display_index);
 
-    // --- Window creation --------------------------------------------------
+    window_ = CreateOutputWindow(chosen->x, chosen->y, width_, height_);
+    if (!window_) {
+        Shutdown();
+        return false;
+    }
+    if (secondary && lockstep) {
+        width2_  = secondary->width;
+        height2_ = secondary->height;
+        window2_ = CreateOutputWindow(secondary->x, secondary->y, width2_, height2_);
+        if (!window2_) {
+            PresenterLog("X11Presenter: no window for '%s' — right eye output disabled",
+                         secondary->name.c_str());
+        }
+    }
+    Window win = static_cast<Window>(window_);
+
+    // Completion events for every present on the window. Without Present
+    // (Xvfb, some remote servers) the renderer keeps its submit-time vsync.
+    // In lockstep both windows flip from one vkQueuePresentKHR, so the left
+    // eye's completions stand for the pair.
+    int present_event = 0, present_error = 0;
+    if (XPresentQueryExtension(dpy, &present_opcode_, &present_event, &present_error)) {
+        present_eid_ = XPresentSelectInput(dpy, win, PresentCompleteNotifyMask);
+        refresh_period_ = refresh_hz > 0.0f ? 1.0 / refresh_hz : 0.0;
+        composited_ = CompositorRunning();
+    } else {
+        PresenterLog("X11Presenter: no Present extension — no presentation feedback");
+    }
+
+    if (secondary && !lockstep) {
+        SendFullscreenMonitors(*chosen, *secondary);
+    }
+    XFlush(dpy);
+
+    // --- Vulkan surface + swapchain ----------------------------------------
+    VkXlibSurfaceCreateInfoKHR sci{ VK_STRUCTURE_TYPE_XLIB_SURFACE_CREATE_INFO_KHR };
+    sci.dpy    = dpy;
+    sci.window = win;
+    VkResult r = vkCreateXlibSurfaceKHR(ctx_->instance, &sci, nullptr, &vk_surface_);
+    if (r != VK_SUCCESS) {
+        PresenterLog("X11Presenter: vkCreateXlibSurfaceKHR failed (r=%d)", static_cast<int>(r));
+        Shutdown();
+        return false;
+    }
+
+    if (!swapchain_.Create(ctx_, vk_surface_, width_, height_)) {
+        Shutdown();
+        return false;
+    }
+
+    if (window2_) {
+        InitSecondarySwapchain();
+    }
+
+    PresenterLog("X11Presenter: up, %ux%u%s", swapchain_.extent.width, swapchain_.extent.height,
+                 secondary_.ctx ? " + right eye swapchain (lockstep present)" : "");
+    return true;
+}
+
+
+unsigned long X11Presenter::CreateOutputWindow(int32_t x, int32_t y, uint32_t width, uint32_t height)
+{
+    Display* dpy = dpy_;
     Window root = DefaultRootWindow(dpy);
     const int screen = DefaultScreen(dpy);
 
@@ -238,17 +325,15 @@ bool X11Presenter::Init(vrto3d::vk::DeviceCtx* ctx, const StereoDisplayDriverCon
     attrs.event_mask       = StructureNotifyMask;
     attrs.override_redirect = False;
 
-    Window win = XCreateWindow(dpy, root, chosen->x, chosen->y, width_, height_, 0,
+    Window win = XCreateWindow(dpy, root, x, y, width, height, 0,
                                CopyFromParent, InputOutput,
                                reinterpret_cast<Visual*>(CopyFromParent),
                                CWBackPixel | CWBorderPixel | CWEventMask | CWOverrideRedirect,
                                &attrs);
     if (!win) {
         PresenterLog("X11Presenter: XCreateWindow failed");
-        Shutdown();
-        return false;
+        return 0;
     }
-    window_ = static_cast<unsigned long>(win);
 
     // EWMH state BEFORE mapping — compliant WMs read the property at map time.
     Atom net_wm_state      = XInternAtom(dpy, "_NET_WM_STATE", False);
@@ -271,10 +356,10 @@ bool X11Presenter::Init(vrto3d::vk::DeviceCtx* ctx, const StereoDisplayDriverCon
     XSizeHints* size_hints = XAllocSizeHints();
     if (size_hints) {
         size_hints->flags = USPosition | USSize | PPosition | PSize;
-        size_hints->x = chosen->x;
-        size_hints->y = chosen->y;
-        size_hints->width  = static_cast<int>(width_);
-        size_hints->height = static_cast<int>(height_);
+        size_hints->x = x;
+        size_hints->y = y;
+        size_hints->width  = static_cast<int>(width);
+        size_hints->height = static_cast<int>(height);
         XSetWMNormalHints(dpy, win, size_hints);
         XFree(size_hints);
     }
@@ -317,47 +402,61 @@ bool X11Presenter::Init(vrto3d::vk::DeviceCtx* ctx, const StereoDisplayDriverCon
 
     // Move first, then (re-)assert fullscreen for running WMs: moving after
     // map beats WMs that snap fullscreen windows to the pointer's monitor.
-    XMoveResizeWindow(dpy, win, chosen->x, chosen->y, width_, height_);
-    SendNetWmState(kNetWmStateAdd, state_fullscreen, state_above);
-    if (secondary) {
-        SendFullscreenMonitors(*chosen, *secondary);
-    }
+    XMoveResizeWindow(dpy, win, x, y, width, height);
+    SendNetWmState(win, kNetWmStateAdd, state_fullscreen, state_above);
     XRaiseWindow(dpy, win);
     XFlush(dpy);
+    return static_cast<unsigned long>(win);
+}
 
-    // --- Vulkan surface + swapchain ----------------------------------------
-    VkXlibSurfaceCreateInfoKHR sci{ VK_STRUCTURE_TYPE_XLIB_SURFACE_CREATE_INFO_KHR };
-    sci.dpy    = dpy;
-    sci.window = win;
-    VkResult r = vkCreateXlibSurfaceKHR(ctx_->instance, &sci, nullptr, &vk_surface_);
-    if (r != VK_SUCCESS) {
-        PresenterLog("X11Presenter: vkCreateXlibSurfaceKHR failed (r=%d)", static_cast<int>(r));
-        Shutdown();
-        return false;
-    }
 
-    if (!swapchain_.Create(ctx_, vk_surface_, width_, height_)) {
-        Shutdown();
-        return false;
+void X11Presenter::InitSecondarySwapchain()
+{
+    VkXlibSurfaceCreateInfoKHR sci{ VK_STRUCTURE_TYPE_XLIB_SURFACE_CREATE_INFO_KHR };
+    sci.dpy    = dpy_;
+    sci.window = static_cast<Window>(window2_);
+    VkResult r = vkCreateXlibSurfaceKHR(ctx_->instance, &sci, nullptr, &vk_surface2_);
+    if (r == VK_SUCCESS && secondary_.Create(ctx_, vk_surface2_, width2_, height2_)
+        && secondary_.format == swapchain_.format) {
+        return;
     }
-
-    PresenterLog("X11Presenter: up, %ux%u", swapchain_.extent.width, swapchain_.extent.height);
-    return true;
+    // Without a second swapchain of the same format (one render pass serves
+    // both) the left eye's window carries the whole side-by-side frame.
+    PresenterLog("X11Presenter: right eye swapchain unavailable (r=%d, format %d vs %d) — "
+                 "left output shows both eyes", static_cast<int>(r),
+                 static_cast<int>(secondary_.format), static_cast<int>(swapchain_.format));
+    if (secondary_.ctx) secondary_.Destroy();
+    if (vk_surface2_ != VK_NULL_HANDLE) vkDestroySurfaceKHR(ctx_->instance, vk_surface2_, nullptr);
+    vk_surface2_ = VK_NULL_HANDLE;
+    XDestroyWindow(dpy_, static_cast<Window>(window2_));
+    window2_ = 0;
 }
 
 
 void X11Presenter::Shutdown()
 {
+    if (secondary_.ctx) {
+        secondary_.Destroy();
+    }
     if (swapchain_.ctx) {
         swapchain_.Destroy();
     }
-    if (vk_surface_ != VK_NULL_HANDLE && ctx_ && ctx_->instance != VK_NULL_HANDLE) {
-        vkDestroySurfaceKHR(ctx_->instance, vk_surface_, nullptr);
+    if (ctx_ && ctx_->instance != VK_NULL_HANDLE) {
+        if (vk_surface2_ != VK_NULL_HANDLE) vkDestroySurfaceKHR(ctx_->instance, vk_surface2_, nullptr);
+        if (vk_surface_ != VK_NULL_HANDLE) vkDestroySurfaceKHR(ctx_->instance, vk_surface_, nullptr);
     }
     vk_surface_ = VK_NULL_HANDLE;
+    vk_surface2_ = VK_NULL_HANDLE;
 
     if (dpy_) {
         RestoreModeX11(dpy_, modeline_state_);
+        if (present_eid_ && window_) {
+            XPresentFreeInput(dpy_, static_cast<Window>(window_), present_eid_);
+        }
+        if (window2_) {
+            XDestroyWindow(dpy_, static_cast<Window>(window2_));
+            window2_ = 0;
+        }
         if (window_) {
             XDestroyWindow(dpy_, static_cast<Window>(window_));
             window_ = 0;
@@ -366,6 +465,12 @@ void X11Presenter::Shutdown()
         dpy_ = nullptr;
     }
     closed_ = false;
+    present_eid_ = 0;
+    pending_.clear();
+    timings_.clear();
+    last_msc_ = 0;
+    last_ust_ = 0;
+    flipping_ = false;
     ctx_ = nullptr;
 }
 
@@ -388,6 +493,13 @@ bool X11Presenter::PumpEvents()
                     width_  = static_cast<uint32_t>(c.width);
                     height_ = static_cast<uint32_t>(c.height);
                     swapchain_.SetDesiredExtent(width_, height_);
+                } else if (window2_ && c.window == static_cast<Window>(window2_)
+                           && c.width > 0 && c.height > 0
+                           && (static_cast<uint32_t>(c.width) != width2_
+                               || static_cast<uint32_t>(c.height) != height2_)) {
+                    width2_  = static_cast<uint32_t>(c.width);
+                    height2_ = static_cast<uint32_t>(c.height);
+                    secondary_.SetDesiredExtent(width2_, height2_);
                 }
                 break;
             }
@@ -399,11 +511,23 @@ bool X11Presenter::PumpEvents()
                 break;
             }
             case DestroyNotify: {
-                if (ev.xdestroywindow.window == static_cast<Window>(window_)) {
+                if (ev.xdestroywindow.window == static_cast<Window>(window_)
+                    || (window2_ && ev.xdestroywindow.window == static_cast<Window>(window2_))) {
                     closed_ = true;
                 }
                 break;
             }
+            case GenericEvent: {
+                XGenericEventCookie* cookie = &ev.xcookie;
+                if (present_eid_ && cookie->extension == present_opcode_
+                    && XGetEventData(dpy, cookie)) {
+                    if (cookie->evtype == PresentCompleteNotify) {
+                        OnPresentComplete(cookie->data);
+                    }
+                    XFreeEventData(dpy, cookie);
+                }
+                break;
+            }
             default:
                 break;
         }
@@ -412,16 +536,151 @@ bool X11Presenter::PumpEvents()
 }
 
 
-// AcquireNext / Present / RenderPass / Extent / Format inherited from
-// SwapchainPresenterBase (delegate to swapchain_).
+int X11Presenter::EventFd() const
+{
+    return dpy_ ? ConnectionNumber(dpy_) : -1;
+}
+
+
+bool X11Presenter::PrepareEventWait()
+{
+    if (!dpy_ || closed_) return false;
+    // Xlib may already have read events into its queue (any reply wait
+    // does); those never show up on the socket again.
+    XFlush(dpy_);
+    return XEventsQueued(dpy_, QueuedAlready) == 0;
+}
+
+
+template <typename PresentFn>
+bool X11Presenter::TrackedPresent(PresentFn&& present)
+{
+    if (!present_eid_) {
+        return present();
+    }
+
+    PresentTiming t;
+    t.frame_id = ++next_frame_id_;
+    t.submit_time = platform::MonotonicSeconds();
+    if (pending_.size() >= kMaxPendingPresents) pending_.pop_front();
+    pending_.push_back(t);
+
+    const bool recreate_before = swapchain_.needs_recreate;
+    const bool ok = present();
+    // An out-of-date present may never reach the server, which would shift
+    // every later match by one. Forget the backlog; completions of presents
+    // dropped here are recognised by their UST predating the next submit.
+    if (!ok || (!recreate_before && swapchain_.needs_recreate)) {
+        pending_.clear();
+    }
+    return ok;
+}
+
+
+bool X11Presenter::Present(uint32_t image_index, VkSemaphore wait_sem)
+{
+    return TrackedPresent([&] { return swapchain_.Present(image_index, wait_sem); });
+}
+
+
+bool X11Presenter::PresentTargets(const FrameTarget* targets, VkSemaphore wait_sem)
+{
+    if (!secondary_.ctx || targets[1].framebuffer == VK_NULL_HANDLE) {
+        return Present(targets[0].index, wait_sem);
+    }
+    return TrackedPresent([&] { return SwapchainPresenterBase::PresentTargets(targets, wait_sem); });
+}
+
+
+void X11Presenter::OnPresentComplete(const void* event)
+{
+    const auto* ce = static_cast<const XPresentCompleteNotifyEvent*>(event);
+    if (ce->kind != PresentCompleteKindPixmap || pending_.empty()) return;
+
+    // UST is CLOCK_MONOTONIC microseconds from the vblank event.
+    const double ust_sec = static_cast<double>(ce->ust) * 1e-6;
+    if (ust_sec < pending_.front().submit_time) return;  // a present we stopped tracking
+
+    PresentTiming t = pending_.front();
+    pending_.pop_front();
+
+    if (ce->mode == PresentCompleteModeSkip) {
+        t.discarded = true;
+    } else {
+        if (last_msc_ != 0 && ce->msc > last_msc_ && ce->ust > last_ust_) {
+            const double period = static_cast<double>(ce->ust - last_ust_) * 1e-6
+                                  / static_cast<double>(ce->msc - last_msc_);
+            // Ignore gaps across a mode change or a suspended output.
+            if (refresh_period_ <= 0.0 || std::fabs(period - refresh_period_) < refresh_period_ * 0.1) {
+                refresh_period_ = refresh_period_ > 0.0 ? refresh_period_ + (period - refresh_period_) / 16.0
+                                                        : period;
+            }
+        }
+        last_msc_ = ce->msc;
+        last_ust_ = ce->ust;
+
+        const bool flip = ce->mode == PresentCompleteModeFlip;
+        if (flip != flipping_) {
+            flipping_ = flip;
+            if (!flip) composited_ = CompositorRunning();
+            PresenterLog("X11Presenter: %s", flip ? "presents flip to scanout"
+                         : composited_ ? "presents copied into a compositor's window pixmap"
+                                       : "presents copied to the screen");
+        }
+
+        t.presented_time = ust_sec;
+        t.msc = ce->msc;
+        t.refresh_period = refresh_period_;
+        t.flags = kPresentVsync | kPresentHwClock;
+        if (flip) {
+            t.flags |= kPresentZeroCopy | kPresentHwCompletion;
+        } else if (composited_) {
+            // A redirected window's copy completes into the compositor's
+            // pixmap; picom & co. put it on screen with their next repaint,
+            // one refresh later at the earliest. Count that vblank instead
+            // of the copy so latency and repeat counts reflect the glass.
+            t.presented_time += refresh_period_;
+            t.msc += 1;
+            t.flags &= ~static_cast<uint32_t>(kPresentHwClock);
+        }
+    }
+
+    if (timings_.size() >= kMaxTimingsQueued) timings_.pop_front();
+    timings_.push_back(t);
+}
+
+
+bool X11Presenter::PopPresentTiming(PresentTiming* out)
+{
+    if (timings_.empty()) return false;
+    *out = timings_.front();
+    timings_.pop_front();
+    return true;
+}
+
+
+bool X11Presenter::CompositorRunning() const
+{
+    if (!dpy_) return false;
+    char name[32];
+    std::snprintf(name, sizeof(name), "_NET_WM_CM_S%d", DefaultScreen(dpy_));
+    return XGetSelectionOwner(dpy_, XInternAtom(dpy_, name, False)) != 0;
+}
+
+
+// AcquireNext / AcquireTargets / RenderPass / Extent / Format inherited from
+// SwapchainPresenterBase (delegate to swapchain_ and secondary_).
 
 
 void X11Presenter::BringToTop()
 {
     if (!dpy_ || !window_) return;
-    SendNetWmState(kNetWmStateAdd,
-                   XInternAtom(dpy_, "_NET_WM_STATE_ABOVE", False), 0);
-    XRaiseWindow(dpy_, static_cast<Window>(window_));
+    const Atom above = XInternAtom(dpy_, "_NET_WM_STATE_ABOVE", False);
+    for (unsigned long window : {window_, window2_}) {
+        if (!window) continue;
+        SendNetWmState(window, kNetWmStateAdd, above, 0);
+        XRaiseWindow(dpy_, static_cast<Window>(window));
+    }
     XFlush(dpy_);
 }
 
@@ -429,48 +688,77 @@ void X11Presenter::SetAlwaysOnTop(bool on_top)
 {
     if (!dpy_ || !window_) return;
     Atom above = XInternAtom(dpy_, "_NET_WM_STATE_ABOVE", False);
-    if (on_top) {
-        SendNetWmState(kNetWmStateAdd, above, 0);
-        XRaiseWindow(dpy_, static_cast<Window>(window_));
-        // Belt-and-braces for KDE: a plain XRaiseWindow from a buried, non-
-        // focusable background window can be swallowed by KWin's focus-stealing
-        // prevention, leaving the overlay stuck behind the desktop. A
-        // _NET_ACTIVE_WINDOW request with source=pager (2) bypasses that and
-        // forces the stack change; input=False means it still can't grab the
-        // keyboard away from the game.
-        Window w = static_cast<Window>(window_);
-        XEvent act{};
-        act.xclient.type         = ClientMessage;
-        act.xclient.window       = w;
-        act.xclient.message_type = XInternAtom(dpy_, "_NET_ACTIVE_WINDOW", False);
-        act.xclient.format       = 32;
-        act.xclient.data.l[0]    = 2;   // source indication: pager
-        act.xclient.data.l[1]    = 0;   // timestamp (0 = CurrentTime)
-        XSendEvent(dpy_, DefaultRootWindow(dpy_), False,
-                   SubstructureRedirectMask | SubstructureNotifyMask, &act);
-    } else {
-        // Drop behind normal windows so the flat game shows through. Surface
-        // stays mapped/presentable — we keep rendering behind it.
-        SendNetWmState(kNetWmStateRemove, above, 0);
-        XLowerWindow(dpy_, static_cast<Window>(window_));
+    for (unsigned long window : {window_, window2_}) {
+        if (!window) continue;
+        Window w = static_cast<Window>(window);
+        if (on_top) {
+            SendNetWmState(window, kNetWmStateAdd, above, 0);
+            XRaiseWindow(dpy_, w);
+            // Belt-and-braces for KDE: a plain XRaiseWindow from a buried, non-
+            // focusable background window can be swallowed by KWin's focus-stealing
+            // prevention, leaving the overlay stuck behind the desktop. A
+            // _NET_ACTIVE_WINDOW request with source=pager (2) bypasses that and
+            // forces the stack change; input=False means it still can't grab the
+            // keyboard away from the game.
+            XEvent act{};
+            act.xclient.type         = ClientMessage;
+            act.xclient.window       = w;
+            act.xclient.message_type = XInternAtom(dpy_, "_NET_ACTIVE_WINDOW", False);
+            act.xclient.format       = 32;
+            act.xclient.data.l[0]    = 2;   // source indication: pager
+            act.xclient.data.l[1]    = 0;   // timestamp (0 = CurrentTime)
+            XSendEvent(dpy_, DefaultRootWindow(dpy_), False,
+                       SubstructureRedirectMask | SubstructureNotifyMask, &act);
+        } else {
+            // Drop behind normal windows so the flat game shows through. Surface
+            // stays mapped/presentable — we keep rendering behind it.
+            SendNetWmState(window, kNetWmStateRemove, above, 0);
+            XLowerWindow(dpy_, w);
+        }
+    }
+    XFlush(dpy_);
+}
+
+bool X11Presenter::SetVariableRefresh(bool enable)
+{
+    if (!dpy_ || !window_) return false;
+    // Read by the amdgpu/modesetting DDX when the window is flipped to
+    // scanout; a composited (copied) window never gets VRR.
+    Atom vrr = XInternAtom(dpy_, "_VARIABLE_REFRESH", False);
+    for (unsigned long window : {window_, window2_}) {
+        if (!window) continue;
+        if (enable) {
+            unsigned long one = 1;
+            XChangeProperty(dpy_, static_cast<Window>(window), vrr, XA_CARDINAL, 32,
+                            PropModeReplace, reinterpret_cast<unsigned char*>(&one), 1);
+        } else {
+            XDeleteProperty(dpy_, static_cast<Window>(window), vrr);
+        }
     }
     XFlush(dpy_);
+    return true;
 }
 
 void X11Presenter::SetInputCapture(bool capture)
 {
     if (!dpy_ || !window_ || !have_xshape_) return;
+    for (unsigned long window : {window_, window2_}) {
+        if (!window) continue;
+        if (capture) {
+            // Full input region — the overlay captures the pointer (game shielded
+            // from OSD clicks). None mask = reset to the default full-window shape.
+            XShapeCombineMask(dpy_, static_cast<Window>(window), ShapeInput, 0, 0, None, ShapeSet);
+        } else {
+            // Empty input region — click-through; pointer reaches the game.
+            XShapeCombineRectangles(dpy_, static_cast<Window>(window), ShapeInput, 0, 0, nullptr, 0,
+                                    ShapeSet, Unsorted);
+        }
+    }
     if (capture) {
-        // Full input region — the overlay captures the pointer (game shielded
-        // from OSD clicks). None mask = reset to the default full-window shape.
-        XShapeCombineMask(dpy_, static_cast<Window>(window_), ShapeInput, 0, 0, None, ShapeSet);
         // Take keyboard so OSD text entry doesn't leak to the game (input=False
         // hint keeps the WM from doing this automatically; force it directly).
         XSetInputFocus(dpy_, static_cast<Window>(window_), RevertToPointerRoot, CurrentTime);
     } else {
-        // Empty input region — click-through; pointer/keyboard reach the game.
-        XShapeCombineRectangles(dpy_, static_cast<Window>(window_), ShapeInput, 0, 0, nullptr, 0,
-                                ShapeSet, Unsorted);
         // Hand keyboard back; PointerRoot follows the pointer (over the game).
         XSetInputFocus(dpy_, PointerRoot, RevertToPointerRoot, CurrentTime);
     }
@@ -481,8 +769,10 @@ void X11Presenter::SetInputCapture(bool capture)
 void X11Presenter::ReleaseTopmost()
 {
     if (!dpy_ || !window_) return;
-    SendNetWmState(kNetWmStateRemove,
-                   XInternAtom(dpy_, "_NET_WM_STATE_ABOVE", False), 0);
+    const Atom above = XInternAtom(dpy_, "_NET_WM_STATE_ABOVE", False);
+    for (unsigned long window : {window_, window2_}) {
+        if (window) SendNetWmState(window, kNetWmStateRemove, above, 0);
+    }
     XFlush(dpy_);
 }
 
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <cstdint>
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -34,8 +35,15 @@ namespace vrto3d {
 // Xlib implementation of IVkPresenter: a borderless, topmost,
 // _NET_WM_STATE_FULLSCREEN window positioned on the XRandR output selected
 // by cfg.display_index (1-based connected-output order; 0 = the primary
-// output). DualDisplay/DualDisplayFlip span the chosen output plus its
-// contiguous right neighbor when one with identical geometry exists.
+// output). DualDisplay/DualDisplayFlip also use the chosen output's
+// contiguous right neighbor when one with identical geometry exists: each
+// output gets its own window and swapchain, presented together, or with
+// driver_vrto3d/dual_swapchain set to false a single window spans both.
+//
+// Presentation feedback comes from the Present extension: the window selects
+// PresentCompleteNotify, and each completion (UST/MSC from the kernel vblank)
+// is matched to our Present() calls in order. The WSI's own Present event
+// context is separate, so both see every completion on the window.
 class X11Presenter final : public SwapchainPresenterBase {
 public:
     X11Presenter() = default;
@@ -45,14 +53,21 @@ public:
     void Shutdown() override;
 
     bool PumpEvents() override;
-    // AcquireNext/Present/RenderPass/Extent/Format inherited from
-    // SwapchainPresenterBase (delegate to swapchain_).
+    int  EventFd() const override;
+    bool PrepareEventWait() override;
+    bool Present(uint32_t image_index, VkSemaphore wait_sem) override;
+    bool PresentTargets(const FrameTarget* targets, VkSemaphore wait_sem) override;
+    bool HasPresentTiming() const override { return present_eid_ != 0; }
+    bool PopPresentTiming(PresentTiming* out) override;
+    // AcquireNext/AcquireTargets/RenderPass/Extent/Format inherited from
+    // SwapchainPresenterBase (delegate to swapchain_ and secondary_).
     const char*  Name() const override { return "X11Presenter"; }
 
     void BringToTop() override;
     void ReleaseTopmost() override;
     void SetAlwaysOnTop(bool on_top) override;
     void SetInputCapture(bool capture) override;
+    bool SetVariableRefresh(bool enable) override;
 
 private:
     struct OutputGeom {
@@ -68,8 +83,20 @@ private:
 
     // Connected XRandR outputs in enumeration order.
     std::vector<OutputGeom> EnumerateOutputs() const;
-    void SendNetWmState(long action, unsigned long property, unsigned long property2) const;
+    // Borderless fullscreen overlay window at the given root geometry,
+    // mapped and raised; 0 on failure.
+    unsigned long CreateOutputWindow(int32_t x, int32_t y, uint32_t width, uint32_t height);
+    // Surface + secondary_ on window2_; tears window2_ down if that fails.
+    void InitSecondarySwapchain();
+    void SendNetWmState(unsigned long window, long action, unsigned long property,
+                        unsigned long property2) const;
     void SendFullscreenMonitors(const OutputGeom& left, const OutputGeom& right) const;
+    // Present() bookkeeping around one vkQueuePresentKHR.
+    template <typename PresentFn>
+    bool TrackedPresent(PresentFn&& present);
+    // XPresentCompleteNotifyEvent* (kept opaque, see _XDisplay above).
+    void OnPresentComplete(const void* event);
+    bool CompositorRunning() const;
 
     // ctx_ + swapchain_ live in SwapchainPresenterBase.
     _XDisplay*     dpy_ = nullptr;
@@ -82,6 +109,26 @@ private:
     bool           closed_ = false;
 
     VkSurfaceKHR    vk_surface_ = VK_NULL_HANDLE;
+
+    // DualDisplay lockstep: the right eye's window on the neighbor output,
+    // presented through secondary_ together with window_ (0 = not in use).
+    unsigned long  window2_ = 0;
+    uint32_t       width2_ = 0;
+    uint32_t       height2_ = 0;
+    VkSurfaceKHR   vk_surface2_ = VK_NULL_HANDLE;
+
+    // Present-extension feedback. pending_ holds our submitted presents
+    // until their CompleteNotify arrives; timings_ the finished results.
+    int            present_opcode_ = 0;
+    unsigned long  present_eid_ = 0;      // XID of our event context; 0 = no Present
+    std::deque<PresentTiming> pending_;
+    std::deque<PresentTiming> timings_;
+    uint64_t       next_frame_id_ = 0;
+    uint64_t       last_msc_ = 0;
+    uint64_t       last_ust_ = 0;
+    double         refresh_period_ = 0.0;
+    bool           flipping_ = false;
+    bool           composited_ = false;   // a compositing manager owns _NET_WM_CM_Sn
 };
 
 }  // namespace vrto3d
@@ -0,0 +1,156 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "process_watch.h"
+
+#include <algorithm>
+
+#include "platform.h"
+
+namespace vrto3d {
+
+ProcessWatch& ProcessWatch::Instance()
+{
+    static ProcessWatch instance;
+    return instance;
+}
+
+void ProcessWatch::Watch(uint32_t pid)
+{
+    if (pid == 0)
+        return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    WatchLocked(pid);
+}
+
+void ProcessWatch::WatchLocked(uint32_t pid)
+{
+    auto it = entries_.find(pid);
+    if (it != entries_.end()) {
+        if (it->second.running)
+            return;
+        // A departed PID reported again belongs to a new process; its old
+        // entry was disarmed when the exit fired.
+        entries_.erase(it);
+    }
+    Entry entry;
+    if (shut_down_ || !Arm(pid, entry))
+        entry.polled = true;
+    entries_.emplace(pid, entry);
+}
+
+bool ProcessWatch::IsRunning(uint32_t pid)
+{
+    if (pid == 0)
+        return false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(pid);
+        if (it == entries_.end()) {
+            WatchLocked(pid);
+            it = entries_.find(pid);
+        }
+        if (!it->second.polled)
+            return it->second.running;
+    }
+    return platform::IsProcessRunning(pid);
+}
+
+bool ProcessWatch::WaitForExit(uint32_t pid, std::chrono::milliseconds timeout)
+{
+    if (pid == 0)
+        return true;
+    // Re-probe interval for PIDs without an exit notification.
+    constexpr std::chrono::milliseconds kPollSlice(250);
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point deadline = Clock::now() + timeout;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (entries_.find(pid) == entries_.end())
+        WatchLocked(pid);
+    for (;;) {
+        auto it = entries_.find(pid);
+        if (it == entries_.end() || !it->second.running)
+            return true;
+        if (it->second.polled && !platform::IsProcessRunning(pid))
+            return true;
+        const Clock::time_point now = Clock::now();
+        if (now >= deadline)
+            return false;
+        Clock::duration slice = deadline - now;
+        if (it->second.polled)
+            slice = std::min<Clock::duration>(slice, kPollSlice);
+        exit_cv_.wait_for(lock, slice);
+    }
+}
+
+int ProcessWatch::AddExitListener(ExitListener listener)
+{
+    std::lock_guard<std::mutex> lock(listener_mutex_);
+    const int id = next_listener_id_++;
+    listeners_.emplace_back(id, std::move(listener));
+    return id;
+}
+
+void ProcessWatch::RemoveExitListener(int id)
+{
+    std::lock_guard<std::mutex> lock(listener_mutex_);
+    listeners_.erase(std::remove_if(listeners_.begin(), listeners_.end(),
+                                    [id](const std::pair<int, ExitListener>& l) { return l.first == id; }),
+                     listeners_.end());
+}
+
+void ProcessWatch::MarkExited(uint32_t pid)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(pid);
+        if (it == entries_.end() || !it->second.running || it->second.polled)
+            return;
+        it->second.running = false;
+        Disarm(it->second);
+    }
+    exit_cv_.notify_all();
+
+    // Held across the calls so RemoveExitListener can't return while one
+    // of them is still running against a dying owner.
+    std::lock_guard<std::mutex> lock(listener_mutex_);
+    for (const auto& l : listeners_)
+        l.second(pid);
+}
+
+void ProcessWatch::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (shut_down_)
+            return;
+        shut_down_ = true;
+    }
+    // Outside the lock: the watcher thread may be waiting on it in MarkExited.
+    StopPlatform();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& kv : entries_) {
+            Disarm(kv.second);
+            if (kv.second.running)
+                kv.second.polled = true;
+        }
+    }
+    exit_cv_.notify_all();
+}
+
+} // namespace vrto3d
@@ -0,0 +1,116 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+// Event-driven lifetime tracking for the game processes SteamVR reports.
+//
+// Focus policy, the present loops, auto-exit and the reconnect grace
+// threads all ask "is the app still alive?" — several of them once per
+// frame. Instead of probing the OS each time, every watched PID gets a
+// kernel exit notification (pidfd + epoll on Linux, a thread-pool wait on
+// the process handle on Windows) and IsRunning() answers from a cached bit.
+// Exit listeners fire as soon as the kernel reports the exit, so focus can
+// drop and auto-exit can run without waiting for the next poll.
+//
+// An exited PID stays "not running" until Watch() is called for it again
+// (a new ProcessConnected), so PID reuse can't resurrect a departed game.
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vrto3d {
+
+class ProcessWatch {
+public:
+    using ExitListener = std::function<void(uint32_t pid)>;
+
+    static ProcessWatch& Instance();
+
+    // Start (or restart, if it previously exited) tracking `pid`.
+    void Watch(uint32_t pid);
+
+    // Cached liveness. Unknown PIDs are watched on first query. Falls back
+    // to platform::IsProcessRunning when the kernel offers no exit
+    // notification (Linux < 5.3).
+    bool IsRunning(uint32_t pid);
+
+    // Blocks until `pid` exits or `timeout` passes. True if it has exited.
+    bool WaitForExit(uint32_t pid, std::chrono::milliseconds timeout);
+
+    // Listeners run on the watcher thread, once per exit; keep them short
+    // and don't add/remove listeners from inside one. After
+    // RemoveExitListener returns the listener is no longer running.
+    int  AddExitListener(ExitListener listener);
+    void RemoveExitListener(int id);
+
+    // Stops the watcher and releases all handles. Called from driver
+    // Cleanup; later calls degrade to polling.
+    void Shutdown();
+
+    // Entry point for the platform watcher when `pid` terminates.
+    void MarkExited(uint32_t pid);
+
+private:
+    ProcessWatch();
+    ~ProcessWatch();
+    ProcessWatch(const ProcessWatch&) = delete;
+    ProcessWatch& operator=(const ProcessWatch&) = delete;
+
+    struct Entry {
+        bool running = true;
+        bool polled  = false;  // no exit notification available
+#ifdef _WIN32
+        void* process = nullptr;
+        void* wait    = nullptr;
+#else
+        int   pidfd   = -1;
+#endif
+    };
+
+    // Platform halves (process_watch_linux.cpp / process_watch_win32.cpp).
+    bool Arm(uint32_t pid, Entry& entry);
+    void Disarm(Entry& entry);
+    void StopPlatform();
+
+    void WatchLocked(uint32_t pid);
+
+    std::mutex                             mutex_;
+    std::condition_variable                exit_cv_;
+    std::unordered_map<uint32_t, Entry>    entries_;
+    bool                                   shut_down_ = false;
+
+    std::mutex                             listener_mutex_;
+    std::vector<std::pair<int, ExitListener>> listeners_;
+    int                                    next_listener_id_ = 1;
+
+#ifndef _WIN32
+    void Run();
+
+    int         epoll_fd_ = -1;
+    int         wake_fd_  = -1;
+    std::thread thread_;
+#endif
+};
+
+} // namespace vrto3d
@@ -0,0 +1,140 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "process_watch.h"
+
+#include <cerrno>
+#include <cstdint>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "vrto3dlib/debug_log.hpp"
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434  // same number on every architecture we build for
+#endif
+
+namespace vrto3d {
+
+namespace {
+
+// epoll key of the shutdown eventfd; every other key is a PID.
+constexpr uint64_t kWakeKey = UINT64_MAX;
+
+} // namespace
+
+ProcessWatch::ProcessWatch()
+{
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ < 0 || wake_fd_ < 0) {
+        LOG() << "process_watch: epoll/eventfd unavailable (errno " << errno
+              << "), falling back to /proc polling";
+        StopPlatform();
+        return;
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = kWakeKey;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev);
+    thread_ = std::thread(&ProcessWatch::Run, this);
+}
+
+ProcessWatch::~ProcessWatch()
+{
+    Shutdown();
+}
+
+bool ProcessWatch::Arm(uint32_t pid, Entry& entry)
+{
+    if (epoll_fd_ < 0)
+        return false;
+    const int fd = static_cast<int>(syscall(SYS_pidfd_open, static_cast<pid_t>(pid), 0));
+    if (fd < 0) {
+        if (errno == ESRCH) {
+            entry.running = false;
+            return true;
+        }
+        LOG() << "process_watch: pidfd_open(" << pid << ") failed, errno " << errno
+              << " - polling /proc for this process";
+        return false;
+    }
+    // A pidfd polls readable once the process has terminated, including
+    // when it is already a zombie at this point.
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = pid;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        close(fd);
+        return false;
+    }
+    entry.pidfd = fd;
+    return true;
+}
+
+void ProcessWatch::Disarm(Entry& entry)
+{
+    if (entry.pidfd < 0)
+        return;
+    if (epoll_fd_ >= 0)
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, entry.pidfd, nullptr);
+    close(entry.pidfd);
+    entry.pidfd = -1;
+}
+
+void ProcessWatch::StopPlatform()
+{
+    if (thread_.joinable()) {
+        const uint64_t one = 1;
+        (void)!write(wake_fd_, &one, sizeof(one));
+        thread_.join();
+    }
+    // Closing the epoll fd drops its registrations; Shutdown closes the
+    // pidfds themselves afterwards.
+    if (wake_fd_ >= 0) {
+        close(wake_fd_);
+        wake_fd_ = -1;
+    }
+    if (epoll_fd_ >= 0) {
+        close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+}
+
+void ProcessWatch::Run()
+{
+    epoll_event evs[16];
+    for (;;) {
+        const int n = epoll_wait(epoll_fd_, evs, 16, -1);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            LOG() << "process_watch: epoll_wait failed, errno " << errno;
+            return;
+        }
+        for (int i = 0; i < n; ++i) {
+            if (evs[i].data.u64 == kWakeKey)
+                return;
+            MarkExited(static_cast<uint32_t>(evs[i].data.u64));
+        }
+    }
+}
+
+} // namespace vrto3d
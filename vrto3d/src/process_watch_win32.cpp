@@ -0,0 +1,77 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "process_watch.h"
+
+#include <windows.h>
+
+namespace vrto3d {
+
+namespace {
+
+VOID CALLBACK OnProcessExit(PVOID context, BOOLEAN /*timed_out*/)
+{
+    ProcessWatch::Instance().MarkExited(
+        static_cast<uint32_t>(reinterpret_cast<uintptr_t>(context)));
+}
+
+} // namespace
+
+ProcessWatch::ProcessWatch() = default;
+
+// No teardown here: this runs under the loader lock at DLL unload, where
+// waiting out thread-pool callbacks could deadlock. Cleanup calls Shutdown.
+ProcessWatch::~ProcessWatch() = default;
+
+bool ProcessWatch::Arm(uint32_t pid, Entry& entry)
+{
+    HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, pid);
+    if (!process) {
+        // Same verdict as platform::IsProcessRunning: gone or not ours to see.
+        entry.running = false;
+        return true;
+    }
+    HANDLE wait = nullptr;
+    if (!RegisterWaitForSingleObject(&wait, process, &OnProcessExit,
+                                     reinterpret_cast<PVOID>(static_cast<uintptr_t>(pid)),
+                                     INFINITE, WT_EXECUTEONLYONCE)) {
+        CloseHandle(process);
+        return false;
+    }
+    entry.process = process;
+    entry.wait = wait;
+    return true;
+}
+
+// Non-blocking unregister: this also runs from inside the wait callback,
+// where UnregisterWaitEx(INVALID_HANDLE_VALUE) would wait on itself.
+void ProcessWatch::Disarm(Entry& entry)
+{
+    if (entry.wait) {
+        UnregisterWait(static_cast<HANDLE>(entry.wait));
+        entry.wait = nullptr;
+    }
+    if (entry.process) {
+        CloseHandle(static_cast<HANDLE>(entry.process));
+        entry.process = nullptr;
+    }
+}
+
+void ProcessWatch::StopPlatform()
+{
+}
+
+} // namespace vrto3d
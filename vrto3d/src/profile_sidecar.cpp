@@ -0,0 +1,177 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "profile_sidecar.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+
+#include "vrto3dlib/debug_log.hpp"
+#ifdef _WIN32
+#include "vrto3dlib/win32_helper.hpp"
+#else
+#include "vrto3dlib/linux_helper.hpp"
+#endif
+
+namespace vrto3d {
+
+namespace {
+
+std::filesystem::path ProfilePath(const std::string& profile_file)
+{
+    const std::string steam = GetSteamInstallPath();
+    if (steam.empty())
+        return {};
+    return std::filesystem::u8path(steam) / "config" / "vrto3d" / std::filesystem::u8path(profile_file);
+}
+
+bool ReadJson(const std::filesystem::path& path, nlohmann::json& out)
+{
+    std::ifstream in(path);
+    if (!in)
+        return false;
+    out = nlohmann::json::parse(in, nullptr, /*allow_exceptions=*/false);
+    return out.is_object();
+}
+
+void ReadDouble(const nlohmann::json& j, const char* key, double& value)
+{
+    const auto it = j.find(key);
+    if (it != j.end() && it->is_number())
+        value = it->get<double>();
+}
+
+void ReadString(const nlohmann::json& j, const char* key, std::string& value)
+{
+    const auto it = j.find(key);
+    if (it != j.end() && it->is_string())
+        value = it->get<std::string>();
+}
+
+// Keeps the profile file free of keys that just restate the defaults.
+void WriteDouble(nlohmann::json& j, const char* key, double value, double default_value)
+{
+    if (value != default_value)
+        j[key] = value;
+    else
+        j.erase(key);
+}
+
+void WriteString(nlohmann::json& j, const char* key, const std::string& value, const std::string& default_value)
+{
+    if (value != default_value)
+        j[key] = value;
+    else
+        j.erase(key);
+}
+
+bool WriteJson(const std::filesystem::path& path, const nlohmann::json& j)
+{
+    std::ofstream out(path, std::ios::trunc);
+    if (!out)
+        return false;
+    out << j.dump(4);
+    return static_cast<bool>(out);
+}
+
+} // namespace
+
+const char* TrackFilterTypeName(TrackFilterType type)
+{
+    return type == TrackFilterType::OneEuro ? "one_euro" : "accela";
+}
+
+bool LoadTrackFilterSelection(const std::string& profile_file, TrackFilterSelection& sel)
+{
+    sel = TrackFilterSelection();
+    const std::filesystem::path path = ProfilePath(profile_file);
+    nlohmann::json j;
+    if (path.empty() || !ReadJson(path, j))
+        return false;
+
+    const auto type_it = j.find("track_filter_type");
+    if (type_it != j.end() && type_it->is_string()) {
+        const std::string name = type_it->get<std::string>();
+        if (name == "one_euro") {
+            sel.type = TrackFilterType::OneEuro;
+        }
+        else if (name == "accela") {
+            sel.type = TrackFilterType::AccelaHamilton;
+        }
+        else {
+            LOG() << "Unknown track_filter_type '" << name.c_str() << "' in " << profile_file.c_str() << ", using "
+                  << TrackFilterTypeName(sel.type);
+        }
+    }
+    ReadDouble(j, "one_euro_rot_mincutoff", sel.one_euro.rot_min_cutoff);
+    ReadDouble(j, "one_euro_rot_beta", sel.one_euro.rot_beta);
+    ReadDouble(j, "one_euro_pos_mincutoff", sel.one_euro.pos_min_cutoff);
+    ReadDouble(j, "one_euro_pos_beta", sel.one_euro.pos_beta);
+    return true;
+}
+
+bool SaveTrackFilterSelection(const std::string& profile_file, const TrackFilterSelection& sel)
+{
+    const std::filesystem::path path = ProfilePath(profile_file);
+    nlohmann::json j;
+    if (path.empty() || !ReadJson(path, j))
+        return false;
+
+    const TrackFilterSelection defaults;
+    if (sel.type != defaults.type)
+        j["track_filter_type"] = TrackFilterTypeName(sel.type);
+    else
+        j.erase("track_filter_type");
+    WriteDouble(j, "one_euro_rot_mincutoff", sel.one_euro.rot_min_cutoff, defaults.one_euro.rot_min_cutoff);
+    WriteDouble(j, "one_euro_rot_beta", sel.one_euro.rot_beta, defaults.one_euro.rot_beta);
+    WriteDouble(j, "one_euro_pos_mincutoff", sel.one_euro.pos_min_cutoff, defaults.one_euro.pos_min_cutoff);
+    WriteDouble(j, "one_euro_pos_beta", sel.one_euro.pos_beta, defaults.one_euro.pos_beta);
+    return WriteJson(path, j);
+}
+
+bool LoadOutputProfileOptions(const std::string& profile_file, OutputProfileOptions& opts)
+{
+    opts = OutputProfileOptions();
+    const std::filesystem::path path = ProfilePath(profile_file);
+    nlohmann::json j;
+    if (path.empty() || !ReadJson(path, j))
+        return false;
+
+    ReadString(j, "ww_source", opts.ww_source);
+    ReadString(j, "upscaler", opts.upscaler);
+    double render_scale = opts.render_scale;
+    ReadDouble(j, "render_scale", render_scale);
+    opts.render_scale = static_cast<float>(render_scale);
+    return true;
+}
+
+bool SaveOutputProfileOptions(const std::string& profile_file, const OutputProfileOptions& opts)
+{
+    const std::filesystem::path path = ProfilePath(profile_file);
+    nlohmann::json j;
+    if (path.empty() || !ReadJson(path, j))
+        return false;
+
+    const OutputProfileOptions defaults;
+    WriteString(j, "ww_source", opts.ww_source, defaults.ww_source);
+    WriteString(j, "upscaler", opts.upscaler, defaults.upscaler);
+    WriteDouble(j, "render_scale", opts.render_scale, defaults.render_scale);
+    return WriteJson(path, j);
+}
+
+} // namespace vrto3d
@@ -0,0 +1,91 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+// Profile sidecar: driver-side keys stored alongside a profile's JSON fields.
+//
+// StereoDisplayDriverConfiguration lives in VRto3DLib, so these keys are
+// read and written here next to the JsonManager calls instead of through
+// it. JsonManager rewrites the whole profile on save, so every save site
+// must save the sidecar afterwards to keep the keys. Each group has its
+// own struct and Load/Save pair.
+//
+// Head-tracking filter (TrackFilterSelection):
+//
+//   "track_filter_type":      "accela" (default) | "one_euro"
+//   "one_euro_rot_mincutoff": Hz at rest
+//   "one_euro_rot_beta":      Hz per rad/s
+//   "one_euro_pos_mincutoff": Hz at rest
+//   "one_euro_pos_beta":      Hz per m/s
+//
+// Output options that depend on the game as much as on the display
+// (OutputProfileOptions):
+//
+//   "ww_source":              "full" (default) | "half" | "checkerboard"
+//   "upscaler":               "bilinear" (default) | "fsr" | "lanczos"
+//   "render_scale":           recommended render size factor, 0.25..2 (1)
+
+#include <string>
+
+#include "one_euro_pose_filter.h"
+
+namespace vrto3d {
+
+enum class TrackFilterType {
+    AccelaHamilton,
+    OneEuro,
+};
+
+struct TrackFilterSelection {
+    TrackFilterType   type = TrackFilterType::AccelaHamilton;
+    OneEuroPoseParams one_euro;
+};
+
+// Output-side keys. Only the Linux Vulkan renderer and presenters consume
+// these, except render_scale.
+struct OutputProfileOptions {
+    // Source format handed to wwserver (WibbleWobble presenter).
+    std::string ww_source = "full";
+    // How VkRenderer scales a render smaller than the output up to it.
+    std::string upscaler = "bilinear";
+    // Factor on the recommended render size (GetRecommendedRenderTargetSize).
+    float       render_scale = 1.0f;
+
+    bool operator==(const OutputProfileOptions& o) const
+    {
+        return ww_source == o.ww_source && upscaler == o.upscaler && render_scale == o.render_scale;
+    }
+    bool operator!=(const OutputProfileOptions& o) const { return !(*this == o); }
+};
+
+const char* TrackFilterTypeName(TrackFilterType type);
+
+// Resets `sel` to the defaults, then applies whichever keys are present in
+// Steam/config/vrto3d/<profile_file>, so a profile without them never
+// inherits the previous game's filter. Returns false if the file is missing
+// or not valid JSON (`sel` is left at the defaults).
+bool LoadTrackFilterSelection(const std::string& profile_file, TrackFilterSelection& sel);
+
+// Read-modify-write of the same file; other keys are left untouched. Filter
+// keys are only written when they differ from the defaults.
+bool SaveTrackFilterSelection(const std::string& profile_file, const TrackFilterSelection& sel);
+
+// Same contract as the pair above, for OutputProfileOptions.
+bool LoadOutputProfileOptions(const std::string& profile_file, OutputProfileOptions& opts);
+bool SaveOutputProfileOptions(const std::string& profile_file, const OutputProfileOptions& opts);
+
+} // namespace vrto3d
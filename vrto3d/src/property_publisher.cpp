@@ -0,0 +1,136 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "property_publisher.h"
+
+#include <cmath>
+#include <utility>
+
+namespace vrto3d {
+
+namespace {
+
+double MaxRectDelta(const vr::HmdRect2_t& a, const vr::HmdRect2_t& b)
+{
+    double d = 0.0;
+    for (int i = 0; i < 2; ++i) {
+        d = std::fmax(d, std::fabs(a.vTopLeft.v[i] - b.vTopLeft.v[i]));
+        d = std::fmax(d, std::fabs(a.vBottomRight.v[i] - b.vBottomRight.v[i]));
+    }
+    return d;
+}
+
+} // namespace
+
+void PropertyPublisher::SetBackend(Backend backend)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    backend_ = std::move(backend);
+}
+
+void PropertyPublisher::Configure(uint32_t device_index, const Limits& ipd, const Limits& projection,
+                                  ProjectionSource projection_source)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    device_index_ = device_index;
+    ipd_limits_ = ipd;
+    proj_limits_ = projection;
+    projection_source_ = std::move(projection_source);
+    configured_ = true;
+}
+
+void PropertyPublisher::SetIpd(float meters)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ipd_pending_ = meters;
+    ipd_dirty_ = true;
+    PublishDueLocked(NowLocked());
+}
+
+void PropertyPublisher::RequestProjection(bool force)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    proj_dirty_ = true;
+    proj_force_ = proj_force_ || force;
+    PublishDueLocked(NowLocked());
+}
+
+void PropertyPublisher::Flush()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ipd_dirty_ || proj_dirty_)
+        PublishDueLocked(NowLocked());
+}
+
+PropertyPublisher::Clock::time_point PropertyPublisher::NowLocked() const
+{
+    return backend_.now ? backend_.now() : Clock::now();
+}
+
+bool PropertyPublisher::Due(Clock::time_point now, Clock::time_point last, double interval_s)
+{
+    return std::chrono::duration<double>(now - last).count() >= interval_s;
+}
+
+void PropertyPublisher::PublishDueLocked(Clock::time_point now)
+{
+    if (!configured_)
+        return;
+
+    if (ipd_dirty_ && (!ipd_published_once_ || Due(now, ipd_last_, ipd_limits_.min_interval_s))) {
+        ipd_dirty_ = false;
+        if (!ipd_published_once_ ||
+            std::fabs(static_cast<double>(ipd_pending_) - ipd_published_) >= ipd_limits_.threshold) {
+            if (backend_.write_ipd) {
+                backend_.write_ipd(device_index_, ipd_pending_);
+            } else {
+                vr::PropertyContainerHandle_t container =
+                    vr::VRProperties()->TrackedDeviceToPropertyContainer(device_index_);
+                vr::VRProperties()->SetFloatProperty(container, vr::Prop_UserIpdMeters_Float, ipd_pending_);
+            }
+            ipd_published_ = ipd_pending_;
+            ipd_published_once_ = true;
+            ipd_last_ = now;
+        }
+    }
+
+    if (proj_dirty_ && projection_source_ &&
+        (!proj_published_once_ || Due(now, proj_last_, proj_limits_.min_interval_s))) {
+        vr::HmdRect2_t eyes[2];
+        projection_source_(eyes[0], eyes[1]);
+        const bool changed = !proj_published_once_ ||
+            MaxRectDelta(eyes[0], proj_published_[0]) >= proj_limits_.threshold ||
+            MaxRectDelta(eyes[1], proj_published_[1]) >= proj_limits_.threshold;
+        const bool force = proj_force_;
+        proj_dirty_ = false;
+        proj_force_ = false;
+        if (changed || force) {
+            if (backend_.write_projection) {
+                backend_.write_projection(device_index_, eyes[0], eyes[1]);
+            } else {
+                vr::VREvent_Data_t temp{};
+                vr::VRServerDriverHost()->SetDisplayProjectionRaw(device_index_, eyes[0], eyes[1]);
+                vr::VRServerDriverHost()->VendorSpecificEvent(device_index_, vr::VREvent_LensDistortionChanged, temp, 0.0f);
+            }
+            proj_published_[0] = eyes[0];
+            proj_published_[1] = eyes[1];
+            proj_published_once_ = true;
+            proj_last_ = now;
+        }
+    }
+}
+
+} // namespace vrto3d
@@ -0,0 +1,105 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+// Single outlet for the OpenVR writes that running games react to:
+// Prop_UserIpdMeters_Float (depth) and SetDisplayProjectionRaw +
+// VREvent_LensDistortionChanged (convergence / FoV). Most VR mods rebuild
+// their projection on every one of these, so bursts from auto-depth, held
+// hotkeys, OSD sliders, or UEVR commands turn into visible hitches.
+//
+// Writers only record the latest value. A write goes out immediately when
+// the property's minimum interval has passed since the last one (so a
+// single keypress still lands at once), otherwise it waits for Flush(),
+// which the renderers call on every vsync tick. Values closer than the
+// property's threshold to what was last published are dropped; comparison
+// is against the published value, so slow drifts still go out once they
+// add up.
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#include "openvr_driver.h"
+
+namespace vrto3d {
+
+class PropertyPublisher {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Limits {
+        double min_interval_s = 0.0;
+        double threshold = 0.0;
+    };
+
+    // Fills the per-eye raw projection (left, right, top, bottom tangents).
+    using ProjectionSource = std::function<void(vr::HmdRect2_t& left, vr::HmdRect2_t& right)>;
+
+    // Where writes go and what time it is. Members left empty fall back to
+    // the OpenVR driver context and Clock::now(); the unit tests fill them.
+    struct Backend {
+        std::function<void(uint32_t device_index, float meters)> write_ipd;
+        std::function<void(uint32_t device_index, const vr::HmdRect2_t& left,
+                           const vr::HmdRect2_t& right)> write_projection;
+        std::function<Clock::time_point()> now;
+    };
+
+    void SetBackend(Backend backend);
+
+    // Nothing is written before Configure; requests made earlier stay
+    // pending and go out on the first Flush afterwards.
+    void Configure(uint32_t device_index, const Limits& ipd, const Limits& projection,
+                   ProjectionSource projection_source);
+
+    void SetIpd(float meters);
+
+    // `force` re-sends even if the projection is unchanged, for explicit
+    // resets where the LensDistortionChanged event itself is the point.
+    void RequestProjection(bool force);
+
+    // Publishes whatever is pending and due. Cheap when idle.
+    void Flush();
+
+private:
+    Clock::time_point NowLocked() const;
+    void PublishDueLocked(Clock::time_point now);
+    static bool Due(Clock::time_point now, Clock::time_point last, double interval_s);
+
+    std::mutex       mutex_;
+    bool             configured_ = false;
+    uint32_t         device_index_ = vr::k_unTrackedDeviceIndexInvalid;
+    Limits           ipd_limits_;
+    Limits           proj_limits_;
+    ProjectionSource projection_source_;
+    Backend          backend_;
+
+    bool             ipd_dirty_ = false;
+    bool             ipd_published_once_ = false;
+    float            ipd_pending_ = 0.0f;
+    float            ipd_published_ = 0.0f;
+    Clock::time_point ipd_last_{};
+
+    bool             proj_dirty_ = false;
+    bool             proj_force_ = false;
+    bool             proj_published_once_ = false;
+    vr::HmdRect2_t   proj_published_[2] = {};
+    Clock::time_point proj_last_{};
+};
+
+} // namespace vrto3d
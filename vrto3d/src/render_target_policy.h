@@ -0,0 +1,81 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "vrto3dlib/stereo_config.h"
+
+namespace vrto3d {
+
+// Per-eye render size sized to what the output can actually show. Most
+// modes keep only part of each eye's image when they pack both eyes into
+// one frame. TaB and RowInterlaced halve the height, SbS and ColInterlaced
+// halve the width, Checkerboard keeps every other pixel and VirtualDesktop
+// keeps a quarter. Rendering the configured full-size eye for those just
+// gets downsampled away in the repack. Frame-packed modes show each eye at
+// the packed timing's own size whatever the desktop mode is. Modes that show
+// a whole frame per eye (anaglyph, Mono, DualDisplay, frame-sequential)
+// match the output.
+//
+// `out_w`/`out_h` is the output's size in pixels. `supersample` scales
+// both axes (1 = native, 1.5 = 2.25x the pixels).
+struct RenderTargetSize {
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+inline RenderTargetSize OutputMatchedRenderTargetSize(OutputMode mode, uint32_t out_w,
+                                                      uint32_t out_h, float supersample)
+{
+    double w = out_w, h = out_h;
+    if (const FramePackTimingSpec* spec = GetFramePackTimingSpec(mode)) {
+        w = spec->active_w;
+        h = (static_cast<double>(spec->active_h) - spec->gap_pixels) / 2.0;
+    } else {
+        switch (mode) {
+            case OutputMode::SbS:
+            case OutputMode::ColInterlaced:
+                w /= 2.0;
+                break;
+            case OutputMode::TaB:
+            case OutputMode::RowInterlaced:
+                h /= 2.0;
+                break;
+            case OutputMode::Checkerboard:
+                // Half the pixels, spread over both axes.
+                w *= std::sqrt(0.5);
+                h *= std::sqrt(0.5);
+                break;
+            case OutputMode::VirtualDesktop:
+                w /= 2.0;
+                h /= 2.0;
+                break;
+            default:
+                break;
+        }
+    }
+    const double scale = std::clamp(static_cast<double>(supersample), 0.25, 4.0);
+    RenderTargetSize size;
+    size.width  = static_cast<uint32_t>(std::max(1.0, std::round(w * scale)));
+    size.height = static_cast<uint32_t>(std::max(1.0, std::round(h * scale)));
+    return size;
+}
+
+} // namespace vrto3d
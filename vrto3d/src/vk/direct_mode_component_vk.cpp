@@ -348,5 +348,10 @@ void DirectModeComponentVk::Present(vr::SharedTextureHandle_t syncTexture)
 
 void DirectModeComponentVk::PostPresent(const Throttling_t* pThrottling)
 {
-    (void)pThrottling;
+    (void)pThrottling;  // the application's own throttle settings, read-only here
+    // Holding the compositor here is how we throttle it: while the game's
+    // image is static the renderer drops frames anyway, so keep it from
+    // producing them at full rate.
+    if (renderer_)
+        renderer_->PaceIdleCompositor();
 }
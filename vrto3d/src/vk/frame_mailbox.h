@@ -0,0 +1,95 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace vrto3d::vk {
+
+// Latest-value triple buffer between one producer and one consumer.
+//
+// The producer (vrserver's compositor thread, via OnDirectModeFrame) writes
+// into a slot it owns and swaps it with the shared middle slot in a single
+// atomic exchange, so Publish never blocks or waits on the consumer. The
+// consumer (the present thread) swaps its own slot with the middle one when
+// the middle carries the fresh bit. A value the producer replaces before it
+// was taken is counted in Overwritten(): a rising count means the present
+// thread is falling behind the compositor.
+//
+// T must be trivially copyable; slots are plain copies.
+template <typename T>
+class FrameMailbox {
+public:
+    // Producer only. Returns true if an untaken value was replaced.
+    bool Publish(const T& value)
+    {
+        const uint64_t seq = published_.fetch_add(1, std::memory_order_relaxed) + 1;
+        slots_[write_].value = value;
+        slots_[write_].seq = seq;
+        const uint32_t prev = middle_.exchange(write_ | kFresh, std::memory_order_acq_rel);
+        write_ = prev & kIndexMask;
+        if (prev & kFresh) {
+            overwritten_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    // Consumer only. False when nothing was published since the last Take,
+    // or when the newest value was dropped by Discard.
+    bool Take(T* out)
+    {
+        if (!(middle_.load(std::memory_order_relaxed) & kFresh))
+            return false;
+        const uint32_t prev = middle_.exchange(read_, std::memory_order_acq_rel);
+        read_ = prev & kIndexMask;
+        if (slots_[read_].seq <= discard_through_.load(std::memory_order_acquire))
+            return false;
+        *out = slots_[read_].value;
+        return true;
+    }
+
+    // Any thread: drop everything published so far without consuming it.
+    void Discard()
+    {
+        discard_through_.store(published_.load(std::memory_order_acquire),
+                               std::memory_order_release);
+    }
+
+    uint64_t Published() const { return published_.load(std::memory_order_relaxed); }
+    uint64_t Overwritten() const { return overwritten_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t kIndexMask = 3;
+    static constexpr uint32_t kFresh = 4;
+
+    struct Slot {
+        T        value{};
+        uint64_t seq = 0;
+    };
+
+    Slot slots_[3];
+    alignas(64) std::atomic<uint32_t> middle_{1};
+    alignas(64) uint32_t write_ = 0;  // producer-owned slot index
+    alignas(64) uint32_t read_ = 2;   // consumer-owned slot index
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> overwritten_{0};
+    std::atomic<uint64_t> discard_through_{0};
+};
+
+}  // namespace vrto3d::vk
@@ -0,0 +1,86 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstdlib>
+#include <string>
+
+#include "vrto3dlib/stereo_config.h"
+
+namespace vrto3d::vk {
+
+// Output modes a mirror can ask for by name (same labels as the OSD menu).
+struct ModeName { const char* name; OutputMode mode; };
+inline constexpr ModeName kMirrorModes[] = {
+    {"SbS", OutputMode::SbS},
+    {"TaB", OutputMode::TaB},
+    {"RowInterlaced", OutputMode::RowInterlaced},
+    {"ColInterlaced", OutputMode::ColInterlaced},
+    {"Checkerboard", OutputMode::Checkerboard},
+    {"WibbleWobble", OutputMode::WibbleWobble},
+    {"VirtualDesktop", OutputMode::VirtualDesktop},
+    {"FramePacked720p60", OutputMode::FramePacked720p60},
+    {"FramePacked1080p24", OutputMode::FramePacked1080p24},
+    {"FramePacked1080p60", OutputMode::FramePacked1080p60},
+    {"FramePacked1080p60CVT", OutputMode::FramePacked1080p60CVT},
+    {"AnaglyphRedCyan", OutputMode::AnaglyphRedCyan},
+    {"AnaglyphRedCyanDubois", OutputMode::AnaglyphRedCyanDubois},
+    {"AnaglyphRedCyanDeghosted", OutputMode::AnaglyphRedCyanDeghosted},
+    {"AnaglyphRedCyanCompromise", OutputMode::AnaglyphRedCyanCompromise},
+    {"AnaglyphGreenMagenta", OutputMode::AnaglyphGreenMagenta},
+    {"AnaglyphGreenMagentaDubois", OutputMode::AnaglyphGreenMagentaDubois},
+    {"AnaglyphGreenMagentaDeghosted", OutputMode::AnaglyphGreenMagentaDeghosted},
+    {"AnaglyphBlueAmber", OutputMode::AnaglyphBlueAmber},
+    {"Mono", OutputMode::Mono},
+};
+
+// One driver_vrto3d/mirrors entry: presenter[:mode][@display].
+struct MirrorSpec {
+    std::string presenter;
+    bool        has_mode = false;
+    OutputMode  mode = OutputMode::SbS;
+    int         display_index = -1;  // -1 = same as the primary
+};
+
+inline bool ParseMirrorSpec(const std::string& entry, MirrorSpec* out)
+{
+    std::string rest = entry;
+    const size_t at = rest.find('@');
+    if (at != std::string::npos) {
+        char* end = nullptr;
+        const long display = std::strtol(rest.c_str() + at + 1, &end, 10);
+        if (end == rest.c_str() + at + 1 || *end != '\0' || display < 0)
+            return false;
+        out->display_index = static_cast<int>(display);
+        rest.resize(at);
+    }
+    const size_t colon = rest.find(':');
+    out->presenter = rest.substr(0, colon);
+    if (colon == std::string::npos)
+        return !out->presenter.empty();
+    const std::string mode = rest.substr(colon + 1);
+    for (const ModeName& m : kMirrorModes) {
+        if (mode == m.name) {
+            out->has_mode = true;
+            out->mode = m.mode;
+            return !out->presenter.empty();
+        }
+    }
+    return false;
+}
+
+}  // namespace vrto3d::vk
@@ -53,6 +53,16 @@ bool DeviceCtx::Init()
         if (instance_ext_supported(wsi))
             inst_exts.push_back(wsi);
     }
+    // Compositor-free output (DrmDisplayPresenter). All three are needed to
+    // turn a DRM connector into a VkDisplayKHR we can own.
+    const bool display_exts = instance_ext_supported("VK_KHR_display") &&
+                              instance_ext_supported("VK_EXT_direct_mode_display") &&
+                              instance_ext_supported("VK_EXT_acquire_drm_display");
+    if (display_exts) {
+        for (const char* ext : {"VK_KHR_display", "VK_EXT_direct_mode_display",
+                                "VK_EXT_acquire_drm_display"})
+            inst_exts.push_back(ext);
+    }
 
     VkInstanceCreateInfo ici{VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO};
     ici.pApplicationInfo = &app;
@@ -60,6 +70,7 @@ bool DeviceCtx::Init()
     ici.ppEnabledExtensionNames = inst_exts.data();
     if (LogIfFailed(vkCreateInstance(&ici, nullptr, &instance), "vkCreateInstance") != VK_SUCCESS)
         return false;
+    drm_display = display_exts;
 
     // ---- physical device ----
     uint32_t dev_count = 0;
@@ -100,7 +111,9 @@ bool DeviceCtx::Init()
         std::vector<VkQueueFamilyProperties> qfs(qf_count);
         vkGetPhysicalDeviceQueueFamilyProperties(candidate, &qf_count, qfs.data());
         for (uint32_t i = 0; i < qf_count; ++i) {
-            if (qfs[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+            // One queue runs the repack and the compute passes (frame hash).
+            const VkQueueFlags need = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT;
+            if ((qfs[i].queueFlags & need) == need) {
                 phys = candidate;
                 queue_family = i;
                 break;
@@ -156,6 +169,7 @@ void DeviceCtx::Destroy()
     }
     phys = VK_NULL_HANDLE;
     queue = VK_NULL_HANDLE;
+    drm_display = false;
 }
 
 uint32_t DeviceCtx::FindMemoryType(uint32_t type_bits, VkMemoryPropertyFlags want) const
@@ -250,6 +264,52 @@ bool CreateImage2D(DeviceCtx& ctx, uint32_t width, uint32_t height, VkFormat for
     return true;
 }
 
+std::vector<DrmModifier> RenderableDrmModifiers(const DeviceCtx& ctx, VkFormat format,
+                                                uint32_t width, uint32_t height)
+{
+    VkDrmFormatModifierPropertiesListEXT list{
+        VK_STRUCTURE_TYPE_DRM_FORMAT_MODIFIER_PROPERTIES_LIST_EXT};
+    VkFormatProperties2 fp{VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2};
+    fp.pNext = &list;
+    vkGetPhysicalDeviceFormatProperties2(ctx.phys, format, &fp);
+    std::vector<VkDrmFormatModifierPropertiesEXT> props(list.drmFormatModifierCount);
+    list.pDrmFormatModifierProperties = props.data();
+    vkGetPhysicalDeviceFormatProperties2(ctx.phys, format, &fp);
+
+    std::vector<DrmModifier> out;
+    for (const auto& p : props) {
+        if (!(p.drmFormatModifierTilingFeatures & VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT))
+            continue;
+        VkPhysicalDeviceImageDrmFormatModifierInfoEXT mod_info{
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGE_DRM_FORMAT_MODIFIER_INFO_EXT};
+        mod_info.drmFormatModifier = p.drmFormatModifier;
+        mod_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        VkPhysicalDeviceExternalImageFormatInfo ext_info{
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_IMAGE_FORMAT_INFO};
+        ext_info.pNext = &mod_info;
+        ext_info.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT;
+        VkPhysicalDeviceImageFormatInfo2 info{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGE_FORMAT_INFO_2};
+        info.pNext = &ext_info;
+        info.format = format;
+        info.type = VK_IMAGE_TYPE_2D;
+        info.tiling = VK_IMAGE_TILING_DRM_FORMAT_MODIFIER_EXT;
+        info.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        VkExternalImageFormatProperties ext_props{VK_STRUCTURE_TYPE_EXTERNAL_IMAGE_FORMAT_PROPERTIES};
+        VkImageFormatProperties2 img_props{VK_STRUCTURE_TYPE_IMAGE_FORMAT_PROPERTIES_2};
+        img_props.pNext = &ext_props;
+        if (vkGetPhysicalDeviceImageFormatProperties2(ctx.phys, &info, &img_props) != VK_SUCCESS)
+            continue;
+        if (!(ext_props.externalMemoryProperties.externalMemoryFeatures &
+              VK_EXTERNAL_MEMORY_FEATURE_EXPORTABLE_BIT))
+            continue;
+        const VkExtent3D& max = img_props.imageFormatProperties.maxExtent;
+        if (max.width < width || max.height < height)
+            continue;
+        out.push_back({p.drmFormatModifier, p.drmFormatModifierPlaneCount});
+    }
+    return out;
+}
+
 VkShaderModule CreateShaderModule(VkDevice device, const uint32_t* spirv_words, size_t byte_size)
 {
     VkShaderModuleCreateInfo ci{VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
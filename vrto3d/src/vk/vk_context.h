@@ -20,6 +20,7 @@
 
 #include <cstdint>
 #include <mutex>
+#include <vector>
 
 namespace vrto3d::vk {
 
@@ -36,16 +37,19 @@ struct DeviceCtx {
     VkQueue          queue = VK_NULL_HANDLE;
     std::mutex       queue_mutex;
     VkPhysicalDeviceMemoryProperties mem_props{};
+    bool             drm_display = false;  // VK_KHR_display + VK_EXT_acquire_drm_display enabled
 
     // Creates instance + device with the extensions the Linux port needs:
     //   instance: VK_KHR_surface, VK_KHR_wayland_surface, VK_KHR_xcb_surface,
     //             VK_KHR_xlib_surface (each only if supported),
+    //             VK_KHR_display + VK_EXT_direct_mode_display +
+    //             VK_EXT_acquire_drm_display (all or none),
     //             VK_KHR_get_physical_device_properties2
     //   device:   VK_KHR_swapchain, VK_KHR_external_memory_fd,
     //             VK_EXT_external_memory_dma_buf, VK_EXT_image_drm_format_modifier,
     //             VK_KHR_external_semaphore_fd, VK_KHR_timeline_semaphore
     // Picks the first physical device that has the required device extensions
-    // and a graphics queue with present support.
+    // and a graphics + compute queue with present support.
     bool Init();
     void Destroy();
 
@@ -80,6 +84,19 @@ bool CreateImage2D(DeviceCtx& ctx, uint32_t width, uint32_t height, VkFormat for
                    VkImageUsageFlags usage, VkImageTiling tiling,
                    VkMemoryPropertyFlags mem_props, bool make_view, Image2D* out);
 
+// A DRM format modifier and its memory-plane count.
+struct DrmModifier {
+    uint64_t modifier = 0;
+    uint32_t planes = 1;
+};
+
+// Modifiers `format` can be rendered into (COLOR_ATTACHMENT) and exported as
+// a dmabuf at width x height, in the driver's listing order. The dmabuf
+// producers (Wayland ring, WibbleWobble, PipeWire) pick their layout from
+// this before building a VK_IMAGE_TILING_DRM_FORMAT_MODIFIER_EXT image.
+std::vector<DrmModifier> RenderableDrmModifiers(const DeviceCtx& ctx, VkFormat format,
+                                                uint32_t width, uint32_t height);
+
 // Small helpers shared by the renderer / presenters / OSD backend.
 VkShaderModule CreateShaderModule(VkDevice device, const uint32_t* spirv_words, size_t byte_size);
 
@@ -17,15 +17,27 @@
 #include "vk/vk_renderer.h"
 
 #include <algorithm>
+#include <cerrno>
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
 #include <filesystem>
 
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include "driver_settings.h"
 #include "hmd_device_driver.h"
 #include "osd/osd_menu.h"
 #include "osd/osd_renderer.h"
 #include "platform.h"
+#include "process_watch.h"
 #include "presenter/vk_presenter.h"
+#include "render_target_policy.h"
+#include "vk/mirror_spec.h"
 #include "vrto3dlib/debug_log.hpp"
 #include "vrto3dlib/linux_helper.hpp"
 
@@ -33,13 +45,29 @@
 #define STBI_WRITE_NO_STDIO_DISABLE
 #include "stb_image_write.h"
 
+#include "../shaders/generated/easu_comp_spv.h"
 #include "../shaders/generated/fullscreen_vert_spv.h"
+#include "../shaders/generated/lanczos_comp_spv.h"
+#include "../shaders/generated/rcas_comp_spv.h"
 #include "../shaders/generated/repack_frag_spv.h"
+#include "../shaders/generated/tile_hash_comp_spv.h"
 
 namespace {
 
-// C++ mirror of the push-constant block in shaders/repack.frag.
-struct RepackPush {
+// epoll keys for the present thread's event loop.
+enum : uint32_t {
+    kWakeDoorbell = 0,
+    kWakeHousekeeping = 1,
+    kWakeDisplay = 2,
+};
+
+// Idle re-check of the focus inputs. They are plain atomics written from
+// the driver's hotkey/settings threads with no notification, so while no
+// frames flow this tick is what notices them.
+constexpr long kHousekeepingMs = 250;
+
+// C++ mirror of the uniform block in shaders/repack.frag.
+struct RepackParams {
     int32_t out_w, out_h;
     int32_t eye_w, eye_h;
     int32_t mode;
@@ -51,7 +79,41 @@ struct RepackPush {
     float   gain[4];
     float   curve_offsets[4];
 };
-static_assert(sizeof(RepackPush) <= 128, "push constant limit");
+static_assert(sizeof(RepackParams) == 96, "std140 layout of repack.frag's Pc");
+
+// C++ mirror of the push-constant block in shaders/tile_hash.comp.
+struct TileHashPush {
+    int32_t width, height;
+    int32_t tiles_x;
+};
+
+// C++ mirror of the push-constant block shared by shaders/easu.comp,
+// rcas.comp and lanczos.comp.
+struct UpscalePush {
+    int32_t src_w, src_h;
+    int32_t dst_w, dst_h;
+    float   sharpness;
+};
+
+// RCAS strength in stops below its maximum (FSR's default is 0.2).
+constexpr float kRcasStops = 0.2f;
+
+// Cache keys for the recorded secondaries. Built over a zeroed buffer so
+// padding compares equal.
+struct TransferKey {
+    VkImage               left, right;
+    vr::VRTextureBounds_t left_bounds, right_bounds;
+    uint32_t              left_w, left_h, right_w, right_h;
+    int32_t               only_eye;
+};
+struct RepackKey {
+    VkRenderPass    render_pass;
+    VkPipeline      pipeline;
+    VkDescriptorSet set;
+    VkExtent2D      extent;
+    int32_t         half;
+    uint32_t        params_offset;
+};
 
 VkImageMemoryBarrier ImageBarrier(VkImage image, VkAccessFlags src_access,
                                   VkAccessFlags dst_access, VkImageLayout old_layout,
@@ -76,13 +138,81 @@ VkImageMemoryBarrier ImageBarrier(VkImage image, VkAccessFlags src_access,
 struct FrameTargetBits {
     VkFramebuffer framebuffer;
     VkExtent2D    extent;
+    // Which half of the packed output lands here: 0/1 when each eye's
+    // display has its own swapchain, -1 for the whole frame.
+    int           half;
+    // The sink it belongs to: render pass and repack pipeline built for its
+    // presenter, and the mode it packs (null = the live configured mode).
+    VkRenderPass  render_pass;
+    VkPipeline    pipeline;
+    const vrto3d::IVkPresenter* presenter;
+    const OutputMode* mode;
+    // Its RepackParams entry in repack_params_ (the draw's dynamic offset).
+    uint32_t      params_offset;
 };
 
+namespace {
+
+RepackParams MakeRepackParams(const FrameTargetBits& target,
+                              const StereoDisplayDriverConfiguration& cfg, uint32_t span_w,
+                              uint32_t eye_w, uint32_t eye_h)
+{
+    RepackParams params{};
+    params.out_w = (int32_t)span_w;
+    params.out_h = (int32_t)target.extent.height;
+    params.eye_w = (int32_t)eye_w;
+    params.eye_h = (int32_t)eye_h;
+    const OutputMode mode = target.mode ? *target.mode : cfg.output_mode;
+    params.mode = (int32_t)target.presenter->RepackMode(mode);
+    params.eye_swap = cfg.eye_swap ? 1 : 0;
+    params.correction_enabled = cfg.shader_enabled ? 1 : 0;
+    params.curve = cfg.shader_curve;
+    for (int i = 0; i < 3; ++i) {
+        params.lift[i] = cfg.shader_lift[i];
+        params.gamma[i] = cfg.shader_gamma[i];
+        params.gain[i] = cfg.shader_gain[i];
+    }
+    params.curve_offsets[0] = cfg.shader_curve_off_low;
+    params.curve_offsets[1] = cfg.shader_curve_off_high;
+    params.curve_offsets[2] = cfg.shader_curve_off_both;
+    return params;
+}
+
+// Width of the packed frame a target shows a part of.
+uint32_t RepackSpanWidth(const FrameTargetBits& target)
+{
+    return target.half < 0 ? target.extent.width : target.extent.width * 2;
+}
+
+// Everything inside one target's repack render pass.
+void RecordRepackDraw(VkCommandBuffer cmd, const FrameTargetBits& target, VkPipelineLayout layout,
+                      VkDescriptorSet set)
+{
+    const float view_x = target.half > 0 ? -(float)target.extent.width : 0.f;
+    VkViewport viewport{view_x, 0.f, (float)RepackSpanWidth(target), (float)target.extent.height,
+                        0.f, 1.f};
+    VkRect2D scissor{{0, 0}, target.extent};
+    vkCmdSetViewport(cmd, 0, 1, &viewport);
+    vkCmdSetScissor(cmd, 0, 1, &scissor);
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, target.pipeline);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &set, 1,
+                            &target.params_offset);
+    vkCmdDraw(cmd, 3, 1, 0, 0);
+}
+
+}  // namespace
+
 VkRenderer::VkRenderer() = default;
 
 VkRenderer::~VkRenderer()
 {
     Shutdown();
+    for (int* fd : {&housekeeping_fd_, &doorbell_fd_, &epoll_fd_}) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
 }
 
 bool VkRenderer::Init(const StereoDisplayDriverConfiguration& cfg,
@@ -91,6 +221,15 @@ bool VkRenderer::Init(const StereoDisplayDriverConfiguration& cfg,
     cfg_ = cfg;
     focus_ = focus;
     display_frequency_ = cfg.display_frequency > 1.0f ? cfg.display_frequency : 60.0f;
+    vrr_requested_ = vrto3d::DriverSettingBool("variable_refresh", false);
+    sparse_eyes_ = vrto3d::DriverSettingBool("sparse_eyes", true);
+    // Negative (the default) leaves the ticks on the vblank.
+    const float margin_ms = vrto3d::DriverSettingFloat("vsync_margin_ms", -1.0f);
+    if (margin_ms >= 0.0f)
+        vsync_margin_sec_ = margin_ms / 1000.0;
+    // Off unless set: the per-frame hash pass costs GPU time for a saving
+    // only static content sees.
+    idle_after_sec_ = std::max(0.0, (double)vrto3d::DriverSettingFloat("static_idle_seconds", 0.0f));
 
     if (!ctx_.Init()) {
         LOG() << "vk_renderer: device init failed";
@@ -98,7 +237,29 @@ bool VkRenderer::Init(const StereoDisplayDriverConfiguration& cfg,
         return false;
     }
 
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    doorbell_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    housekeeping_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (epoll_fd_ < 0 || doorbell_fd_ < 0 || housekeeping_fd_ < 0) {
+        LOG() << "vk_renderer: event loop setup failed, errno " << errno;
+        return false;
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u32 = kWakeDoorbell;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, doorbell_fd_, &ev);
+    ev.data.u32 = kWakeHousekeeping;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, housekeeping_fd_, &ev);
+    itimerspec tick{};
+    tick.it_interval.tv_nsec = kHousekeepingMs * 1000000L;
+    tick.it_value = tick.it_interval;
+    timerfd_settime(housekeeping_fd_, 0, &tick, nullptr);
+
     running_.store(true);
+    // Wake the present loop when the game exits so the focus block lowers
+    // the window now rather than on the next housekeeping tick.
+    app_exit_listener_ = vrto3d::ProcessWatch::Instance().AddExitListener(
+        [this](uint32_t) { RingDoorbell(); });
     present_thread_ = std::thread(&VkRenderer::PresentThread, this);
     vsync_thread_ = std::thread(&VkRenderer::VsyncTickThread, this);
     return true;
@@ -108,11 +269,19 @@ void VkRenderer::Shutdown()
 {
     if (!running_.exchange(false))
         return;
-    frame_cv_.notify_all();
+    vrto3d::ProcessWatch::Instance().RemoveExitListener(app_exit_listener_);
+    RingDoorbell();
     if (present_thread_.joinable())
         present_thread_.join();
     if (vsync_thread_.joinable())
         vsync_thread_.join();
+    LOG() << "vk_renderer: " << frames_.Overwritten() << " of " << frames_.Published()
+          << " compositor frames overwritten before present";
+    if (present_latency_sec_.load() > 0.0) {
+        LOG() << "vk_renderer: present latency ~" << present_latency_sec_.load() * 1000.0
+              << " ms, " << presents_discarded_.load() << " presents discarded, "
+              << vblanks_repeated_.load() << " vblanks repeated";
+    }
     // Present thread destroyed its own resources (pipeline, presenter, OSD)
     // before exiting; the device goes last.
     ctx_.Destroy();
@@ -123,19 +292,35 @@ void VkRenderer::OnDirectModeFrame(const EyeLayer& left, const EyeLayer& right)
     if (paused_for_disconnect_.load(std::memory_order_acquire) ||
         device_dead_.load(std::memory_order_acquire))
         return;
-    {
-        std::lock_guard<std::mutex> lock(frame_mutex_);
-        pending_left_ = left;
-        pending_right_ = right;
-        ++pending_seq_;
+    frames_.Publish({left, right, last_tick_sec_.load(std::memory_order_relaxed),
+                     last_tick_lead_sec_.load(std::memory_order_relaxed)});
+    RingDoorbell();
+
+    // Game frame cadence for VRR tick pacing. Gaps beyond a quarter second
+    // are pauses (loading screens), not a frame rate.
+    const double now = platform::MonotonicSeconds();
+    const double dt = now - last_game_frame_sec_;
+    last_game_frame_sec_ = now;
+    if (dt > 0.0 && dt < 0.25) {
+        const double prev = game_frame_interval_sec_.load(std::memory_order_relaxed);
+        game_frame_interval_sec_.store(prev == 0.0 ? dt : prev + (dt - prev) / 8.0,
+                                       std::memory_order_relaxed);
+    }
+}
+
+void VkRenderer::RingDoorbell()
+{
+    if (doorbell_fd_ >= 0) {
+        const uint64_t one = 1;
+        (void)!write(doorbell_fd_, &one, sizeof(one));
     }
-    frame_cv_.notify_one();
 }
 
 void VkRenderer::ConfigureOsd(StereoDisplayComponent* component,
                               vrto3d::osd::MenuCallbacks callbacks, void* /*native_window*/)
 {
     osd_component_ = component;
+    vsync_component_.store(component, std::memory_order_release);
     osd_callbacks_ = std::make_unique<vrto3d::osd::MenuCallbacks>(std::move(callbacks));
     osd_config_pending_ = true;
 }
@@ -164,12 +349,8 @@ void VkRenderer::OnAppDisconnect()
 
 void VkRenderer::WaitIdleForTextureRelease()
 {
-    {
-        std::lock_guard<std::mutex> lock(frame_mutex_);
-        consumed_seq_ = pending_seq_;   // drop any not-yet-consumed snapshot
-        pending_left_ = {};
-        pending_right_ = {};
-    }
+    frames_.Discard();   // drop any not-yet-consumed snapshot
+    eye_images_released_.store(true, std::memory_order_release);
     if (ctx_.device != VK_NULL_HANDLE) {
         std::lock_guard<std::mutex> qlock(ctx_.queue_mutex);
         vkQueueWaitIdle(ctx_.queue);
@@ -178,6 +359,60 @@ void VkRenderer::WaitIdleForTextureRelease()
 
 // ---------------------------------------------------------------------------
 
+// The compositor's eyes arrive at render size, but TaB, half-SbS and the
+// interlaced modes only ever show half of each eye's rows or columns at the
+// output's real resolution. When every output shows less of an eye than
+// arrives, the blit downsamples it to what is shown, so the copy, the OSD
+// and the repack all touch fewer pixels. Mono shows one eye, so only that
+// eye is copied. While the OSD is drawing, out_sbs_ stays at full size so
+// its text is rendered at full resolution. Screenshots read the eyes
+// directly (MaybeSaveScreenshot) and don't affect the plan.
+void VkRenderer::PlanEyeTransfer(const EyeLayer& left, uint32_t* eye_w, uint32_t* eye_h,
+                                 int* only_eye)
+{
+    *eye_w = left.width;
+    *eye_h = left.height;
+    *only_eye = -1;
+    if (!sparse_eyes_)
+        return;
+    const double now = platform::MonotonicSeconds();
+    if (osd_renderer_ && osd_renderer_->HasContent())
+        osd_full_size_until_sec_ = now + 2.0;
+    if (now < osd_full_size_until_sec_)
+        return;
+
+    const StereoDisplayDriverConfiguration cfg = osd_component_ ? osd_component_->GetConfig() : cfg_;
+    uint32_t shown_w = 0, shown_h = 0;
+    bool all_mono = true;
+    ShownEyeSize(cfg, &shown_w, &shown_h, &all_mono);
+    if (shown_w == 0 || shown_h == 0)
+        return;
+    *eye_w = std::min(*eye_w, shown_w);
+    *eye_h = std::min(*eye_h, shown_h);
+    if (all_mono)
+        *only_eye = cfg.eye_swap ? 1 : 0;
+}
+
+void VkRenderer::ShownEyeSize(const StereoDisplayDriverConfiguration& cfg, uint32_t* shown_w,
+                              uint32_t* shown_h, bool* all_mono) const
+{
+    *shown_w = 0;
+    *shown_h = 0;
+    *all_mono = true;
+    auto add_sink = [&](OutputMode mode, VkExtent2D extent) {
+        const vrto3d::RenderTargetSize shown =
+            vrto3d::OutputMatchedRenderTargetSize(mode, extent.width, extent.height, 1.0f);
+        *shown_w = std::max(*shown_w, shown.width);
+        *shown_h = std::max(*shown_h, shown.height);
+        *all_mono = *all_mono && mode == OutputMode::Mono;
+    };
+    add_sink(presenter_->RepackMode(cfg.output_mode), presenter_->Extent());
+    for (const MirrorSink& m : mirrors_) {
+        if (m.presenter)
+            add_sink(m.presenter->RepackMode(m.own_mode ? m.mode : cfg.output_mode), m.extent);
+    }
+}
+
 bool VkRenderer::EnsureOutputImage(uint32_t eye_w, uint32_t eye_h)
 {
     const uint32_t want_w = eye_w * 2;
@@ -210,6 +445,7 @@ bool VkRenderer::EnsureOutputImage(uint32_t eye_w, uint32_t eye_h)
     sbs_width_ = want_w;
     sbs_height_ = want_h;
     out_sbs_initialized_ = false;
+    InvalidateCachedCmds();
 
     // Point the repack descriptor at the new view.
     if (repack_set_ != VK_NULL_HANDLE) {
@@ -223,6 +459,7 @@ bool VkRenderer::EnsureOutputImage(uint32_t eye_w, uint32_t eye_h)
         write.pImageInfo = &img;
         vkUpdateDescriptorSets(ctx_.device, 1, &write, 0, nullptr);
     }
+    WriteUpscaleSets();
 
     // OSD render target size follows the per-eye dims.
     if (osd_renderer_)
@@ -249,36 +486,84 @@ bool VkRenderer::EnsureRepackPipeline()
     sci.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
     vkCreateSampler(ctx_.device, &sci, nullptr, &repack_sampler_);
 
-    VkDescriptorSetLayoutBinding binding{};
-    binding.binding = 0;
-    binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    binding.descriptorCount = 1;
-    binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+    VkDescriptorSetLayoutBinding bindings[2] = {};
+    bindings[0].binding = 0;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    bindings[0].descriptorCount = 1;
+    bindings[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+    bindings[1].binding = 1;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    bindings[1].descriptorCount = 1;
+    bindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
     VkDescriptorSetLayoutCreateInfo dslci{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
-    dslci.bindingCount = 1;
-    dslci.pBindings = &binding;
+    dslci.bindingCount = 2;
+    dslci.pBindings = bindings;
     vkCreateDescriptorSetLayout(ctx_.device, &dslci, nullptr, &repack_dsl_);
 
-    VkPushConstantRange pc{VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(RepackPush)};
     VkPipelineLayoutCreateInfo plci{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
     plci.setLayoutCount = 1;
     plci.pSetLayouts = &repack_dsl_;
-    plci.pushConstantRangeCount = 1;
-    plci.pPushConstantRanges = &pc;
     vkCreatePipelineLayout(ctx_.device, &plci, nullptr, &repack_layout_);
 
-    VkDescriptorPoolSize pool_size{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1};
+    // repack_set_ and repack_up_set_.
+    VkDescriptorPoolSize pool_sizes[2] = {
+        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2},
+        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 2},
+    };
     VkDescriptorPoolCreateInfo dpci{VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
-    dpci.maxSets = 1;
-    dpci.poolSizeCount = 1;
-    dpci.pPoolSizes = &pool_size;
+    dpci.maxSets = 2;
+    dpci.poolSizeCount = 2;
+    dpci.pPoolSizes = pool_sizes;
     vkCreateDescriptorPool(ctx_.device, &dpci, nullptr, &repack_pool_);
 
+    VkDescriptorSetLayout set_layouts[2] = {repack_dsl_, repack_dsl_};
+    VkDescriptorSet sets[2] = {};
     VkDescriptorSetAllocateInfo dsai{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
     dsai.descriptorPool = repack_pool_;
-    dsai.descriptorSetCount = 1;
-    dsai.pSetLayouts = &repack_dsl_;
-    vkAllocateDescriptorSets(ctx_.device, &dsai, &repack_set_);
+    dsai.descriptorSetCount = 2;
+    dsai.pSetLayouts = set_layouts;
+    vkAllocateDescriptorSets(ctx_.device, &dsai, sets);
+    repack_set_ = sets[0];
+    repack_up_set_ = sets[1];
+
+    // The parameter ring, host-coherent so a memcpy before the submit is
+    // all an update takes.
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(ctx_.phys, &props);
+    const uint32_t align = (uint32_t)std::max<VkDeviceSize>(
+        props.limits.minUniformBufferOffsetAlignment, 1);
+    repack_params_stride_ = (uint32_t)((sizeof(RepackParams) + align - 1) / align * align);
+    VkBufferCreateInfo bci{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    bci.size = (VkDeviceSize)repack_params_stride_ * kFramesInFlight * kRepackParamsPerSlot;
+    bci.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    if (vkCreateBuffer(ctx_.device, &bci, nullptr, &repack_params_) != VK_SUCCESS)
+        return false;
+    VkMemoryRequirements reqs{};
+    vkGetBufferMemoryRequirements(ctx_.device, repack_params_, &reqs);
+    VkMemoryAllocateInfo alloc{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+    alloc.allocationSize = reqs.size;
+    alloc.memoryTypeIndex = ctx_.FindMemoryType(
+        reqs.memoryTypeBits,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (alloc.memoryTypeIndex == UINT32_MAX ||
+        vkAllocateMemory(ctx_.device, &alloc, nullptr, &repack_params_mem_) != VK_SUCCESS)
+        return false;
+    vkBindBufferMemory(ctx_.device, repack_params_, repack_params_mem_, 0);
+    void* mapped = nullptr;
+    if (vkMapMemory(ctx_.device, repack_params_mem_, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS)
+        return false;
+    repack_params_mapped_ = static_cast<unsigned char*>(mapped);
+    VkDescriptorBufferInfo params{repack_params_, 0, sizeof(RepackParams)};
+    VkWriteDescriptorSet params_writes[2];
+    for (int i = 0; i < 2; ++i) {
+        params_writes[i] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+        params_writes[i].dstSet = sets[i];
+        params_writes[i].dstBinding = 1;
+        params_writes[i].descriptorCount = 1;
+        params_writes[i].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        params_writes[i].pBufferInfo = &params;
+    }
+    vkUpdateDescriptorSets(ctx_.device, 2, params_writes, 0, nullptr);
 
     if (out_sbs_view_ != VK_NULL_HANDLE) {
         VkDescriptorImageInfo img{repack_sampler_, out_sbs_view_,
@@ -292,12 +577,43 @@ bool VkRenderer::EnsureRepackPipeline()
         vkUpdateDescriptorSets(ctx_.device, 1, &write, 0, nullptr);
     }
 
+    repack_pipeline_ = CreateRepackPipeline(repack_render_pass_);
+    if (repack_pipeline_ == VK_NULL_HANDLE)
+        return false;
+
+    LOG() << "vk_renderer: repack pipeline ready";
+    return true;
+}
+
+void VkRenderer::EnsureMirrorPipelines()
+{
+    for (size_t i = 0; i < mirrors_.size(); ++i) {
+        MirrorSink& m = mirrors_[i];
+        if (!m.presenter || m.pipeline != VK_NULL_HANDLE)
+            continue;
+        VkRenderPass render_pass;
+        {
+            std::lock_guard<std::mutex> lock(m.worker->mutex);
+            render_pass = m.presenter->RenderPass();
+        }
+        m.pipeline = CreateRepackPipeline(render_pass);
+        if (m.pipeline == VK_NULL_HANDLE) {
+            LOG() << "vk_renderer: no repack pipeline for mirror '" << m.spec << "'";
+            DropMirror(i);
+        }
+    }
+}
+
+// Repack pipeline for one sink's render pass. The primary and every mirror
+// share the layout, descriptor set and sampler.
+VkPipeline VkRenderer::CreateRepackPipeline(VkRenderPass render_pass)
+{
     VkShaderModule vs = vrto3d::vk::CreateShaderModule(ctx_.device, fullscreen_vert_spv,
                                                        sizeof(fullscreen_vert_spv));
     VkShaderModule fs = vrto3d::vk::CreateShaderModule(ctx_.device, repack_frag_spv,
                                                        sizeof(repack_frag_spv));
     if (!vs || !fs)
-        return false;
+        return VK_NULL_HANDLE;
 
     VkPipelineShaderStageCreateInfo stages[2] = {};
     stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -344,21 +660,61 @@ bool VkRenderer::EnsureRepackPipeline()
     gpci.pColorBlendState = &blend;
     gpci.pDynamicState = &dyn;
     gpci.layout = repack_layout_;
-    gpci.renderPass = repack_render_pass_;
+    gpci.renderPass = render_pass;
     gpci.subpass = 0;
+    VkPipeline pipeline = VK_NULL_HANDLE;
     VkResult r = vkCreateGraphicsPipelines(ctx_.device, VK_NULL_HANDLE, 1, &gpci, nullptr,
-                                           &repack_pipeline_);
+                                           &pipeline);
     vkDestroyShaderModule(ctx_.device, vs, nullptr);
     vkDestroyShaderModule(ctx_.device, fs, nullptr);
     if (vrto3d::vk::LogIfFailed(r, "repack vkCreateGraphicsPipelines") != VK_SUCCESS)
-        return false;
+        return VK_NULL_HANDLE;
+    return pipeline;
+}
 
-    LOG() << "vk_renderer: repack pipeline ready";
-    return true;
+VkCommandBuffer VkRenderer::LookupCachedCmd(CachedCmd* cache, int count, const void* key,
+                                            size_t key_size, bool* hit)
+{
+    // A frame's fence is waited before its slot records again, and the queue
+    // retires submissions in order, so anything last used kFramesInFlight or
+    // more submits ago has finished executing.
+    CachedCmd* victim = nullptr;
+    for (int i = 0; i < count; ++i) {
+        CachedCmd& c = cache[i];
+        if (c.valid && std::memcmp(c.key.data(), key, key_size) == 0) {
+            c.last_used = submit_serial_;
+            *hit = true;
+            return c.cmd;
+        }
+        if (c.last_used + kFramesInFlight > submit_serial_)
+            continue;
+        if (!victim || (victim->valid && (!c.valid || c.last_used < victim->last_used)))
+            victim = &c;
+    }
+    *hit = false;
+    if (!victim)
+        return VK_NULL_HANDLE;
+    std::memcpy(victim->key.data(), key, key_size);
+    victim->valid = true;
+    victim->last_used = submit_serial_;
+    vkResetCommandBuffer(victim->cmd, 0);
+    return victim->cmd;
 }
 
-void VkRenderer::RecordFrame(VkCommandBuffer cmd, const EyeLayer& left, const EyeLayer& right,
-                             const FrameTargetBits& target)
+// Drops every cached recording. Entries still executing keep their buffers
+// untouched until they retire; they just can no longer be hit.
+void VkRenderer::InvalidateCachedCmds()
+{
+    for (CachedCmd& c : transfer_cache_)
+        c.valid = false;
+    for (CachedCmd& c : repack_cache_)
+        c.valid = false;
+}
+
+// The transfer half of a frame: acquire the eye images, move out_sbs_ to
+// TRANSFER_DST and blit the eyes into it.
+void VkRenderer::RecordTransfer(VkCommandBuffer cmd, const EyeLayer& left, const EyeLayer& right,
+                                int only_eye)
 {
     // Acquire the compositor's images (written on vrserver's own device;
     // implicit dmabuf sync orders those writes against this submission).
@@ -374,16 +730,23 @@ void VkRenderer::RecordFrame(VkCommandBuffer cmd, const EyeLayer& left, const Ey
         out_sbs_, 0, VK_ACCESS_TRANSFER_WRITE_BIT,
         out_sbs_initialized_ ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED,
         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    out_sbs_initialized_ = true;
     VkImageMemoryBarrier pre[3] = {acquire[0], acquire[1], to_dst};
     vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
                          0, 0, nullptr, 0, nullptr, 3, pre);
 
-    // Blit each eye into its half, honoring the submitted UV bounds (swapped
-    // offsets mirror automatically, which covers vMin>vMax flipped submissions).
-    const uint32_t eye_w = sbs_width_ / 2;
-    const uint32_t eye_h = sbs_height_;
+    // out_sbs_ may be smaller than the eyes (PlanEyeTransfer); the linear
+    // blit then downsamples.
+    BlitEyes(cmd, left, right, only_eye, out_sbs_, sbs_width_ / 2, sbs_height_);
+}
+
+void VkRenderer::BlitEyes(VkCommandBuffer cmd, const EyeLayer& left, const EyeLayer& right,
+                          int only_eye, VkImage dst, uint32_t eye_w, uint32_t eye_h)
+{
+    // Swapped offsets mirror automatically, which covers vMin>vMax flipped
+    // submissions.
     for (int i = 0; i < 2; ++i) {
+        if (only_eye >= 0 && i != only_eye)
+            continue;
         const EyeLayer& src = (i == 0) ? left : right;
         VkImageBlit blit{};
         blit.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
@@ -394,12 +757,60 @@ void VkRenderer::RecordFrame(VkCommandBuffer cmd, const EyeLayer& left, const Ey
         blit.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
         blit.dstOffsets[0] = {(int32_t)(i * eye_w), 0, 0};
         blit.dstOffsets[1] = {(int32_t)((i + 1) * eye_w), (int32_t)eye_h, 1};
-        vkCmdBlitImage(cmd, src.image, VK_IMAGE_LAYOUT_GENERAL, out_sbs_,
+        vkCmdBlitImage(cmd, src.image, VK_IMAGE_LAYOUT_GENERAL, dst,
                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
     }
+}
+
+// Per-frame primary. The transfer and each repack draw come from the
+// secondary cache when their inputs match an earlier frame; only the
+// screenshot copy, the OSD and the render pass begin/end are recorded anew.
+// The repack draws read their parameters from repack_params_ at a fixed
+// offset per frame slot and sink, so a config change is a memcpy, not a
+// re-record.
+void VkRenderer::RecordFrame(VkCommandBuffer cmd, const EyeLayer& left, const EyeLayer& right,
+                             int only_eye, const FrameTargetBits* targets, uint32_t target_count)
+{
+    if (eye_images_released_.exchange(false, std::memory_order_acq_rel))
+        InvalidateCachedCmds();
+
+    // The first frame into a new out_sbs_ discards its contents (UNDEFINED),
+    // which must not be replayed later, so it is always recorded inline.
+    VkCommandBuffer transfer = VK_NULL_HANDLE;
+    bool hit = false;
+    static_assert(sizeof(TransferKey) <= kCacheKeyBytes, "transfer key too large");
+    if (out_sbs_initialized_) {
+        TransferKey key;
+        std::memset(&key, 0, sizeof(key));
+        key.left = left.image;
+        key.right = right.image;
+        key.left_bounds = left.bounds;
+        key.right_bounds = right.bounds;
+        key.left_w = left.width;
+        key.left_h = left.height;
+        key.right_w = right.width;
+        key.right_h = right.height;
+        key.only_eye = only_eye;
+        transfer = LookupCachedCmd(transfer_cache_, kCachedTransfers, &key, sizeof(key), &hit);
+    }
+    if (transfer != VK_NULL_HANDLE) {
+        if (!hit) {
+            VkCommandBufferInheritanceInfo inherit{VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO};
+            VkCommandBufferBeginInfo begin{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+            begin.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+            begin.pInheritanceInfo = &inherit;
+            vkBeginCommandBuffer(transfer, &begin);
+            RecordTransfer(transfer, left, right, only_eye);
+            vkEndCommandBuffer(transfer);
+        }
+        vkCmdExecuteCommands(cmd, 1, &transfer);
+    } else {
+        RecordTransfer(cmd, left, right, only_eye);
+    }
+    out_sbs_initialized_ = true;
 
     // Screenshot readback happens pre-OSD, matching the Windows behavior.
-    MaybeSaveScreenshot(cmd);
+    MaybeSaveScreenshot(cmd, left, right);
 
     // OSD pass (no-op inside when nothing to draw).
     VkImageMemoryBarrier to_color = ImageBarrier(
@@ -412,56 +823,326 @@ void VkRenderer::RecordFrame(VkCommandBuffer cmd, const EyeLayer& left, const Ey
     if (osd_renderer_)
         osd_renderer_->RenderFrame(cmd, out_sbs_, out_sbs_view_, sbs_width_, sbs_height_);
 
+    // Read by the repack, or by the upscale pass ahead of it.
     VkImageMemoryBarrier to_read = ImageBarrier(
         out_sbs_, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
         VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
     vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1,
-                         &to_read);
+                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &to_read);
+    if (up_active_)
+        RecordUpscale(cmd);
+    const uint32_t eye_w = up_active_ ? up_w_ : sbs_width_ / 2;
+    const uint32_t eye_h = up_active_ ? up_h_ : sbs_height_;
+
+    // Repack into the swapchain image(s). A per-eye target gets a viewport
+    // twice its width, shifted so only its half of the packed frame lands
+    // on it; DualDisplay's split depends on uv alone, so the shader needs
+    // no per-target variant.
+    for (uint32_t t = 0; t < target_count; ++t) {
+        const FrameTargetBits& target = targets[t];
+        if (target.framebuffer == VK_NULL_HANDLE)
+            continue;
+        RecordRepack(cmd, target, eye_w, eye_h);
+    }
+}
+
+void VkRenderer::RecordRepack(VkCommandBuffer cmd, const FrameTargetBits& target, uint32_t eye_w,
+                              uint32_t eye_h)
+{
+    const StereoDisplayDriverConfiguration cfg =
+        osd_component_ ? osd_component_->GetConfig() : cfg_;
+    const RepackParams params =
+        MakeRepackParams(target, cfg, RepackSpanWidth(target), eye_w, eye_h);
+    std::memcpy(repack_params_mapped_ + target.params_offset, &params, sizeof(params));
+    const VkDescriptorSet set = up_active_ ? repack_up_set_ : repack_set_;
+
+    // The framebuffer is left out of the key (and inherited as null), so one
+    // recording serves every swapchain image of a sink.
+    static_assert(sizeof(RepackKey) <= kCacheKeyBytes, "repack key too large");
+    RepackKey key;
+    std::memset(&key, 0, sizeof(key));
+    key.render_pass = target.render_pass;
+    key.pipeline = target.pipeline;
+    key.set = set;
+    key.extent = target.extent;
+    key.half = target.half;
+    key.params_offset = target.params_offset;
+    bool hit = false;
+    VkCommandBuffer draw = LookupCachedCmd(repack_cache_, kCachedRepacks, &key, sizeof(key), &hit);
+    if (draw != VK_NULL_HANDLE && !hit) {
+        VkCommandBufferInheritanceInfo inherit{VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO};
+        inherit.renderPass = target.render_pass;
+        inherit.subpass = 0;
+        VkCommandBufferBeginInfo begin{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+        begin.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT |
+                      VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+        begin.pInheritanceInfo = &inherit;
+        vkBeginCommandBuffer(draw, &begin);
+        RecordRepackDraw(draw, target, repack_layout_, set);
+        vkEndCommandBuffer(draw);
+    }
 
-    // Repack into the swapchain image.
     VkClearValue clear{};
     VkRenderPassBeginInfo rpbi{VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
-    rpbi.renderPass = repack_render_pass_;
+    rpbi.renderPass = target.render_pass;
     rpbi.framebuffer = target.framebuffer;
     rpbi.renderArea = {{0, 0}, target.extent};
     rpbi.clearValueCount = 1;
     rpbi.pClearValues = &clear;
-    vkCmdBeginRenderPass(cmd, &rpbi, VK_SUBPASS_CONTENTS_INLINE);
-
-    VkViewport viewport{0.f, 0.f, (float)target.extent.width, (float)target.extent.height,
-                        0.f, 1.f};
-    VkRect2D scissor{{0, 0}, target.extent};
-    vkCmdSetViewport(cmd, 0, 1, &viewport);
-    vkCmdSetScissor(cmd, 0, 1, &scissor);
-    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, repack_pipeline_);
-    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, repack_layout_, 0, 1,
-                            &repack_set_, 0, nullptr);
-
-    RepackPush push{};
-    push.out_w = (int32_t)target.extent.width;
-    push.out_h = (int32_t)target.extent.height;
-    push.eye_w = (int32_t)eye_w;
-    push.eye_h = (int32_t)eye_h;
-    StereoDisplayDriverConfiguration cfg = osd_component_ ? osd_component_->GetConfig() : cfg_;
-    push.mode = (int32_t)cfg.output_mode;
-    push.eye_swap = cfg.eye_swap ? 1 : 0;
-    push.correction_enabled = cfg.shader_enabled ? 1 : 0;
-    push.curve = cfg.shader_curve;
-    for (int i = 0; i < 3; ++i) {
-        push.lift[i] = cfg.shader_lift[i];
-        push.gamma[i] = cfg.shader_gamma[i];
-        push.gain[i] = cfg.shader_gain[i];
-    }
-    push.curve_offsets[0] = cfg.shader_curve_off_low;
-    push.curve_offsets[1] = cfg.shader_curve_off_high;
-    push.curve_offsets[2] = cfg.shader_curve_off_both;
-    vkCmdPushConstants(cmd, repack_layout_, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(push), &push);
-    vkCmdDraw(cmd, 3, 1, 0, 0);
+    if (draw != VK_NULL_HANDLE) {
+        vkCmdBeginRenderPass(cmd, &rpbi, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        vkCmdExecuteCommands(cmd, 1, &draw);
+    } else {
+        vkCmdBeginRenderPass(cmd, &rpbi, VK_SUBPASS_CONTENTS_INLINE);
+        RecordRepackDraw(cmd, target, repack_layout_, set);
+    }
     vkCmdEndRenderPass(cmd);
 }
 
-void VkRenderer::MaybeSaveScreenshot(VkCommandBuffer cmd)
+uint32_t VkRenderer::RepackParamsOffset(int slot, uint32_t entry) const
+{
+    return ((uint32_t)slot * kRepackParamsPerSlot + entry) * repack_params_stride_;
+}
+
+// Runs each frame once out_sbs_ and the repack set exist. The stage only
+// pays off where the repack would magnify: some output shows more of an eye
+// than out_sbs_ holds (a render below the output's resolution). up_sbs_
+// takes the larger of the two sizes per axis, so the repack never
+// magnifies it further.
+void VkRenderer::EnsureUpscale()
+{
+    up_active_ = false;
+    if (upscaler_ == Upscaler::Bilinear || up_failed_)
+        return;
+    const StereoDisplayDriverConfiguration cfg = osd_component_ ? osd_component_->GetConfig() : cfg_;
+    uint32_t shown_w = 0, shown_h = 0;
+    bool all_mono = true;
+    ShownEyeSize(cfg, &shown_w, &shown_h, &all_mono);
+    const uint32_t eye_w = sbs_width_ / 2;
+    const uint32_t eye_h = sbs_height_;
+    if (shown_w <= eye_w && shown_h <= eye_h)
+        return;
+
+    if (up_layout_ == VK_NULL_HANDLE && !CreateUpscale()) {
+        LOG() << "vk_renderer: upscale pipelines unavailable, using bilinear";
+        DestroyUpscale();
+        up_failed_ = true;
+        return;
+    }
+    const uint32_t want_w = std::max(eye_w, shown_w);
+    const uint32_t want_h = std::max(eye_h, shown_h);
+    if (up_sbs_.image == VK_NULL_HANDLE || up_w_ != want_w || up_h_ != want_h) {
+        {
+            std::lock_guard<std::mutex> qlock(ctx_.queue_mutex);
+            vkQueueWaitIdle(ctx_.queue);
+        }
+        up_sbs_.Destroy(ctx_.device);
+        up_tmp_.Destroy(ctx_.device);
+        // up_tmp_ only serves "fsr", but keeping both means a profile switch
+        // between upscalers never reallocates.
+        for (vrto3d::vk::Image2D* img : {&up_sbs_, &up_tmp_}) {
+            if (!vrto3d::vk::CreateImage2D(ctx_, want_w * 2, want_h, VK_FORMAT_R8G8B8A8_UNORM,
+                    VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                    VK_IMAGE_TILING_OPTIMAL, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                    /*make_view=*/true, img)) {
+                LOG() << "vk_renderer: upscale image allocation failed, using bilinear";
+                DestroyUpscale();
+                up_failed_ = true;
+                return;
+            }
+        }
+        up_w_ = want_w;
+        up_h_ = want_h;
+        WriteUpscaleSets();
+        InvalidateCachedCmds();
+        LOG() << "vk_renderer: upscale to " << want_w << "x" << want_h << " per eye";
+    }
+    up_active_ = true;
+}
+
+bool VkRenderer::CreateUpscale()
+{
+    VkDescriptorSetLayoutBinding bindings[2] = {};
+    bindings[0].binding = 0;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    bindings[0].descriptorCount = 1;
+    bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    bindings[1].binding = 1;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    bindings[1].descriptorCount = 1;
+    bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    VkDescriptorSetLayoutCreateInfo dslci{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
+    dslci.bindingCount = 2;
+    dslci.pBindings = bindings;
+    if (vkCreateDescriptorSetLayout(ctx_.device, &dslci, nullptr, &up_dsl_) != VK_SUCCESS)
+        return false;
+
+    VkPushConstantRange pc{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(UpscalePush)};
+    VkPipelineLayoutCreateInfo plci{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
+    plci.setLayoutCount = 1;
+    plci.pSetLayouts = &up_dsl_;
+    plci.pushConstantRangeCount = 1;
+    plci.pPushConstantRanges = &pc;
+    if (vkCreatePipelineLayout(ctx_.device, &plci, nullptr, &up_layout_) != VK_SUCCESS)
+        return false;
+
+    auto create_pipeline = [&](const uint32_t* spirv, size_t size, VkPipeline* out) {
+        VkShaderModule cs = vrto3d::vk::CreateShaderModule(ctx_.device, spirv, size);
+        if (!cs)
+            return false;
+        VkComputePipelineCreateInfo cpci{VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
+        cpci.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        cpci.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        cpci.stage.module = cs;
+        cpci.stage.pName = "main";
+        cpci.layout = up_layout_;
+        const VkResult r = vkCreateComputePipelines(ctx_.device, VK_NULL_HANDLE, 1, &cpci,
+                                                    nullptr, out);
+        vkDestroyShaderModule(ctx_.device, cs, nullptr);
+        return vrto3d::vk::LogIfFailed(r, "upscale vkCreateComputePipelines") == VK_SUCCESS;
+    };
+    if (!create_pipeline(easu_comp_spv, sizeof(easu_comp_spv), &easu_pipeline_) ||
+        !create_pipeline(rcas_comp_spv, sizeof(rcas_comp_spv), &rcas_pipeline_) ||
+        !create_pipeline(lanczos_comp_spv, sizeof(lanczos_comp_spv), &lanczos_pipeline_))
+        return false;
+
+    VkDescriptorPoolSize pool_sizes[2] = {
+        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 3},
+        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 3},
+    };
+    VkDescriptorPoolCreateInfo dpci{VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
+    dpci.maxSets = 3;
+    dpci.poolSizeCount = 2;
+    dpci.pPoolSizes = pool_sizes;
+    if (vkCreateDescriptorPool(ctx_.device, &dpci, nullptr, &up_pool_) != VK_SUCCESS)
+        return false;
+    VkDescriptorSetLayout layouts[3] = {up_dsl_, up_dsl_, up_dsl_};
+    VkDescriptorSetAllocateInfo dsai{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
+    dsai.descriptorPool = up_pool_;
+    dsai.descriptorSetCount = 3;
+    dsai.pSetLayouts = layouts;
+    return vkAllocateDescriptorSets(ctx_.device, &dsai, up_sets_) == VK_SUCCESS;
+}
+
+void VkRenderer::DestroyUpscale()
+{
+    up_sbs_.Destroy(ctx_.device);
+    up_tmp_.Destroy(ctx_.device);
+    if (easu_pipeline_) vkDestroyPipeline(ctx_.device, easu_pipeline_, nullptr);
+    if (rcas_pipeline_) vkDestroyPipeline(ctx_.device, rcas_pipeline_, nullptr);
+    if (lanczos_pipeline_) vkDestroyPipeline(ctx_.device, lanczos_pipeline_, nullptr);
+    if (up_layout_) vkDestroyPipelineLayout(ctx_.device, up_layout_, nullptr);
+    if (up_pool_) vkDestroyDescriptorPool(ctx_.device, up_pool_, nullptr);
+    if (up_dsl_) vkDestroyDescriptorSetLayout(ctx_.device, up_dsl_, nullptr);
+    easu_pipeline_ = VK_NULL_HANDLE;
+    rcas_pipeline_ = VK_NULL_HANDLE;
+    lanczos_pipeline_ = VK_NULL_HANDLE;
+    up_layout_ = VK_NULL_HANDLE;
+    up_pool_ = VK_NULL_HANDLE;
+    up_dsl_ = VK_NULL_HANDLE;
+    std::fill(std::begin(up_sets_), std::end(up_sets_), VK_NULL_HANDLE);
+    up_w_ = up_h_ = 0;
+    up_active_ = false;
+}
+
+// Points the upscale sets and repack_up_set_ at the current out_sbs_ and up
+// images. Callers have idled the queue and drop the cached secondaries that
+// bound these sets.
+void VkRenderer::WriteUpscaleSets()
+{
+    if (up_pool_ == VK_NULL_HANDLE || up_sbs_.view == VK_NULL_HANDLE ||
+        out_sbs_view_ == VK_NULL_HANDLE)
+        return;
+    // texelFetch ignores the filter, so the repack's sampler serves the
+    // compute passes too.
+    const VkDescriptorImageInfo from_sbs{repack_sampler_, out_sbs_view_,
+                                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+    const VkDescriptorImageInfo from_tmp{repack_sampler_, up_tmp_.view, VK_IMAGE_LAYOUT_GENERAL};
+    const VkDescriptorImageInfo from_up{repack_sampler_, up_sbs_.view, VK_IMAGE_LAYOUT_GENERAL};
+    const VkDescriptorImageInfo to_tmp{VK_NULL_HANDLE, up_tmp_.view, VK_IMAGE_LAYOUT_GENERAL};
+    const VkDescriptorImageInfo to_up{VK_NULL_HANDLE, up_sbs_.view, VK_IMAGE_LAYOUT_GENERAL};
+    struct Binding {
+        VkDescriptorSet              set;
+        uint32_t                     binding;
+        const VkDescriptorImageInfo* image;
+    };
+    const Binding bindings[] = {
+        {up_sets_[0], 0, &from_sbs}, {up_sets_[0], 1, &to_tmp},
+        {up_sets_[1], 0, &from_tmp}, {up_sets_[1], 1, &to_up},
+        {up_sets_[2], 0, &from_sbs}, {up_sets_[2], 1, &to_up},
+        {repack_up_set_, 0, &from_up},
+    };
+    constexpr size_t count = sizeof(bindings) / sizeof(bindings[0]);
+    VkWriteDescriptorSet writes[count];
+    for (size_t i = 0; i < count; ++i) {
+        writes[i] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+        writes[i].dstSet = bindings[i].set;
+        writes[i].dstBinding = bindings[i].binding;
+        writes[i].descriptorCount = 1;
+        writes[i].descriptorType = bindings[i].binding == 0
+                                       ? VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
+                                       : VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[i].pImageInfo = bindings[i].image;
+    }
+    vkUpdateDescriptorSets(ctx_.device, (uint32_t)count, writes, 0, nullptr);
+}
+
+// out_sbs_ is already readable from compute (RecordFrame's to_read barrier);
+// leaves up_sbs_ readable by the repack.
+void VkRenderer::RecordUpscale(VkCommandBuffer cmd)
+{
+    // Each pass rewrites every texel, so the previous contents are dropped.
+    // The source stages cover the previous frame's reads, mirrors included.
+    VkImageMemoryBarrier to_write[2] = {
+        ImageBarrier(up_tmp_.image, 0, VK_ACCESS_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED,
+                     VK_IMAGE_LAYOUT_GENERAL),
+        ImageBarrier(up_sbs_.image, 0, VK_ACCESS_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED,
+                     VK_IMAGE_LAYOUT_GENERAL),
+    };
+    vkCmdPipelineBarrier(cmd,
+                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 2,
+                         to_write);
+
+    // One invocation per output texel of both eyes (8x8 workgroups).
+    const uint32_t groups_x = (up_w_ * 2 + 7) / 8;
+    const uint32_t groups_y = (up_h_ + 7) / 8;
+    auto dispatch = [&](VkPipeline pipeline, VkDescriptorSet set, const UpscalePush& push) {
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, up_layout_, 0, 1, &set, 0,
+                                nullptr);
+        vkCmdPushConstants(cmd, up_layout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+        vkCmdDispatch(cmd, groups_x, groups_y, 1);
+    };
+    const int32_t src_w = (int32_t)(sbs_width_ / 2);
+    const int32_t src_h = (int32_t)sbs_height_;
+    const int32_t dst_w = (int32_t)up_w_;
+    const int32_t dst_h = (int32_t)up_h_;
+    if (upscaler_ == Upscaler::Fsr) {
+        dispatch(easu_pipeline_, up_sets_[0], {src_w, src_h, dst_w, dst_h, 0.f});
+        VkImageMemoryBarrier tmp_read = ImageBarrier(
+            up_tmp_.image, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+            VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL);
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1,
+                             &tmp_read);
+        dispatch(rcas_pipeline_, up_sets_[1],
+                 {dst_w, dst_h, dst_w, dst_h, std::exp2(-kRcasStops)});
+    } else {
+        dispatch(lanczos_pipeline_, up_sets_[2], {src_w, src_h, dst_w, dst_h, 0.f});
+    }
+
+    VkImageMemoryBarrier up_read = ImageBarrier(
+        up_sbs_.image, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+        VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL);
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1,
+                         &up_read);
+}
+
+void VkRenderer::MaybeSaveScreenshot(VkCommandBuffer cmd, const EyeLayer& left,
+                                     const EyeLayer& right)
 {
     bool want = false;
     {
@@ -473,10 +1154,24 @@ void VkRenderer::MaybeSaveScreenshot(VkCommandBuffer cmd)
     if (!want)
         return;
 
-    const VkDeviceSize size = (VkDeviceSize)sbs_width_ * sbs_height_ * 4;
-    if (shot_buffer_ == VK_NULL_HANDLE || shot_w_ != sbs_width_ || shot_h_ != sbs_height_) {
+    // Always the eyes at their full render size, whatever out_sbs_ is. The
+    // previous shot has retired (shot_inflight_ is cleared only after its
+    // frame fence), so the targets can be replaced without a queue wait.
+    const uint32_t w = left.width * 2;
+    const uint32_t h = left.height;
+    const VkDeviceSize size = (VkDeviceSize)w * h * 4;
+    if (shot_buffer_ == VK_NULL_HANDLE || shot_w_ != w || shot_h_ != h) {
         if (shot_buffer_) vkDestroyBuffer(ctx_.device, shot_buffer_, nullptr);
         if (shot_memory_) vkFreeMemory(ctx_.device, shot_memory_, nullptr);
+        shot_buffer_ = VK_NULL_HANDLE;
+        shot_memory_ = VK_NULL_HANDLE;
+        shot_image_.Destroy(ctx_.device);
+        shot_w_ = shot_h_ = 0;
+        if (!vrto3d::vk::CreateImage2D(ctx_, w, h, VK_FORMAT_R8G8B8A8_UNORM,
+                                       VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                                       VK_IMAGE_TILING_OPTIMAL, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                       /*make_view=*/false, &shot_image_))
+            return;
         VkBufferCreateInfo bci{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
         bci.size = size;
         bci.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
@@ -493,25 +1188,36 @@ void VkRenderer::MaybeSaveScreenshot(VkCommandBuffer cmd)
             vkAllocateMemory(ctx_.device, &alloc, nullptr, &shot_memory_) != VK_SUCCESS)
             return;
         vkBindBufferMemory(ctx_.device, shot_buffer_, shot_memory_, 0);
-        shot_w_ = sbs_width_;
-        shot_h_ = sbs_height_;
+        shot_w_ = w;
+        shot_h_ = h;
     }
 
+    // The transfer before this already acquired both eyes for transfer reads.
+    VkImageMemoryBarrier to_dst = ImageBarrier(
+        shot_image_.image, 0, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                         0, nullptr, 0, nullptr, 1, &to_dst);
+    BlitEyes(cmd, left, right, -1, shot_image_.image, w / 2, h);
     VkImageMemoryBarrier to_src = ImageBarrier(
-        out_sbs_, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+        shot_image_.image, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
     vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
                          0, nullptr, 0, nullptr, 1, &to_src);
     VkBufferImageCopy copy{};
     copy.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
-    copy.imageExtent = {sbs_width_, sbs_height_, 1};
-    vkCmdCopyImageToBuffer(cmd, out_sbs_, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, shot_buffer_, 1,
-                           &copy);
-    VkImageMemoryBarrier back = ImageBarrier(
-        out_sbs_, VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
-        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
-                         0, nullptr, 0, nullptr, 1, &back);
+    copy.imageExtent = {w, h, 1};
+    vkCmdCopyImageToBuffer(cmd, shot_image_.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                           shot_buffer_, 1, &copy);
+    VkBufferMemoryBarrier to_host{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+    to_host.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    to_host.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    to_host.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    to_host.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    to_host.buffer = shot_buffer_;
+    to_host.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0,
+                         nullptr, 1, &to_host, 0, nullptr);
     shot_inflight_ = true;
 }
 
@@ -566,9 +1272,594 @@ void VkRenderer::FinishScreenshot()
 
 // ---------------------------------------------------------------------------
 
+bool VkRenderer::CreateFrameHash()
+{
+    VkBufferCreateInfo bci{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    bci.size = (VkDeviceSize)kHashRegions * 2 * kMaxHashTiles * sizeof(uint32_t);
+    bci.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    if (vkCreateBuffer(ctx_.device, &bci, nullptr, &hash_buffer_) != VK_SUCCESS)
+        return false;
+    VkMemoryRequirements reqs{};
+    vkGetBufferMemoryRequirements(ctx_.device, hash_buffer_, &reqs);
+    VkMemoryAllocateInfo alloc{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+    alloc.allocationSize = reqs.size;
+    alloc.memoryTypeIndex = ctx_.FindMemoryType(
+        reqs.memoryTypeBits,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (alloc.memoryTypeIndex == UINT32_MAX ||
+        vkAllocateMemory(ctx_.device, &alloc, nullptr, &hash_buffer_mem_) != VK_SUCCESS)
+        return false;
+    vkBindBufferMemory(ctx_.device, hash_buffer_, hash_buffer_mem_, 0);
+    void* mapped = nullptr;
+    if (vkMapMemory(ctx_.device, hash_buffer_mem_, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS)
+        return false;
+    hash_mapped_ = static_cast<const uint32_t*>(mapped);
+
+    VkSamplerCreateInfo sci{VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO};
+    sci.magFilter = VK_FILTER_NEAREST;
+    sci.minFilter = VK_FILTER_NEAREST;
+    sci.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sci.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sci.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    if (vkCreateSampler(ctx_.device, &sci, nullptr, &hash_sampler_) != VK_SUCCESS)
+        return false;
+
+    VkDescriptorSetLayoutBinding bindings[2] = {};
+    bindings[0].binding = 0;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    bindings[0].descriptorCount = 1;
+    bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    bindings[1].binding = 1;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[1].descriptorCount = 1;
+    bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    VkDescriptorSetLayoutCreateInfo dslci{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
+    dslci.bindingCount = 2;
+    dslci.pBindings = bindings;
+    if (vkCreateDescriptorSetLayout(ctx_.device, &dslci, nullptr, &hash_dsl_) != VK_SUCCESS)
+        return false;
+
+    VkPushConstantRange pc{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(TileHashPush)};
+    VkPipelineLayoutCreateInfo plci{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
+    plci.setLayoutCount = 1;
+    plci.pSetLayouts = &hash_dsl_;
+    plci.pushConstantRangeCount = 1;
+    plci.pPushConstantRanges = &pc;
+    if (vkCreatePipelineLayout(ctx_.device, &plci, nullptr, &hash_layout_) != VK_SUCCESS)
+        return false;
+
+    VkShaderModule cs = vrto3d::vk::CreateShaderModule(ctx_.device, tile_hash_comp_spv,
+                                                       sizeof(tile_hash_comp_spv));
+    if (!cs)
+        return false;
+    VkComputePipelineCreateInfo cpci{VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
+    cpci.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    cpci.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    cpci.stage.module = cs;
+    cpci.stage.pName = "main";
+    cpci.layout = hash_layout_;
+    const VkResult r = vkCreateComputePipelines(ctx_.device, VK_NULL_HANDLE, 1, &cpci, nullptr,
+                                                &hash_pipeline_);
+    vkDestroyShaderModule(ctx_.device, cs, nullptr);
+    if (vrto3d::vk::LogIfFailed(r, "tile hash vkCreateComputePipelines") != VK_SUCCESS)
+        return false;
+
+    // One set per region and eye; the buffer binding never changes, the
+    // eye's image is written when the region is recorded.
+    const uint32_t set_count = kHashRegions * 2;
+    VkDescriptorPoolSize pool_sizes[2] = {
+        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, set_count},
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, set_count},
+    };
+    VkDescriptorPoolCreateInfo dpci{VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
+    dpci.maxSets = set_count;
+    dpci.poolSizeCount = 2;
+    dpci.pPoolSizes = pool_sizes;
+    if (vkCreateDescriptorPool(ctx_.device, &dpci, nullptr, &hash_pool_) != VK_SUCCESS)
+        return false;
+    VkDescriptorSetLayout layouts[kHashRegions * 2];
+    std::fill(std::begin(layouts), std::end(layouts), hash_dsl_);
+    VkDescriptorSetAllocateInfo dsai{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
+    dsai.descriptorPool = hash_pool_;
+    dsai.descriptorSetCount = set_count;
+    dsai.pSetLayouts = layouts;
+    if (vkAllocateDescriptorSets(ctx_.device, &dsai, &hash_sets_[0][0]) != VK_SUCCESS)
+        return false;
+    for (int region = 0; region < kHashRegions; ++region) {
+        for (int eye = 0; eye < 2; ++eye) {
+            VkDescriptorBufferInfo buf{hash_buffer_,
+                                       (VkDeviceSize)(region * 2 + eye) * kMaxHashTiles * sizeof(uint32_t),
+                                       (VkDeviceSize)kMaxHashTiles * sizeof(uint32_t)};
+            VkWriteDescriptorSet write{VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+            write.dstSet = hash_sets_[region][eye];
+            write.dstBinding = 1;
+            write.descriptorCount = 1;
+            write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            write.pBufferInfo = &buf;
+            vkUpdateDescriptorSets(ctx_.device, 1, &write, 0, nullptr);
+        }
+    }
+
+    VkCommandBufferAllocateInfo cbai{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+    cbai.commandPool = cmd_pool_;
+    cbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    cbai.commandBufferCount = 1;
+    VkFenceCreateInfo fci{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+    return vkAllocateCommandBuffers(ctx_.device, &cbai, &probe_cmd_) == VK_SUCCESS &&
+           vkCreateFence(ctx_.device, &fci, nullptr, &probe_fence_) == VK_SUCCESS;
+}
+
+void VkRenderer::DestroyFrameHash()
+{
+    if (probe_fence_) vkDestroyFence(ctx_.device, probe_fence_, nullptr);
+    if (hash_pipeline_) vkDestroyPipeline(ctx_.device, hash_pipeline_, nullptr);
+    if (hash_layout_) vkDestroyPipelineLayout(ctx_.device, hash_layout_, nullptr);
+    if (hash_pool_) vkDestroyDescriptorPool(ctx_.device, hash_pool_, nullptr);
+    if (hash_dsl_) vkDestroyDescriptorSetLayout(ctx_.device, hash_dsl_, nullptr);
+    if (hash_sampler_) vkDestroySampler(ctx_.device, hash_sampler_, nullptr);
+    if (hash_buffer_) vkDestroyBuffer(ctx_.device, hash_buffer_, nullptr);
+    if (hash_buffer_mem_) vkFreeMemory(ctx_.device, hash_buffer_mem_, nullptr);
+    probe_fence_ = VK_NULL_HANDLE;
+    hash_pipeline_ = VK_NULL_HANDLE;
+    hash_layout_ = VK_NULL_HANDLE;
+    hash_pool_ = VK_NULL_HANDLE;
+    hash_dsl_ = VK_NULL_HANDLE;
+    hash_sampler_ = VK_NULL_HANDLE;
+    hash_buffer_ = VK_NULL_HANDLE;
+    hash_buffer_mem_ = VK_NULL_HANDLE;
+    hash_mapped_ = nullptr;
+}
+
+// The eye images must already be acquired (GENERAL, made visible to
+// transfer reads by an earlier barrier in `cmd`). Hashes the whole image,
+// UV bounds included: a change outside them only costs an idle check.
+// False when an eye has more tiles than a region holds.
+bool VkRenderer::RecordFrameHash(VkCommandBuffer cmd, const EyeLayer& left, const EyeLayer& right,
+                                 int region)
+{
+    const EyeLayer* eyes[2] = {&left, &right};
+    TileHashPush push[2] = {};
+    uint32_t tiles_y[2] = {};
+    for (int i = 0; i < 2; ++i) {
+        push[i].width = (int32_t)eyes[i]->width;
+        push[i].height = (int32_t)eyes[i]->height;
+        push[i].tiles_x = (int32_t)((eyes[i]->width + kHashTile - 1) / kHashTile);
+        tiles_y[i] = (eyes[i]->height + kHashTile - 1) / kHashTile;
+        if ((uint32_t)push[i].tiles_x * tiles_y[i] > kMaxHashTiles)
+            return false;
+    }
+
+    // The region's previous frame has retired, so its sets are free to
+    // rewrite.
+    VkDescriptorImageInfo images[2];
+    VkWriteDescriptorSet writes[2];
+    for (int i = 0; i < 2; ++i) {
+        images[i] = {hash_sampler_, eyes[i]->view, VK_IMAGE_LAYOUT_GENERAL};
+        writes[i] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+        writes[i].dstSet = hash_sets_[region][i];
+        writes[i].dstBinding = 0;
+        writes[i].descriptorCount = 1;
+        writes[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[i].pImageInfo = &images[i];
+    }
+    vkUpdateDescriptorSets(ctx_.device, 2, writes, 0, nullptr);
+
+    // Extends the acquire's visibility to the compute reads.
+    VkImageMemoryBarrier to_compute[2] = {
+        ImageBarrier(left.image, 0, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL,
+                     VK_IMAGE_LAYOUT_GENERAL),
+        ImageBarrier(right.image, 0, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL,
+                     VK_IMAGE_LAYOUT_GENERAL),
+    };
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         0, 0, nullptr, 0, nullptr, 2, to_compute);
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, hash_pipeline_);
+    for (int i = 0; i < 2; ++i) {
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, hash_layout_, 0, 1,
+                                &hash_sets_[region][i], 0, nullptr);
+        vkCmdPushConstants(cmd, hash_layout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push[i]),
+                           &push[i]);
+        vkCmdDispatch(cmd, (uint32_t)push[i].tiles_x, tiles_y[i], 1);
+        hash_tiles_[region][i] = (uint32_t)push[i].tiles_x * tiles_y[i];
+    }
+    VkBufferMemoryBarrier to_host{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+    to_host.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    to_host.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    to_host.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    to_host.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    to_host.buffer = hash_buffer_;
+    to_host.offset = (VkDeviceSize)region * 2 * kMaxHashTiles * sizeof(uint32_t);
+    to_host.size = (VkDeviceSize)2 * kMaxHashTiles * sizeof(uint32_t);
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+                         0, nullptr, 1, &to_host, 0, nullptr);
+    return true;
+}
+
+uint64_t VkRenderer::FrameHash(int region) const
+{
+    // FNV-1a over both eyes' tile values; the tile count folds in the size.
+    const uint32_t* tiles = hash_mapped_ + (size_t)region * 2 * kMaxHashTiles;
+    uint64_t hash = 1469598103934665603ull;
+    for (int eye = 0; eye < 2; ++eye) {
+        const uint32_t count = hash_tiles_[region][eye];
+        hash ^= count;
+        hash *= 1099511628211ull;
+        for (uint32_t i = 0; i < count; ++i) {
+            hash ^= tiles[(size_t)eye * kMaxHashTiles + i];
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+void VkRenderer::NoteFrameHash(uint64_t hash)
+{
+    const double now = platform::MonotonicSeconds();
+    if (!have_frame_hash_ || hash != last_frame_hash_) {
+        have_frame_hash_ = true;
+        last_frame_hash_ = hash;
+        static_since_sec_ = now;
+        if (static_idle_.exchange(false, std::memory_order_relaxed))
+            LOG() << "vk_renderer: image changed, leaving idle (" << idle_frames_dropped_
+                  << " static frames dropped)";
+        return;
+    }
+    if (!static_idle_.load(std::memory_order_relaxed) && now - static_since_sec_ >= idle_after_sec_) {
+        idle_frames_dropped_ = 0;
+        static_idle_.store(true, std::memory_order_relaxed);
+        LOG() << "vk_renderer: image static for " << idle_after_sec_ << " s, idling";
+    }
+}
+
+// Idle-mode check for a new frame: acquire its eyes, hash them and wait
+// for the readback right here (one small dispatch per eye). True when the
+// frame matches what is on screen and can be dropped.
+bool VkRenderer::ProbeStaticFrame(const EyeLayer& left, const EyeLayer& right)
+{
+    vkResetCommandBuffer(probe_cmd_, 0);
+    VkCommandBufferBeginInfo begin{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(probe_cmd_, &begin);
+    VkImageMemoryBarrier acquire[2] = {
+        ImageBarrier(left.image, VK_ACCESS_MEMORY_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                     VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL,
+                     VK_QUEUE_FAMILY_EXTERNAL, ctx_.queue_family),
+        ImageBarrier(right.image, VK_ACCESS_MEMORY_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                     VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL,
+                     VK_QUEUE_FAMILY_EXTERNAL, ctx_.queue_family),
+    };
+    vkCmdPipelineBarrier(probe_cmd_, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 2, acquire);
+    const bool hashed = RecordFrameHash(probe_cmd_, left, right, kFramesInFlight);
+    vkEndCommandBuffer(probe_cmd_);
+    if (!hashed)
+        return false;
+
+    VkSubmitInfo submit{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+    submit.commandBufferCount = 1;
+    submit.pCommandBuffers = &probe_cmd_;
+    {
+        std::lock_guard<std::mutex> qlock(ctx_.queue_mutex);
+        if (vkQueueSubmit(ctx_.queue, 1, &submit, probe_fence_) != VK_SUCCESS)
+            return false;
+    }
+    vkWaitForFences(ctx_.device, 1, &probe_fence_, VK_TRUE, UINT64_MAX);
+    vkResetFences(ctx_.device, 1, &probe_fence_);
+    NoteFrameHash(FrameHash(kFramesInFlight));
+    return static_idle_.load(std::memory_order_relaxed);
+}
+
+void VkRenderer::PaceIdleCompositor()
+{
+    using Clock = std::chrono::steady_clock;
+    if (!static_idle_.load(std::memory_order_relaxed)) {
+        idle_pace_next_ = Clock::time_point{};
+        return;
+    }
+    // The game and compositor keep rendering the same image; holding the
+    // compositor here slows both down. Bounded so a change still shows up
+    // within one idle frame.
+    const auto now = Clock::now();
+    const auto period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1.0 / kIdleFps));
+    if (idle_pace_next_ > now)
+        std::this_thread::sleep_until(std::min(idle_pace_next_, now + period));
+    idle_pace_next_ = std::max(idle_pace_next_, now) + period;
+}
+
+void VkRenderer::WaitForWork()
+{
+    // A frame posted mid-present leaves the doorbell rung, so this returns
+    // at once for it; the eventfd counter can't lose a ring.
+    const bool may_block = presenter_->PrepareEventWait();
+    epoll_event evs[4];
+    const int n = epoll_wait(epoll_fd_, evs, 4, may_block ? -1 : 0);
+    if (n < 0 && errno != EINTR) {
+        LOG() << "vk_renderer: epoll_wait failed, errno " << errno;
+        std::this_thread::sleep_for(std::chrono::milliseconds(kHousekeepingMs));
+    }
+
+    bool display_readable = false;
+    for (int i = 0; i < n; ++i) {
+        uint64_t count = 0;
+        switch (evs[i].data.u32) {
+            case kWakeDoorbell:
+                (void)!read(doorbell_fd_, &count, sizeof(count));
+                break;
+            case kWakeHousekeeping:
+                (void)!read(housekeeping_fd_, &count, sizeof(count));
+                break;
+            case kWakeDisplay:
+                display_readable = true;
+                break;
+        }
+    }
+    presenter_->FinishEventWait(display_readable);
+}
+
+void VkRenderer::NoteVsyncSample(const VsyncPending& frame, double presented_time)
+{
+    const double period = refresh_period_sec_.load(std::memory_order_relaxed);
+    if (vsync_margin_sec_ < 0.0 || period <= 0.0 || frame.tick_sec <= 0.0 || presented_time <= 0.0)
+        return;
+    // A tick with no lead sits on a vblank and aims at the next one.
+    const double aimed = frame.tick_sec + (frame.lead_sec > 0.0 ? frame.lead_sec : period);
+    if (presented_time > aimed + 0.5 * period) {
+        // Only a miss of ours if the game was delivering every refresh.
+        const double game = game_frame_interval_sec_.load(std::memory_order_relaxed);
+        if (game > 0.0 && game < period * 1.25)
+            NoteVsyncMiss();
+        return;
+    }
+    // Frames that make their vblank pay the back-off down over ~20 s at 60 Hz.
+    vsync_backoff_sec_ = std::max(0.0, std::min(vsync_backoff_sec_, period) - period / 1200.0);
+    UpdateVsyncLead();
+}
+
+void VkRenderer::NoteVsyncMiss()
+{
+    const double period = refresh_period_sec_.load(std::memory_order_relaxed);
+    if (vsync_margin_sec_ < 0.0 || period <= 0.0)
+        return;
+    vsync_backoff_sec_ = std::min(period, vsync_backoff_sec_ + 0.25 * period);
+    vsync_hold_until_sec_ = platform::MonotonicSeconds() + 2.0;
+    LOG() << "vk_renderer: vblank missed, vsync lead back-off now "
+          << vsync_backoff_sec_ * 1000.0 << " ms";
+    UpdateVsyncLead();
+}
+
+void VkRenderer::UpdateVsyncLead()
+{
+    const double period = refresh_period_sec_.load(std::memory_order_relaxed);
+    const double target = std::min(period, vsync_margin_sec_ + vsync_backoff_sec_);
+    // Right after a miss the lead may only grow.
+    const double current = vsync_lead_sec_.load(std::memory_order_relaxed);
+    if (current > 0.0 && target < current &&
+        platform::MonotonicSeconds() < vsync_hold_until_sec_)
+        return;
+    vsync_lead_sec_.store(target, std::memory_order_relaxed);
+}
+
+void VkRenderer::ConsumePresentTimings()
+{
+    // Weight of each new sample in the latency average (~16-frame window).
+    constexpr double kLatencyAlpha = 1.0 / 16.0;
+
+    vrto3d::IVkPresenter::PresentTiming t;
+    while (presenter_->PopPresentTiming(&t)) {
+        // The frame this reports on is the last one we handed over before
+        // the presenter stamped submit_time.
+        bool matched = false;
+        VsyncPending frame;
+        while (!vsync_pending_.empty() && vsync_pending_.front().present_sec <= t.submit_time) {
+            frame = vsync_pending_.front();
+            vsync_pending_.pop_front();
+            matched = true;
+        }
+        if (t.discarded) {
+            presents_discarded_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        const double latency = t.presented_time - t.submit_time;
+        const double prev = present_latency_sec_.load(std::memory_order_relaxed);
+        present_latency_sec_.store(prev == 0.0 ? latency : prev + kLatencyAlpha * (latency - prev),
+                                   std::memory_order_relaxed);
+        if (t.refresh_period > 0.0)
+            refresh_period_sec_.store(t.refresh_period, std::memory_order_relaxed);
+        if (t.msc != 0 && last_presented_msc_ != 0 && t.msc > last_presented_msc_ + 1)
+            vblanks_repeated_.fetch_add(t.msc - last_presented_msc_ - 1, std::memory_order_relaxed);
+        if (matched)
+            NoteVsyncSample(frame, t.presented_time);
+        if (t.msc != 0)
+            last_presented_msc_ = t.msc;
+        last_presented_sec_.store(t.presented_time, std::memory_order_relaxed);
+        last_vsync_sec_.store(t.presented_time, std::memory_order_relaxed);
+    }
+}
+
+double VkRenderer::PredictNextVblank(double now) const
+{
+    const double period = refresh_period_sec_.load(std::memory_order_relaxed);
+    const double last = last_presented_sec_.load(std::memory_order_relaxed);
+    if (period <= 0.0 || last <= 0.0)
+        return 0.0;
+    if (now <= last)
+        return last;
+    return last + std::ceil((now - last) / period) * period;
+}
+
+void VkRenderer::InitMirrors()
+{
+    const std::string list = vrto3d::DriverSettingString("mirrors");
+    size_t pos = 0;
+    while (pos < list.size()) {
+        size_t comma = list.find(',', pos);
+        if (comma == std::string::npos)
+            comma = list.size();
+        const std::string entry = list.substr(pos, comma - pos);
+        pos = comma + 1;
+        if (entry.empty())
+            continue;
+
+        vrto3d::vk::MirrorSpec spec;
+        if (!vrto3d::vk::ParseMirrorSpec(entry, &spec)) {
+            LOG() << "vk_renderer: ignoring mirror '" << entry
+                  << "' (expected presenter[:mode][@display])";
+            continue;
+        }
+        if (mirrors_.size() == kMaxMirrors) {
+            LOG() << "vk_renderer: at most " << kMaxMirrors << " mirrors, ignoring the rest";
+            break;
+        }
+        StereoDisplayDriverConfiguration mirror_cfg = cfg_;
+        if (spec.has_mode)
+            mirror_cfg.output_mode = spec.mode;
+        if (spec.display_index >= 0)
+            mirror_cfg.display_index = spec.display_index;
+
+        MirrorSink m;
+        m.spec = entry;
+        m.own_mode = spec.has_mode;
+        m.mode = spec.mode;
+        m.presenter = vrto3d::MakeVkPresenterByName(spec.presenter.c_str());
+        if (m.presenter)
+            m.presenter->ApplyProfile(output_profile_);
+        if (!m.presenter || !m.presenter->Init(&ctx_, mirror_cfg)) {
+            LOG() << "vk_renderer: mirror '" << entry << "' failed to start";
+            continue;
+        }
+        VkSemaphoreCreateInfo sci{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+        for (int i = 0; i < kFramesInFlight; ++i) {
+            vkCreateSemaphore(ctx_.device, &sci, nullptr, &m.acquire_sems[i]);
+            vkCreateSemaphore(ctx_.device, &sci, nullptr, &m.render_sems[i]);
+        }
+        m.worker = std::make_unique<MirrorWorker>();
+        m.worker->job_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        m.extent = m.presenter->Extent();
+        LOG() << "vk_renderer: mirror '" << entry << "' on " << m.presenter->Name() << ", "
+              << m.extent.width << "x" << m.extent.height;
+        mirrors_.push_back(std::move(m));
+    }
+    // Started once mirrors_ has stopped growing: each thread keeps a pointer
+    // to its entry.
+    for (MirrorSink& m : mirrors_)
+        m.worker->thread = std::thread(&VkRenderer::MirrorThread, this, &m);
+}
+
+void VkRenderer::MirrorThread(MirrorSink* m)
+{
+    MirrorWorker& w = *m->worker;
+    std::unique_lock<std::mutex> lock(w.mutex);
+    while (!w.stop) {
+        if (w.job) {
+            if (m->presenter->Present(w.index, w.wait_sem))
+                ++m->presented;
+            w.job = false;
+            continue;
+        }
+        // Same wait protocol as the present thread's WaitForWork, on this
+        // mirror's display fd plus the job eventfd. The lock is dropped only
+        // while blocked, which is where the present thread gets its turn.
+        const bool may_block = m->presenter->PrepareEventWait();
+        pollfd fds[2] = {{w.job_fd, POLLIN, 0}, {m->presenter->EventFd(), POLLIN, 0}};
+        lock.unlock();
+        const int n = poll(fds, 2, may_block ? static_cast<int>(kHousekeepingMs) : 0);
+        lock.lock();
+        if (n > 0 && (fds[0].revents & POLLIN)) {
+            uint64_t count = 0;
+            (void)!read(w.job_fd, &count, sizeof(count));
+        }
+        m->presenter->FinishEventWait(n > 0 && (fds[1].revents & POLLIN));
+        if (!m->presenter->PumpEvents()) {
+            w.closed.store(true, std::memory_order_release);
+            return;
+        }
+        vrto3d::IVkPresenter::PresentTiming unused;
+        while (m->presenter->PopPresentTiming(&unused)) {}
+    }
+}
+
+void VkRenderer::ApplyOutputProfile()
+{
+    if (!osd_component_)
+        return;
+    const vrto3d::OutputProfileOptions opts = osd_component_->GetOutputProfile();
+    if (opts == output_profile_)
+        return;
+    output_profile_ = opts;
+    LOG() << "vk_renderer: applying profile output options";
+    if (opts.upscaler == "fsr") {
+        upscaler_ = Upscaler::Fsr;
+    } else if (opts.upscaler == "lanczos") {
+        upscaler_ = Upscaler::Lanczos;
+    } else {
+        if (opts.upscaler != "bilinear")
+            LOG() << "vk_renderer: unknown upscaler '" << opts.upscaler << "', using bilinear";
+        upscaler_ = Upscaler::Bilinear;
+    }
+    presenter_->ApplyProfile(opts);
+    for (MirrorSink& m : mirrors_) {
+        if (!m.presenter)
+            continue;
+        std::lock_guard<std::mutex> lock(m.worker->mutex);
+        m.presenter->ApplyProfile(opts);
+        m.extent = m.presenter->Extent();
+    }
+    // Targets may have been rebuilt at a different size.
+    InvalidateCachedCmds();
+}
+
+void VkRenderer::DropMirror(size_t index)
+{
+    // The slot stays in mirrors_ (epoll keys are indices), just emptied.
+    MirrorSink& m = mirrors_[index];
+    if (!m.presenter)
+        return;
+    if (m.worker) {
+        {
+            std::lock_guard<std::mutex> lock(m.worker->mutex);
+            m.worker->stop = true;
+        }
+        const uint64_t one = 1;
+        (void)!write(m.worker->job_fd, &one, sizeof(one));
+        if (m.worker->thread.joinable())
+            m.worker->thread.join();
+        close(m.worker->job_fd);
+        m.worker.reset();
+    }
+    {
+        std::lock_guard<std::mutex> qlock(ctx_.queue_mutex);
+        vkQueueWaitIdle(ctx_.queue);
+    }
+    LOG() << "vk_renderer: mirror '" << m.spec << "' stopped: " << m.presented
+          << " frames presented, " << m.dropped << " dropped";
+    m.presenter->Shutdown();
+    m.presenter.reset();
+    InvalidateCachedCmds();
+    if (m.pipeline) vkDestroyPipeline(ctx_.device, m.pipeline, nullptr);
+    m.pipeline = VK_NULL_HANDLE;
+    for (int i = 0; i < kFramesInFlight; ++i) {
+        if (m.acquire_sems[i]) vkDestroySemaphore(ctx_.device, m.acquire_sems[i], nullptr);
+        if (m.render_sems[i]) vkDestroySemaphore(ctx_.device, m.render_sems[i], nullptr);
+        m.acquire_sems[i] = VK_NULL_HANDLE;
+        m.render_sems[i] = VK_NULL_HANDLE;
+    }
+}
+
+void VkRenderer::DestroyMirrors()
+{
+    for (size_t i = 0; i < mirrors_.size(); ++i)
+        DropMirror(i);
+    mirrors_.clear();
+}
+
 void VkRenderer::PresentThread()
 {
     presenter_ = vrto3d::MakeVkPresenter(cfg_);
+    if (osd_component_)
+        output_profile_ = osd_component_->GetOutputProfile();
+    if (presenter_)
+        presenter_->ApplyProfile(output_profile_);
     if (!presenter_ || !presenter_->Init(&ctx_, cfg_)) {
         LOG() << "vk_renderer: presenter init failed — no output window. Frames will be dropped.";
         presenter_.reset();
@@ -591,31 +1882,54 @@ void VkRenderer::PresentThread()
     cbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
     cbai.commandBufferCount = kFramesInFlight;
     vkAllocateCommandBuffers(ctx_.device, &cbai, cmd_bufs_);
+    vkAllocateCommandBuffers(ctx_.device, &cbai, mirror_cmd_bufs_);
+    cbai.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+    cbai.commandBufferCount = 1;
+    for (CachedCmd& c : transfer_cache_)
+        vkAllocateCommandBuffers(ctx_.device, &cbai, &c.cmd);
+    for (CachedCmd& c : repack_cache_)
+        vkAllocateCommandBuffers(ctx_.device, &cbai, &c.cmd);
+    if (idle_after_sec_ > 0.0 && !CreateFrameHash()) {
+        LOG() << "vk_renderer: frame hash setup failed, static-frame idle disabled";
+        DestroyFrameHash();
+    }
     for (int i = 0; i < kFramesInFlight; ++i) {
         VkFenceCreateInfo fci{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
         fci.flags = VK_FENCE_CREATE_SIGNALED_BIT;
         vkCreateFence(ctx_.device, &fci, nullptr, &frame_fences_[i]);
+        vkCreateFence(ctx_.device, &fci, nullptr, &mirror_fences_[i]);
         VkSemaphoreCreateInfo sci{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
-        vkCreateSemaphore(ctx_.device, &sci, nullptr, &acquire_sems_[i]);
+        for (uint32_t t = 0; t < kMaxPresentTargets; ++t)
+            vkCreateSemaphore(ctx_.device, &sci, nullptr, &acquire_sems_[i][t]);
         vkCreateSemaphore(ctx_.device, &sci, nullptr, &render_sems_[i]);
     }
 
+    if (vrr_requested_) {
+        const bool accepted = presenter_->SetVariableRefresh(true);
+        vrr_active_.store(accepted, std::memory_order_relaxed);
+        LOG() << "vk_renderer: variable refresh " << (accepted ? "requested from " : "unavailable on ")
+              << presenter_->Name();
+    }
+
+    if (presenter_->EventFd() >= 0) {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u32 = kWakeDisplay;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, presenter_->EventFd(), &ev);
+    }
+    InitMirrors();
+
     while (running_.load()) {
         EyeLayer left, right;
         bool have_frame = false;
-        {
-            std::unique_lock<std::mutex> lock(frame_mutex_);
-            frame_cv_.wait_for(lock, std::chrono::milliseconds(50), [&] {
-                return pending_seq_ != consumed_seq_ || !running_.load();
-            });
-            if (!running_.load())
-                break;
-            if (pending_seq_ != consumed_seq_) {
-                consumed_seq_ = pending_seq_;
-                left = pending_left_;
-                right = pending_right_;
-                have_frame = left.image != VK_NULL_HANDLE && right.image != VK_NULL_HANDLE;
-            }
+        WaitForWork();
+        if (!running_.load())
+            break;
+        FramePair frame;
+        if (frames_.Take(&frame)) {
+            left = frame.left;
+            right = frame.right;
+            have_frame = left.image != VK_NULL_HANDLE && right.image != VK_NULL_HANDLE;
         }
 
         if (!presenter_->PumpEvents()) {
@@ -623,6 +1937,14 @@ void VkRenderer::PresentThread()
             std::thread([] { RequestSteamVRShutdownWithApp(g_current_app_pid.load()); }).detach();
             break;
         }
+        ConsumePresentTimings();
+        for (size_t i = 0; i < mirrors_.size(); ++i) {
+            MirrorSink& m = mirrors_[i];
+            if (m.presenter && m.worker->closed.load(std::memory_order_acquire)) {
+                LOG() << "vk_renderer: mirror '" << m.spec << "' closed";
+                DropMirror(i);
+            }
+        }
         // Focus/z-order + input capture, edge-tracked on the present thread
         // (the only thread that may touch the display connection). This mirrors
         // the Windows WindowPresenter::FocusThreadLoop: start lowered; raise
@@ -643,7 +1965,7 @@ void VkRenderer::PresentThread()
             fi.man_on_top  = focus_.man_on_top && focus_.man_on_top->load();
             fi.auto_focus  = focus_.auto_focus ? focus_.auto_focus->load() : true;
             fi.app_pid     = focus_.app_pid ? focus_.app_pid->load() : 0;
-            fi.app_running = fi.app_pid != 0 && platform::IsProcessRunning(fi.app_pid);
+            fi.app_running = vrto3d::ProcessWatch::Instance().IsRunning(fi.app_pid);
             fi.force_on_top = menu_open;  // an open OSD must be visible to use
 
             bool set_is_on_top = false, set_man_on_top = false;
@@ -665,10 +1987,22 @@ void VkRenderer::PresentThread()
                       << " running=" << fi.app_running
                       << " menu=" << menu_open << ")";
                 presenter_->SetAlwaysOnTop(want_on_top);
+                for (MirrorSink& m : mirrors_) {
+                    if (!m.presenter)
+                        continue;
+                    std::lock_guard<std::mutex> lock(m.worker->mutex);
+                    m.presenter->SetAlwaysOnTop(want_on_top);
+                }
                 last_on_top_ = want_on_top;
             }
             if (!focus_state_init_ || want_capture != last_capture_) {
                 presenter_->SetInputCapture(want_capture);
+                for (MirrorSink& m : mirrors_) {
+                    if (!m.presenter)
+                        continue;
+                    std::lock_guard<std::mutex> lock(m.worker->mutex);
+                    m.presenter->SetInputCapture(want_capture);
+                }
                 last_capture_ = want_capture;
             }
             focus_state_init_ = true;
@@ -677,8 +2011,14 @@ void VkRenderer::PresentThread()
         if (!have_frame)
             continue;
 
-        if (!EnsureOutputImage(left.width, left.height) || !EnsureRepackPipeline())
+        ApplyOutputProfile();
+        uint32_t eye_w = 0, eye_h = 0;
+        int only_eye = -1;
+        PlanEyeTransfer(left, &eye_w, &eye_h, &only_eye);
+        if (!EnsureOutputImage(eye_w, eye_h) || !EnsureRepackPipeline())
             continue;
+        EnsureMirrorPipelines();
+        EnsureUpscale();
 
         // Lazy OSD init once dimensions are known.
         if (osd_config_pending_ && osd_component_ && osd_callbacks_) {
@@ -692,38 +2032,140 @@ void VkRenderer::PresentThread()
             }
         }
 
+        // Static-frame idle: drop frames that match what is on screen. An
+        // open OSD or a pending screenshot needs real frames.
+        if (static_idle_.load(std::memory_order_relaxed)) {
+            bool shot_pending = false;
+            {
+                std::lock_guard<std::mutex> lock(shot_mutex_);
+                shot_pending = shot_requested_;
+            }
+            if (shot_pending || (osd_renderer_ && osd_renderer_->HasContent())) {
+                static_idle_.store(false, std::memory_order_relaxed);
+                have_frame_hash_ = false;
+            } else if (ProbeStaticFrame(left, right)) {
+                ++idle_frames_dropped_;
+                continue;
+            }
+        }
+
         const int slot = frame_slot_;
         frame_slot_ = (frame_slot_ + 1) % kFramesInFlight;
         vkWaitForFences(ctx_.device, 1, &frame_fences_[slot], VK_TRUE, UINT64_MAX);
         if (shot_inflight_)
             FinishScreenshot();
+        if (hash_pending_[slot]) {
+            hash_pending_[slot] = false;
+            NoteFrameHash(FrameHash(slot));
+        }
         vkResetFences(ctx_.device, 1, &frame_fences_[slot]);
 
-        vrto3d::IVkPresenter::FrameTarget target{};
-        if (!presenter_->AcquireNext(&target, acquire_sems_[slot])) {
+        // DualDisplay lockstep presenters hand out one target per eye's
+        // output; everything below records, submits and presents them as
+        // one frame.
+        const uint32_t target_count = std::min(presenter_->TargetCount(), kMaxPresentTargets);
+        vrto3d::IVkPresenter::FrameTarget targets[kMaxPresentTargets]{};
+        if (!presenter_->AcquireTargets(targets, acquire_sems_[slot])) {
             // Swapchain went stale (resize etc.) — pipeline must follow the
             // new render pass on the next round if the presenter recreated it.
             continue;
         }
+        FrameTargetBits bits[kMaxPresentTargets]{};
+        VkSemaphore wait_sems[kMaxPresentTargets]{};
+        VkPipelineStageFlags wait_stages[kMaxPresentTargets]{};
+        uint32_t wait_count = 0;
+        for (uint32_t t = 0; t < target_count; ++t) {
+            bits[t] = {targets[t].framebuffer, presenter_->TargetExtent(t),
+                       target_count > 1 ? (int)t : -1, repack_render_pass_, repack_pipeline_,
+                       presenter_.get(), nullptr, RepackParamsOffset(slot, t)};
+            if (targets[t].framebuffer == VK_NULL_HANDLE)
+                continue;
+            wait_sems[wait_count] = acquire_sems_[slot][t];
+            wait_stages[wait_count] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+            ++wait_count;
+        }
+
+        // Mirrors never wait: one whose thread is still presenting, whose
+        // consumer still holds every buffer, or whose previous batch in this
+        // slot hasn't retired sits this frame out.
+        const bool mirror_slot_free =
+            vkGetFenceStatus(ctx_.device, mirror_fences_[slot]) == VK_SUCCESS;
+        vrto3d::IVkPresenter::FrameTarget mirror_targets[kMaxMirrors]{};
+        FrameTargetBits mirror_bits[kMaxMirrors]{};
+        size_t mirror_index[kMaxMirrors]{};
+        VkSemaphore mirror_waits[kMaxMirrors]{};
+        VkPipelineStageFlags mirror_stages[kMaxMirrors]{};
+        VkSemaphore mirror_signals[kMaxMirrors]{};
+        uint32_t mirror_count = 0;
+        for (size_t i = 0; i < mirrors_.size(); ++i) {
+            MirrorSink& m = mirrors_[i];
+            if (!m.presenter || m.pipeline == VK_NULL_HANDLE)
+                continue;
+            vrto3d::IVkPresenter::FrameTarget& mt = mirror_targets[mirror_count];
+            VkRenderPass render_pass;
+            {
+                std::unique_lock<std::mutex> lock(m.worker->mutex, std::try_to_lock);
+                if (!mirror_slot_free || !lock.owns_lock() || m.worker->job ||
+                    !m.presenter->TryAcquireNext(&mt, m.acquire_sems[slot])) {
+                    ++m.dropped;
+                    continue;
+                }
+                m.extent = m.presenter->Extent();
+                render_pass = m.presenter->RenderPass();
+            }
+            mirror_bits[mirror_count] = {mt.framebuffer, m.extent, -1,
+                                         render_pass, m.pipeline, m.presenter.get(),
+                                         m.own_mode ? &m.mode : nullptr,
+                                         RepackParamsOffset(slot, kMaxPresentTargets + mirror_count)};
+            mirror_index[mirror_count] = i;
+            mirror_waits[mirror_count] = m.acquire_sems[slot];
+            mirror_stages[mirror_count] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+            mirror_signals[mirror_count] = m.render_sems[slot];
+            ++mirror_count;
+        }
 
         VkCommandBuffer cmd = cmd_bufs_[slot];
         vkResetCommandBuffer(cmd, 0);
         VkCommandBufferBeginInfo begin{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
         begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
         vkBeginCommandBuffer(cmd, &begin);
-        FrameTargetBits bits{target.framebuffer, presenter_->Extent()};
-        RecordFrame(cmd, left, right, bits);
+        RecordFrame(cmd, left, right, only_eye, bits, target_count);
+        if (hash_pipeline_ != VK_NULL_HANDLE)
+            hash_pending_[slot] = RecordFrameHash(cmd, left, right, slot);
         vkEndCommandBuffer(cmd);
 
-        VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        // Mirror repacks go in a submit of their own with their own waits and
+        // fence, so a mirror image that is slow to free up never delays the
+        // primary's render semaphore or frame fence. out_sbs_ (or up_sbs_) is
+        // already readable from the primary batch, whose barrier covers these
+        // later reads too.
+        VkCommandBuffer mirror_cmd = mirror_cmd_bufs_[slot];
+        if (mirror_count > 0) {
+            vkResetCommandBuffer(mirror_cmd, 0);
+            vkBeginCommandBuffer(mirror_cmd, &begin);
+            for (uint32_t k = 0; k < mirror_count; ++k) {
+                RecordRepack(mirror_cmd, mirror_bits[k], up_active_ ? up_w_ : sbs_width_ / 2,
+                             up_active_ ? up_h_ : sbs_height_);
+            }
+            vkEndCommandBuffer(mirror_cmd);
+        }
+
         VkSubmitInfo submit{VK_STRUCTURE_TYPE_SUBMIT_INFO};
-        submit.waitSemaphoreCount = 1;
-        submit.pWaitSemaphores = &acquire_sems_[slot];
-        submit.pWaitDstStageMask = &wait_stage;
+        submit.waitSemaphoreCount = wait_count;
+        submit.pWaitSemaphores = wait_sems;
+        submit.pWaitDstStageMask = wait_stages;
         submit.commandBufferCount = 1;
         submit.pCommandBuffers = &cmd;
         submit.signalSemaphoreCount = 1;
         submit.pSignalSemaphores = &render_sems_[slot];
+        VkSubmitInfo mirror_submit{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+        mirror_submit.waitSemaphoreCount = mirror_count;
+        mirror_submit.pWaitSemaphores = mirror_waits;
+        mirror_submit.pWaitDstStageMask = mirror_stages;
+        mirror_submit.commandBufferCount = 1;
+        mirror_submit.pCommandBuffers = &mirror_cmd;
+        mirror_submit.signalSemaphoreCount = mirror_count;
+        mirror_submit.pSignalSemaphores = mirror_signals;
         {
             std::lock_guard<std::mutex> qlock(ctx_.queue_mutex);
             if (vrto3d::vk::LogIfFailed(vkQueueSubmit(ctx_.queue, 1, &submit, frame_fences_[slot]),
@@ -731,11 +2173,42 @@ void VkRenderer::PresentThread()
                 device_dead_.store(true, std::memory_order_release);
                 break;
             }
+            if (mirror_count > 0) {
+                vkResetFences(ctx_.device, 1, &mirror_fences_[slot]);
+                if (vrto3d::vk::LogIfFailed(vkQueueSubmit(ctx_.queue, 1, &mirror_submit,
+                                                          mirror_fences_[slot]),
+                                            "mirror vkQueueSubmit") != VK_SUCCESS) {
+                    device_dead_.store(true, std::memory_order_release);
+                    break;
+                }
+            }
+        }
+        if (vsync_margin_sec_ >= 0.0 && presenter_->HasPresentTiming() && frame.tick_sec > 0.0 &&
+            frame.tick_lead_sec >= 0.0) {
+            if (vsync_pending_.size() >= 8)
+                vsync_pending_.pop_front();  // feedback stopped; don't grow
+            vsync_pending_.push_back({platform::MonotonicSeconds(), frame.tick_sec,
+                                      frame.tick_lead_sec});
+        }
+        presenter_->PresentTargets(targets, render_sems_[slot]);
+        for (uint32_t k = 0; k < mirror_count; ++k) {
+            MirrorWorker& w = *mirrors_[mirror_index[k]].worker;
+            {
+                std::lock_guard<std::mutex> lock(w.mutex);
+                w.job = true;
+                w.index = mirror_targets[k].index;
+                w.wait_sem = mirrors_[mirror_index[k]].render_sems[slot];
+            }
+            const uint64_t one = 1;
+            (void)!write(w.job_fd, &one, sizeof(one));
         }
-        presenter_->Present(target.index, render_sems_[slot]);
 
+        ++submit_serial_;
         frame_counter_.fetch_add(1, std::memory_order_relaxed);
-        last_vsync_sec_.store(platform::MonotonicSeconds(), std::memory_order_relaxed);
+        // With presentation feedback, ConsumePresentTimings stores the real
+        // scanout time instead of this submit-time approximation.
+        if (!presenter_->HasPresentTiming())
+            last_vsync_sec_.store(platform::MonotonicSeconds(), std::memory_order_relaxed);
     }
 
     // Teardown on this thread (presenter + OSD are thread-affine).
@@ -747,9 +2220,15 @@ void VkRenderer::PresentThread()
         osd_renderer_->Shutdown();
         osd_renderer_.reset();
     }
+    DestroyMirrors();
+    DestroyFrameHash();
+    DestroyUpscale();
     for (int i = 0; i < kFramesInFlight; ++i) {
         if (frame_fences_[i]) vkDestroyFence(ctx_.device, frame_fences_[i], nullptr);
-        if (acquire_sems_[i]) vkDestroySemaphore(ctx_.device, acquire_sems_[i], nullptr);
+        if (mirror_fences_[i]) vkDestroyFence(ctx_.device, mirror_fences_[i], nullptr);
+        for (uint32_t t = 0; t < kMaxPresentTargets; ++t) {
+            if (acquire_sems_[i][t]) vkDestroySemaphore(ctx_.device, acquire_sems_[i][t], nullptr);
+        }
         if (render_sems_[i]) vkDestroySemaphore(ctx_.device, render_sems_[i], nullptr);
     }
     if (cmd_pool_) vkDestroyCommandPool(ctx_.device, cmd_pool_, nullptr);
@@ -758,11 +2237,14 @@ void VkRenderer::PresentThread()
     if (repack_pool_) vkDestroyDescriptorPool(ctx_.device, repack_pool_, nullptr);
     if (repack_dsl_) vkDestroyDescriptorSetLayout(ctx_.device, repack_dsl_, nullptr);
     if (repack_sampler_) vkDestroySampler(ctx_.device, repack_sampler_, nullptr);
+    if (repack_params_) vkDestroyBuffer(ctx_.device, repack_params_, nullptr);
+    if (repack_params_mem_) vkFreeMemory(ctx_.device, repack_params_mem_, nullptr);
     if (out_sbs_view_) vkDestroyImageView(ctx_.device, out_sbs_view_, nullptr);
     if (out_sbs_) vkDestroyImage(ctx_.device, out_sbs_, nullptr);
     if (out_sbs_mem_) vkFreeMemory(ctx_.device, out_sbs_mem_, nullptr);
     if (shot_buffer_) vkDestroyBuffer(ctx_.device, shot_buffer_, nullptr);
     if (shot_memory_) vkFreeMemory(ctx_.device, shot_memory_, nullptr);
+    shot_image_.Destroy(ctx_.device);
     if (presenter_) {
         presenter_->Shutdown();
         presenter_.reset();
@@ -771,12 +2253,76 @@ void VkRenderer::PresentThread()
 
 void VkRenderer::VsyncTickThread()
 {
-    const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
-        std::chrono::duration<double>(1.0 / display_frequency_));
-    auto next = std::chrono::steady_clock::now();
+    using Clock = std::chrono::steady_clock;
+    const double interval_sec = 1.0 / display_frequency_;
+    // VRR floor: below this most panels fall back to frame doubling anyway.
+    constexpr double kVrrMinHz = 30.0;
+    bool throttled_to_output = false;
+    auto next = Clock::now();
+    // How far ahead of its vblank `next` was placed; < 0 when it wasn't
+    // aligned to one.
+    double next_lead = -1.0;
     while (running_.load()) {
-        vr::VRServerDriverHost()->VsyncEvent(0.0);
-        next += interval;
+        // The offset is the vblank's time relative to now: the tick's lead
+        // ahead of it, less however late the sleep woke us.
+        const double woke_late = std::chrono::duration<double>(Clock::now() - next).count();
+        vr::VRServerDriverHost()->VsyncEvent(std::max(0.0, next_lead) - std::max(0.0, woke_late));
+        last_tick_lead_sec_.store(next_lead, std::memory_order_relaxed);
+        last_tick_sec_.store(platform::MonotonicSeconds() - std::max(0.0, woke_late),
+                             std::memory_order_relaxed);
+        next_lead = -1.0;
+        if (auto* component = vsync_component_.load(std::memory_order_acquire))
+            component->FlushPublishedProperties();
+
+        if (vrr_active_.load(std::memory_order_relaxed)) {
+            // The display refreshes when we present, so tick at the game's own
+            // rate. Running 2% ahead of it lets a recovering game climb back
+            // toward display_frequency instead of being held at its low.
+            const double game = game_frame_interval_sec_.load(std::memory_order_relaxed);
+            double hz = game > 0.0 ? 1.02 / game : display_frequency_;
+            hz = std::clamp(hz, kVrrMinHz, static_cast<double>(display_frequency_));
+            next += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / hz));
+            // Don't burst to catch up after a stall.
+            next = std::max(next, Clock::now());
+            std::this_thread::sleep_until(next);
+            continue;
+        }
+        // Never tick faster than the output really refreshes. A fixed-timing
+        // output (a 24p frame-packed mode, or a presenter that fell back to
+        // a slower mode) can sit below display_frequency; ticking at the
+        // presenter's measured cadence keeps SteamVR from having the game
+        // render frames that are never shown.
+        const double period = refresh_period_sec_.load(std::memory_order_relaxed);
+        const bool output_bound = period > interval_sec * 1.05;
+        if (output_bound != throttled_to_output) {
+            throttled_to_output = output_bound;
+            LOG() << "vk_renderer: vsync ticks "
+                  << (output_bound ? "throttled to the output's " : "back at ")
+                  << (output_bound ? 1.0 / period : 1.0 / interval_sec) << " Hz";
+        }
+        const double tick_sec = output_bound ? period : interval_sec;
+        next += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(tick_sec));
+
+        // With presentation feedback the display's vblank phase is known:
+        // snap the tick onto it so SteamVR's frame timing starts where the
+        // scanout does instead of at an arbitrary offset, or the phase
+        // controller's lead ahead of it. Only meaningful when the tick rate
+        // divides the refresh rate.
+        const double last = last_presented_sec_.load(std::memory_order_relaxed);
+        if (period > 0.0 && last > 0.0) {
+            const double ratio = tick_sec / period;
+            if (std::round(ratio) >= 1.0 && std::fabs(ratio - std::round(ratio)) < 0.05) {
+                const auto steady_now = Clock::now();
+                const double now = platform::MonotonicSeconds();
+                const double target = now + std::chrono::duration<double>(next - steady_now).count();
+                const double lead = vsync_lead_sec_.load(std::memory_order_relaxed);
+                const double anchor = last - lead;
+                const double snapped = anchor + std::round((target - anchor) / period) * period;
+                next = steady_now + std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(snapped - now));
+                next_lead = lead;
+            }
+        }
         std::this_thread::sleep_until(next);
     }
 }
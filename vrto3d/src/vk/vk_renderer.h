@@ -19,16 +19,20 @@
 // Linux twin of Dx11Renderer. The Linux compositor pre-composites all apps and
 // overlays and submits a single layer pair per frame, so unlike the Windows
 // path there is no multi-layer composite: import the compositor's shared
-// images once, per frame blit L/R
-// into out_sbs_, run the OSD, then repack into the presenter's swapchain.
+// images once, per frame blit L/R into out_sbs_, run the OSD, optionally
+// upscale it (up_sbs_), then repack into the presenter's swapchain — and
+// into each mirror output's (driver_vrto3d/mirrors), from the same image.
 
+#include <array>
 #include <atomic>
-#include <condition_variable>
+#include <chrono>
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <vulkan/vulkan.h>
 
@@ -36,6 +40,8 @@
 
 #include "focus_context.h"
 #include "focus_policy.h"
+#include "profile_sidecar.h"
+#include "vk/frame_mailbox.h"
 #include "vk/vk_context.h"
 #include "vrto3dlib/stereo_config.h"
 
@@ -68,9 +74,10 @@ public:
     };
 
     // Called from IVRDriverDirectModeComponent::Present (compositor thread).
-    // Snapshots the pair and wakes the present thread. Cheap — no Vulkan work
-    // happens on the compositor thread (implicit dmabuf sync orders the
-    // compositor's rendering against our sampling at submit time).
+    // Snapshots the pair into a lock-free mailbox and wakes the present
+    // thread; never blocks on it. Cheap — no Vulkan work happens on the
+    // compositor thread (implicit dmabuf sync orders the compositor's
+    // rendering against our sampling at submit time). Single caller only.
     void OnDirectModeFrame(const EyeLayer& left, const EyeLayer& right);
 
     // OSD plumbing (mirrors Dx11Renderer). `native_window` is unused on Linux
@@ -95,19 +102,116 @@ public:
     void WaitIdleForTextureRelease();
 
     uint64_t FrameCounter() const { return frame_counter_.load(std::memory_order_relaxed); }
+    // Compositor frames replaced before the present thread picked them up.
+    uint64_t FramesOverwritten() const { return frames_.Overwritten(); }
+
+    // Display-side results, when the presenter reports presentation
+    // feedback (IVkPresenter::HasPresentTiming); zero otherwise.
+    // Latency is Present() to first light, smoothed over recent frames.
+    double   PresentLatencySeconds() const { return present_latency_sec_.load(std::memory_order_relaxed); }
+    double   RefreshPeriodSeconds() const { return refresh_period_sec_.load(std::memory_order_relaxed); }
+    // Frames the display server superseded without ever showing.
+    uint64_t PresentsDiscarded() const { return presents_discarded_.load(std::memory_order_relaxed); }
+    // Vblanks that repeated the previous frame between two presented ones.
+    // Includes gaps from the game rendering below refresh rate.
+    uint64_t VblanksRepeated() const { return vblanks_repeated_.load(std::memory_order_relaxed); }
+    // First vblank at or after `now` extrapolated from the last presented
+    // frame, or 0 when the refresh period is unknown.
+    double   PredictNextVblank(double now) const;
     double   LastVsyncQpcSec() const { return last_vsync_sec_.load(std::memory_order_relaxed); }
+    // How far ahead of the next vblank VsyncEvent fires (driver_vrto3d/vsync_margin_ms);
+    // 0 when the ticks sit on the vblank.
+    double   VsyncLeadSeconds() const { return vsync_lead_sec_.load(std::memory_order_relaxed); }
+    // Variable refresh (driver_vrto3d/variable_refresh, accepted by the presenter): vsync
+    // ticks follow the game's measured frame rate instead of display_frequency.
+    bool     VariableRefreshActive() const { return vrr_active_.load(std::memory_order_relaxed); }
     bool     IsDeviceDead() const { return device_dead_.load(std::memory_order_acquire); }
+    // True while the game's image has stayed unchanged long enough that
+    // frames are no longer repacked or presented (driver_vrto3d/static_idle_seconds).
+    bool     StaticIdle() const { return static_idle_.load(std::memory_order_relaxed); }
+    // Called from DirectModeComponentVk::PostPresent (compositor thread).
+    // While StaticIdle, holds the compositor to kIdleFps; otherwise returns
+    // at once.
+    void     PaceIdleCompositor();
 
     vrto3d::vk::DeviceCtx& Ctx() { return ctx_; }
 
 private:
     void PresentThread();
     void VsyncTickThread();
+    // Blocks the present thread in its epoll set until a frame, a display
+    // event, a doorbell, or the housekeeping tick arrives.
+    void WaitForWork();
+    void RingDoorbell();
+    // Folds the presenter's completed PresentTimings into the stats above.
+    void ConsumePresentTimings();
+    // Vsync phase controller inputs (present thread): where a frame really
+    // landed (its PresentTiming's presented_time) against the vblank its
+    // tick aimed at, and a vblank we should have made.
+    struct VsyncPending;
+    void NoteVsyncSample(const VsyncPending& frame, double presented_time);
+    void NoteVsyncMiss();
+    void UpdateVsyncLead();
+    // Per-eye size for out_sbs_ and which eyes to copy into it this frame
+    // (*only_eye = -1 for both). See the definition for the rules.
+    void PlanEyeTransfer(const EyeLayer& left, uint32_t* eye_w, uint32_t* eye_h, int* only_eye);
+    // Largest per-eye area any output shows at its own resolution (0 x 0
+    // while no extent is known); *all_mono when every sink shows one eye.
+    void ShownEyeSize(const StereoDisplayDriverConfiguration& cfg, uint32_t* shown_w,
+                      uint32_t* shown_h, bool* all_mono) const;
     bool EnsureOutputImage(uint32_t eye_w, uint32_t eye_h);
     bool EnsureRepackPipeline();
+    VkPipeline CreateRepackPipeline(VkRenderPass render_pass);
+    void EnsureMirrorPipelines();
+    // Upscale stage (see up_active_): EnsureUpscale decides per frame
+    // whether it runs and (re)sizes its images; RecordUpscale fills up_sbs_.
+    void EnsureUpscale();
+    bool CreateUpscale();
+    void DestroyUpscale();
+    void WriteUpscaleSets();
+    void RecordUpscale(VkCommandBuffer cmd);
+    // Mirror outputs: parsed from driver_vrto3d/mirrors and brought up after
+    // the primary presenter; DropMirror retires one whose output went away.
+    // MirrorThread pumps a mirror's events and runs its Present() calls.
+    struct MirrorSink;
+    void InitMirrors();
+    void MirrorThread(MirrorSink* m);
+    // Pushes the active profile's OutputProfileOptions to every presenter
+    // when they differ from what was last applied (present thread).
+    void ApplyOutputProfile();
+    void DropMirror(size_t index);
+    void DestroyMirrors();
     void RecordFrame(VkCommandBuffer cmd, const EyeLayer& left, const EyeLayer& right,
-                     const struct FrameTargetBits& target);
-    void MaybeSaveScreenshot(VkCommandBuffer cmd);
+                     int only_eye, const struct FrameTargetBits* targets, uint32_t target_count);
+    void RecordRepack(VkCommandBuffer cmd, const struct FrameTargetBits& target, uint32_t eye_w,
+                      uint32_t eye_h);
+    // Byte offset of ring entry `entry` of frame slot `slot` in repack_params_.
+    uint32_t RepackParamsOffset(int slot, uint32_t entry) const;
+    void RecordTransfer(VkCommandBuffer cmd, const EyeLayer& left, const EyeLayer& right,
+                        int only_eye);
+    // Secondary command buffer cache (see RecordFrame). LookupCachedCmd
+    // returns the entry recorded for `key` (*hit = true), or a retired one
+    // re-keyed for the caller to record, or null when every entry may still
+    // be executing.
+    struct CachedCmd;
+    VkCommandBuffer LookupCachedCmd(CachedCmd* cache, int count, const void* key, size_t key_size,
+                                    bool* hit);
+    void InvalidateCachedCmds();
+    // Static-frame detection: a compute pass hashes every texel of both
+    // eyes into per-tile values, folded on the CPU once the frame's fence
+    // has passed (shaders/tile_hash.comp).
+    bool CreateFrameHash();
+    void DestroyFrameHash();
+    bool RecordFrameHash(VkCommandBuffer cmd, const EyeLayer& left, const EyeLayer& right,
+                         int region);
+    uint64_t FrameHash(int region) const;
+    void NoteFrameHash(uint64_t hash);
+    bool ProbeStaticFrame(const EyeLayer& left, const EyeLayer& right);
+    // Blits the eyes (UV bounds honored) into the two halves of `dst`, each
+    // eye_w x eye_h; only_eye >= 0 skips the other one.
+    void BlitEyes(VkCommandBuffer cmd, const EyeLayer& left, const EyeLayer& right, int only_eye,
+                  VkImage dst, uint32_t eye_w, uint32_t eye_h);
+    void MaybeSaveScreenshot(VkCommandBuffer cmd, const EyeLayer& left, const EyeLayer& right);
     void FinishScreenshot();
 
     vrto3d::vk::DeviceCtx ctx_;
@@ -124,6 +228,10 @@ private:
     uint32_t       sbs_width_ = 0;
     uint32_t       sbs_height_ = 0;
     bool           out_sbs_initialized_ = false;  // layout tracking
+    bool           sparse_eyes_ = true;  // driver_vrto3d/sparse_eyes off always copies full eyes
+    // Until then PlanEyeTransfer keeps out_sbs_ at full size after the OSD
+    // drew, so short-lived OSD popups don't reallocate it twice each.
+    double         osd_full_size_until_sec_ = 0.0;
 
     // Repack pipeline (fullscreen triangle sampling out_sbs_ into swapchain).
     VkDescriptorSetLayout repack_dsl_ = VK_NULL_HANDLE;
@@ -133,23 +241,137 @@ private:
     VkDescriptorSet       repack_set_ = VK_NULL_HANDLE;
     VkSampler             repack_sampler_ = VK_NULL_HANDLE;
     VkRenderPass          repack_render_pass_ = VK_NULL_HANDLE;  // presenter's
+    // Same layout, sampling up_sbs_ instead (while up_active_).
+    VkDescriptorSet       repack_up_set_ = VK_NULL_HANDLE;
+
+    // Upscale stage (profile key upscaler). When some output shows more of
+    // an eye than out_sbs_ holds, a compute pass scales out_sbs_ into
+    // up_sbs_ (up_w_ x up_h_ per eye) before the repack: EASU into up_tmp_
+    // then RCAS into up_sbs_ for "fsr", a single Lanczos-2 pass for
+    // "lanczos". Otherwise, or with "bilinear", the repack's sampler scales.
+    enum class Upscaler { Bilinear, Fsr, Lanczos };
+    Upscaler              upscaler_ = Upscaler::Bilinear;
+    bool                  up_active_ = false;
+    bool                  up_failed_ = false;  // pipelines failed once; stay bilinear
+    uint32_t              up_w_ = 0, up_h_ = 0;
+    vrto3d::vk::Image2D   up_sbs_;
+    vrto3d::vk::Image2D   up_tmp_;
+    VkDescriptorSetLayout up_dsl_ = VK_NULL_HANDLE;
+    VkPipelineLayout      up_layout_ = VK_NULL_HANDLE;
+    VkPipeline            easu_pipeline_ = VK_NULL_HANDLE;
+    VkPipeline            rcas_pipeline_ = VK_NULL_HANDLE;
+    VkPipeline            lanczos_pipeline_ = VK_NULL_HANDLE;
+    VkDescriptorPool      up_pool_ = VK_NULL_HANDLE;
+    // out_sbs_ -> up_tmp_ (EASU), up_tmp_ -> up_sbs_ (RCAS),
+    // out_sbs_ -> up_sbs_ (Lanczos).
+    VkDescriptorSet       up_sets_[3] = {};
+    // Last OutputProfileOptions handed to the presenters; upscaler_ is
+    // derived from it.
+    vrto3d::OutputProfileOptions output_profile_;
 
     // Present-thread command machinery (double-buffered).
+    // Swapchains fed per frame: two when DualDisplay drives each eye's
+    // output from its own (IVkPresenter::TargetCount).
     static constexpr int kFramesInFlight = 2;
+    static constexpr uint32_t kMaxPresentTargets = 2;
     VkCommandPool   cmd_pool_ = VK_NULL_HANDLE;
     VkCommandBuffer cmd_bufs_[kFramesInFlight] = {};
     VkFence         frame_fences_[kFramesInFlight] = {};
-    VkSemaphore     acquire_sems_[kFramesInFlight] = {};
+    VkSemaphore     acquire_sems_[kFramesInFlight][kMaxPresentTargets] = {};
     VkSemaphore     render_sems_[kFramesInFlight] = {};
     int             frame_slot_ = 0;
 
+    // The transfer (eye barriers + blits) and each target's repack draw only
+    // change with the eye images and the sink, so they are kept as secondary
+    // command buffers and replayed; the per-frame primary just stitches them
+    // together around the OSD. Keys hold every input; entries are
+    // re-recorded only once the frames that used them have retired. The
+    // repack's config-driven parameters are not among them: they are copied
+    // into repack_params_ each frame (see below).
+    static constexpr int    kCachedTransfers = 8;
+    static constexpr int    kCachedRepacks = 16;
+    static constexpr size_t kCacheKeyBytes = 192;
+    struct CachedCmd {
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        bool            valid = false;
+        uint64_t        last_used = 0;  // submit_serial_ of the last frame using it
+        std::array<unsigned char, kCacheKeyBytes> key{};
+    };
+    CachedCmd         transfer_cache_[kCachedTransfers];
+    CachedCmd         repack_cache_[kCachedRepacks];
+    uint64_t          submit_serial_ = 1;
+    std::atomic<bool> eye_images_released_{false};
+
+    // Extra outputs fed from the same out_sbs_, each with its own presenter,
+    // packing and repack pipeline. driver_vrto3d/mirrors lists them as
+    // presenter[:mode][@display], e.g. "pipewire:Mono,x11:SbS@2"; a mirror
+    // without a mode follows the primary's. Mirrors acquire without blocking
+    // and render in their own submit with their own fences; Present() and
+    // event pumping run on the mirror's thread, since several sinks block
+    // in them (FIFO swapchains, the Wayland frame-callback wait, PipeWire's
+    // completion wait). A mirror that is busy, or whose consumer hasn't
+    // handed a buffer back, drops the frame and the primary output keeps
+    // its pace. Focus and input capture follow the primary; present timing
+    // and VRR are the primary's alone.
+    static constexpr size_t kMaxMirrors = 4;
+    struct MirrorWorker {
+        std::thread thread;
+        // Serializes every call into the mirror's presenter. The present
+        // thread only try_locks it on the frame path.
+        std::mutex  mutex;
+        int         job_fd = -1;     // eventfd: job posted or stop requested
+        bool        stop = false;
+        bool        job = false;     // a Present is queued (index, wait_sem)
+        uint32_t    index = 0;
+        VkSemaphore wait_sem = VK_NULL_HANDLE;
+        std::atomic<bool> closed{false};  // presenter reported its output gone
+    };
+    struct MirrorSink {
+        std::string spec;
+        std::unique_ptr<vrto3d::IVkPresenter> presenter;
+        std::unique_ptr<MirrorWorker> worker;
+        bool         own_mode = false;
+        OutputMode   mode = OutputMode::SbS;
+        // Presenter's extent as of its last acquire, so the present thread
+        // never reads it while Present() may be resizing.
+        VkExtent2D   extent{};
+        VkPipeline   pipeline = VK_NULL_HANDLE;
+        VkSemaphore  acquire_sems[kFramesInFlight] = {};
+        VkSemaphore  render_sems[kFramesInFlight] = {};
+        uint64_t     presented = 0;  // written by the mirror's thread
+        uint64_t     dropped = 0;    // frames skipped because the sink was busy
+    };
+    std::vector<MirrorSink> mirrors_;
+    VkCommandBuffer mirror_cmd_bufs_[kFramesInFlight] = {};
+    VkFence         mirror_fences_[kFramesInFlight] = {};
+
+    // RepackParams ring behind the repack set's dynamic uniform binding: per
+    // frame slot, one entry per primary target, then one per mirror. An
+    // entry is rewritten only after its slot's fence (frame_fences_ for the
+    // targets, mirror_fences_ for the mirrors) has passed.
+    static constexpr uint32_t kRepackParamsPerSlot = kMaxPresentTargets + kMaxMirrors;
+    VkBuffer        repack_params_ = VK_NULL_HANDLE;
+    VkDeviceMemory  repack_params_mem_ = VK_NULL_HANDLE;
+    unsigned char*  repack_params_mapped_ = nullptr;
+    uint32_t        repack_params_stride_ = 0;  // padded to minUniformBufferOffsetAlignment
+
     // Latest frame snapshot from the compositor thread.
-    std::mutex              frame_mutex_;
-    std::condition_variable frame_cv_;
-    EyeLayer                pending_left_{};
-    EyeLayer                pending_right_{};
-    uint64_t                pending_seq_ = 0;
-    uint64_t                consumed_seq_ = 0;
+    struct FramePair {
+        EyeLayer left;
+        EyeLayer right;
+        double   tick_sec = 0.0;  // the VsyncEvent this frame answered
+        double   tick_lead_sec = -1.0;  // that tick's lead (< 0 = not vblank-aligned)
+    };
+    vrto3d::vk::FrameMailbox<FramePair> frames_;
+    int                     app_exit_listener_ = 0;
+
+    // Present-thread event loop: doorbell_fd_ (eventfd) is rung by new
+    // frames, app exits and Shutdown; housekeeping_fd_ (timerfd) re-runs the
+    // focus block while idle; the presenter's display fd is added once the
+    // presenter exists.
+    int epoll_fd_ = -1;
+    int doorbell_fd_ = -1;
+    int housekeeping_fd_ = -1;
 
     // OSD
     StereoDisplayComponent*                  osd_component_ = nullptr;
@@ -161,6 +383,9 @@ private:
     std::mutex  shot_mutex_;
     std::string shot_app_name_;
     bool        shot_requested_ = false;
+    // Full-size SbS the screenshot blits the eyes into, independent of
+    // out_sbs_'s (possibly reduced) size.
+    vrto3d::vk::Image2D shot_image_;
     VkBuffer       shot_buffer_ = VK_NULL_HANDLE;
     VkDeviceMemory shot_memory_ = VK_NULL_HANDLE;
     uint32_t       shot_w_ = 0, shot_h_ = 0;
@@ -172,10 +397,85 @@ private:
     std::atomic<bool> paused_for_disconnect_{false};
     std::atomic<bool> device_dead_{false};
 
+    // Set by ConfigureOsd; VsyncTickThread flushes the component's
+    // rate-limited depth/projection writes on each tick.
+    std::atomic<StereoDisplayComponent*> vsync_component_{nullptr};
+
     std::atomic<uint64_t> frame_counter_{0};
     std::atomic<double>   last_vsync_sec_{0.0};
+
+    // Presentation feedback (written by the present thread).
+    std::atomic<double>   present_latency_sec_{0.0};
+    std::atomic<double>   refresh_period_sec_{0.0};
+    std::atomic<double>   last_presented_sec_{0.0};
+    std::atomic<uint64_t> presents_discarded_{0};
+    std::atomic<uint64_t> vblanks_repeated_{0};
+    uint64_t              last_presented_msc_ = 0;
     float display_frequency_ = 60.0f;
 
+    // VRR pacing. The frame interval is smoothed over compositor frames
+    // (written on the compositor thread by OnDirectModeFrame).
+    bool                  vrr_requested_ = false;
+    std::atomic<bool>     vrr_active_{false};
+    std::atomic<double>   game_frame_interval_sec_{0.0};
+    double                last_game_frame_sec_ = 0.0;
+
+    // Latency-targeted vsync phase (opt-in with driver_vrto3d/vsync_margin_ms; needs
+    // presentation feedback). SteamVR starts a frame at our VsyncEvent, so a
+    // tick on the vblank leaves every frame waiting for the following one.
+    // Each tick fires the margin plus any back-off ahead of the vblank it
+    // aims at, and VsyncEvent reports that vblank. Every presented frame is
+    // checked against it by its presented_time: a frame that missed it while
+    // the game kept pace adds a quarter period of back-off and pauses
+    // tightening; frames that made it bleed the back-off off again. The
+    // back-off starts at a full period, where the ticks sat before.
+    double                vsync_margin_sec_ = -1.0;  // < 0 = off
+    double                vsync_backoff_sec_ = 1.0;  // clamped to the period
+    double                vsync_hold_until_sec_ = 0.0;
+    std::atomic<double>   vsync_lead_sec_{0.0};
+    std::atomic<double>   last_tick_sec_{0.0};
+    std::atomic<double>   last_tick_lead_sec_{-1.0};
+    // Presented frames awaiting their PresentTiming, oldest first.
+    struct VsyncPending {
+        double present_sec = 0.0;  // just before PresentTargets
+        double tick_sec = 0.0;
+        double lead_sec = 0.0;
+    };
+    std::deque<VsyncPending> vsync_pending_;
+
+    // Static-frame idle (opt-in, driver_vrto3d/static_idle_seconds). Every
+    // frame also runs tile_hash.comp over both eyes: one value per
+    // kHashTile x kHashTile tile, written to one region of hash_buffer_ per
+    // frame slot plus one for probes. Once the hashes have matched for
+    // idle_after_sec_, the present thread only probes new frames (acquire +
+    // hash, waited on the spot) and drops them while they match; the display
+    // keeps the last presented image. The first changed frame, an open OSD
+    // or a screenshot request ends it.
+    static constexpr uint32_t kHashTile = 64;
+    static constexpr uint32_t kMaxHashTiles = 128 * 128;  // per eye, up to 8192x8192
+    static constexpr int      kHashRegions = kFramesInFlight + 1;
+    static constexpr double   kIdleFps = 15.0;
+    double                idle_after_sec_ = 0.0;  // 0 disables
+    VkDescriptorSetLayout hash_dsl_ = VK_NULL_HANDLE;
+    VkPipelineLayout      hash_layout_ = VK_NULL_HANDLE;
+    VkPipeline            hash_pipeline_ = VK_NULL_HANDLE;
+    VkDescriptorPool      hash_pool_ = VK_NULL_HANDLE;
+    VkDescriptorSet       hash_sets_[kHashRegions][2] = {};
+    VkSampler             hash_sampler_ = VK_NULL_HANDLE;
+    VkBuffer              hash_buffer_ = VK_NULL_HANDLE;
+    VkDeviceMemory        hash_buffer_mem_ = VK_NULL_HANDLE;
+    const uint32_t*       hash_mapped_ = nullptr;
+    uint32_t              hash_tiles_[kHashRegions][2] = {};
+    VkCommandBuffer       probe_cmd_ = VK_NULL_HANDLE;
+    VkFence               probe_fence_ = VK_NULL_HANDLE;
+    bool                  hash_pending_[kFramesInFlight] = {};
+    bool              have_frame_hash_ = false;
+    uint64_t          last_frame_hash_ = 0;
+    double            static_since_sec_ = 0.0;
+    uint64_t          idle_frames_dropped_ = 0;
+    std::atomic<bool> static_idle_{false};
+    std::chrono::steady_clock::time_point idle_pace_next_{};  // compositor thread
+
     // Focus/z-order + input-capture edge tracking (present thread only).
     // Mirrors WindowPresenter::FocusThreadLoop; starts lowered.
     bool focus_state_init_ = false;
@@ -0,0 +1,35 @@
+// check.h — minimal assertions for the vrto3d unit tests
+//
+// Each test is a plain executable: CHECK/CHECK_NEAR report the failing line
+// and keep going, and main() returns TestFailures() so ctest sees the result.
+// No framework on purpose; the driver has no test dependency to pull in.
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+
+inline int& TestFailures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(cond)                                                              \
+    do {                                                                         \
+        if (!(cond)) {                                                           \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, \
+                         #cond);                                                 \
+            ++TestFailures();                                                    \
+        }                                                                        \
+    } while (0)
+
+#define CHECK_NEAR(a, b, tol)                                                    \
+    do {                                                                         \
+        const double check_a_ = static_cast<double>(a);                          \
+        const double check_b_ = static_cast<double>(b);                          \
+        if (!(std::fabs(check_a_ - check_b_) <= (tol))) {                        \
+            std::fprintf(stderr, "%s:%d: CHECK_NEAR(%s, %s) failed: %g vs %g\n",  \
+                         __FILE__, __LINE__, #a, #b, check_a_, check_b_);        \
+            ++TestFailures();                                                    \
+        }                                                                        \
+    } while (0)
@@ -0,0 +1,133 @@
+// frame_mailbox_test.cpp — FrameMailbox Publish/Take/Discard ordering
+#include "check.h"
+#include "vk/frame_mailbox.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+using vrto3d::vk::FrameMailbox;
+
+namespace {
+
+void EmptyTakeFails()
+{
+    FrameMailbox<int> box;
+    int v = -1;
+    CHECK(!box.Take(&v));
+    CHECK(v == -1);
+    CHECK(box.Published() == 0);
+}
+
+void TakeReturnsEachValueOnce()
+{
+    FrameMailbox<int> box;
+    int v = 0;
+    for (int i = 1; i <= 5; ++i)
+    {
+        CHECK(!box.Publish(i));
+        CHECK(box.Take(&v));
+        CHECK(v == i);
+        CHECK(!box.Take(&v));
+    }
+    CHECK(box.Published() == 5);
+    CHECK(box.Overwritten() == 0);
+}
+
+void LatestWins()
+{
+    FrameMailbox<int> box;
+    CHECK(!box.Publish(1));
+    CHECK(box.Publish(2));
+    CHECK(box.Publish(3));
+    int v = 0;
+    CHECK(box.Take(&v));
+    CHECK(v == 3);
+    CHECK(!box.Take(&v));
+    CHECK(box.Overwritten() == 2);
+
+    // Taken values are not counted as overwritten.
+    CHECK(!box.Publish(4));
+    CHECK(box.Overwritten() == 2);
+}
+
+void DiscardDropsPending()
+{
+    FrameMailbox<int> box;
+    box.Publish(1);
+    box.Publish(2);
+    box.Discard();
+    int v = 0;
+    CHECK(!box.Take(&v));
+    CHECK(!box.Take(&v));
+
+    // Values published after the Discard come through.
+    box.Publish(3);
+    CHECK(box.Take(&v));
+    CHECK(v == 3);
+
+    // Discard with nothing pending does not eat the next publish.
+    box.Discard();
+    box.Publish(4);
+    CHECK(box.Take(&v));
+    CHECK(v == 4);
+}
+
+struct Frame
+{
+    uint64_t seq;
+    uint64_t check;  // seq * 3, to catch torn copies
+};
+
+void ConcurrentOrdering()
+{
+    // One producer, one consumer: every value taken must be whole and newer
+    // than the last one, and taken + overwritten must cover every publish
+    // except one that may still be waiting in the middle slot.
+    constexpr uint64_t kCount = 200000;
+    FrameMailbox<Frame> box;
+    std::atomic<bool> done{ false };
+    uint64_t taken = 0;
+    uint64_t last = 0;
+    bool ordered = true;
+    bool whole = true;
+
+    std::thread consumer([&] {
+        Frame f{};
+        for (;;)
+        {
+            const bool finished = done.load(std::memory_order_acquire);
+            while (box.Take(&f))
+            {
+                ordered = ordered && f.seq > last;
+                whole = whole && f.check == f.seq * 3;
+                last = f.seq;
+                ++taken;
+            }
+            if (finished)
+                break;
+        }
+    });
+    for (uint64_t i = 1; i <= kCount; ++i)
+        box.Publish(Frame{ i, i * 3 });
+    done.store(true, std::memory_order_release);
+    consumer.join();
+
+    CHECK(ordered);
+    CHECK(whole);
+    CHECK(last == kCount);
+    CHECK(box.Published() == kCount);
+    CHECK(taken + box.Overwritten() == kCount);
+}
+
+} // namespace
+
+int main()
+{
+    EmptyTakeFails();
+    TakeReturnsEachValueOnce();
+    LatestWins();
+    DiscardDropsPending();
+    ConcurrentOrdering();
+    return TestFailures();
+}
@@ -0,0 +1,76 @@
+// mirror_spec_test.cpp — ParseMirrorSpec on driver_vrto3d/mirrors entries
+#include "check.h"
+#include "vk/mirror_spec.h"
+
+using vrto3d::vk::MirrorSpec;
+using vrto3d::vk::ParseMirrorSpec;
+
+namespace {
+
+void PresenterOnly()
+{
+    MirrorSpec spec;
+    CHECK(ParseMirrorSpec("pipewire", &spec));
+    CHECK(spec.presenter == "pipewire");
+    CHECK(!spec.has_mode);
+    CHECK(spec.display_index == -1);
+}
+
+void PresenterAndMode()
+{
+    MirrorSpec spec;
+    CHECK(ParseMirrorSpec("x11:TaB", &spec));
+    CHECK(spec.presenter == "x11");
+    CHECK(spec.has_mode);
+    CHECK(spec.mode == OutputMode::TaB);
+    CHECK(spec.display_index == -1);
+
+    // Every mode the OSD names is accepted.
+    for (const vrto3d::vk::ModeName& m : vrto3d::vk::kMirrorModes)
+    {
+        MirrorSpec each;
+        CHECK(ParseMirrorSpec(std::string("drm:") + m.name, &each));
+        CHECK(each.has_mode && each.mode == m.mode);
+    }
+}
+
+void Display()
+{
+    MirrorSpec spec;
+    CHECK(ParseMirrorSpec("drm@1", &spec));
+    CHECK(spec.presenter == "drm");
+    CHECK(!spec.has_mode);
+    CHECK(spec.display_index == 1);
+
+    MirrorSpec full;
+    CHECK(ParseMirrorSpec("drm:AnaglyphRedCyan@0", &full));
+    CHECK(full.presenter == "drm");
+    CHECK(full.has_mode && full.mode == OutputMode::AnaglyphRedCyan);
+    CHECK(full.display_index == 0);
+}
+
+void Rejects()
+{
+    MirrorSpec spec;
+    CHECK(!ParseMirrorSpec("x11:NotAMode", &spec));
+    CHECK(!ParseMirrorSpec("x11:", &spec));
+    CHECK(!ParseMirrorSpec("x11:sbs", &spec));  // names are case sensitive
+    CHECK(!ParseMirrorSpec("drm@", &spec));
+    CHECK(!ParseMirrorSpec("drm@one", &spec));
+    CHECK(!ParseMirrorSpec("drm@1x", &spec));
+    CHECK(!ParseMirrorSpec("drm@-1", &spec));
+    CHECK(!ParseMirrorSpec("", &spec));
+    CHECK(!ParseMirrorSpec(":SbS", &spec));
+    CHECK(!ParseMirrorSpec("@0", &spec));
+}
+
+} // namespace
+
+int main()
+{
+    PresenterOnly();
+    PresenterAndMode();
+    Display();
+    Rejects();
+    return TestFailures();
+}
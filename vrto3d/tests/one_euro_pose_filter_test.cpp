@@ -0,0 +1,164 @@
+// one_euro_pose_filter_test.cpp — OneEuroPoseFilter on SO(3) and its sample clock
+#include "check.h"
+#include "one_euro_pose_filter.h"
+
+#include <random>
+
+namespace {
+
+constexpr double kDegPerRad = 180.0 / M_PI;
+
+// Angle between two rotations in degrees, ignoring quaternion sign.
+double AngleDeg(const vr::HmdQuaternion_t& a, const vr::HmdQuaternion_t& b)
+{
+    const double dot = std::fabs(static_cast<double>(HmdQuaternion_Dot(a, b)));
+    return 2.0 * std::acos(std::min(1.0, dot)) * kDegPerRad;
+}
+
+vr::HmdQuaternion_t Yaw(double degrees)
+{
+    return HmdQuaternion_FromEulerAngles(0.0, 0.0, degrees / kDegPerRad);
+}
+
+struct Sample
+{
+    vr::HmdQuaternion_t rotation;
+    double position[3];
+};
+
+Sample Run(OneEuroPoseFilter& filter, const OneEuroPoseParams& params, const vr::HmdQuaternion_t& rotation,
+           double x, double timestamp)
+{
+    Sample s{ rotation, { x, 0.0, 0.0 } };
+    filter.FilterPose(s.rotation, s.position, params, timestamp);
+    return s;
+}
+
+void FirstSamplePassesThrough()
+{
+    OneEuroPoseFilter filter;
+    const OneEuroPoseParams params;
+    const Sample s = Run(filter, params, Yaw(25.0), 0.1, 10.0);
+    CHECK_NEAR(AngleDeg(s.rotation, Yaw(25.0)), 0.0, 1e-3);
+    CHECK_NEAR(s.position[0], 0.1, 1e-9);
+}
+
+void HoldsUntilTimestampAdvances()
+{
+    OneEuroPoseFilter filter;
+    const OneEuroPoseParams params;
+    Run(filter, params, Yaw(0.0), 0.0, 1.0);
+    const Sample moved = Run(filter, params, Yaw(30.0), 0.2, 1.01);
+    CHECK(AngleDeg(moved.rotation, Yaw(0.0)) > 0.1);
+
+    // The pose thread re-feeds the same or an older sample: output is held.
+    const Sample same = Run(filter, params, Yaw(60.0), 0.5, 1.01);
+    CHECK_NEAR(AngleDeg(same.rotation, moved.rotation), 0.0, 1e-3);
+    CHECK_NEAR(same.position[0], moved.position[0], 1e-9);
+    const Sample older = Run(filter, params, Yaw(60.0), 0.5, 0.5);
+    CHECK_NEAR(AngleDeg(older.rotation, moved.rotation), 0.0, 1e-3);
+    CHECK_NEAR(older.position[0], moved.position[0], 1e-9);
+}
+
+void SmoothingFollowsSampleClock()
+{
+    // Same step, same number of calls: a longer gap between samples must
+    // move the output further, since alpha comes from the sample dt.
+    const OneEuroPoseParams params;
+    OneEuroPoseFilter fast, slow;
+    Run(fast, params, Yaw(0.0), 0.0, 0.0);
+    Run(slow, params, Yaw(0.0), 0.0, 0.0);
+    const Sample f = Run(fast, params, Yaw(20.0), 0.1, 0.005);
+    const Sample s = Run(slow, params, Yaw(20.0), 0.1, 0.050);
+    CHECK(AngleDeg(f.rotation, Yaw(0.0)) < AngleDeg(s.rotation, Yaw(0.0)));
+    CHECK(f.position[0] < s.position[0]);
+
+    // And one second of a held step converges about the same at 50 Hz and
+    // 200 Hz, because the cutoff is in Hz rather than per call.
+    OneEuroPoseFilter hz50, hz200;
+    Sample a{}, b{};
+    for (int i = 0; i <= 50; ++i)
+        a = Run(hz50, params, Yaw(i == 0 ? 0.0 : 20.0), 0.0, i / 50.0);
+    for (int i = 0; i <= 200; ++i)
+        b = Run(hz200, params, Yaw(i == 0 ? 0.0 : 20.0), 0.0, i / 200.0);
+    CHECK_NEAR(AngleDeg(a.rotation, b.rotation), 0.0, 0.5);
+}
+
+void ConvergesOnStep()
+{
+    OneEuroPoseFilter filter;
+    const OneEuroPoseParams params;
+    Run(filter, params, Yaw(0.0), 0.0, 0.0);
+    Sample s{};
+    for (int i = 1; i <= 300; ++i)
+        s = Run(filter, params, Yaw(45.0), 0.3, i / 100.0);
+    CHECK_NEAR(AngleDeg(s.rotation, Yaw(45.0)), 0.0, 0.05);
+    CHECK_NEAR(s.position[0], 0.3, 1e-4);
+}
+
+void AttenuatesNoiseAtRest()
+{
+    OneEuroPoseFilter filter;
+    const OneEuroPoseParams params;
+    std::mt19937 rng(1234);
+    std::normal_distribution<double> noise(0.0, 0.2);
+    double raw_sum = 0.0, filtered_sum = 0.0;
+    int count = 0;
+    for (int i = 0; i < 500; ++i)
+    {
+        const vr::HmdQuaternion_t raw = Yaw(10.0 + noise(rng));
+        const Sample s = Run(filter, params, raw, 0.0, i / 100.0);
+        if (i >= 100)
+        {
+            raw_sum += AngleDeg(raw, Yaw(10.0));
+            filtered_sum += AngleDeg(s.rotation, Yaw(10.0));
+            ++count;
+        }
+    }
+    CHECK(filtered_sum / count < 0.5 * (raw_sum / count));
+}
+
+void IgnoresQuaternionSignFlip()
+{
+    // q and -q are the same rotation; the filter must not swing through 360.
+    OneEuroPoseFilter filter;
+    const OneEuroPoseParams params;
+    Run(filter, params, Yaw(15.0), 0.0, 0.0);
+    vr::HmdQuaternion_t flipped = Yaw(15.0);
+    flipped.w = -flipped.w;
+    flipped.x = -flipped.x;
+    flipped.y = -flipped.y;
+    flipped.z = -flipped.z;
+    const Sample s = Run(filter, params, flipped, 0.0, 0.01);
+    CHECK_NEAR(AngleDeg(s.rotation, Yaw(15.0)), 0.0, 1e-2);
+}
+
+void BetaCutsLagWhileMoving()
+{
+    OneEuroPoseParams still;
+    still.rot_beta = 0.0;
+    const OneEuroPoseParams adaptive;
+    OneEuroPoseFilter a, b;
+    Sample sa{}, sb{};
+    for (int i = 0; i <= 50; ++i)
+    {
+        const double yaw = 120.0 * i / 100.0; // 120 deg/s turn
+        sa = Run(a, still, Yaw(yaw), 0.0, i / 100.0);
+        sb = Run(b, adaptive, Yaw(yaw), 0.0, i / 100.0);
+    }
+    CHECK(AngleDeg(sb.rotation, Yaw(60.0)) < AngleDeg(sa.rotation, Yaw(60.0)));
+}
+
+} // namespace
+
+int main()
+{
+    FirstSamplePassesThrough();
+    HoldsUntilTimestampAdvances();
+    SmoothingFollowsSampleClock();
+    ConvergesOnStep();
+    AttenuatesNoiseAtRest();
+    IgnoresQuaternionSignFlip();
+    BetaCutsLagWhileMoving();
+    return TestFailures();
+}
@@ -0,0 +1,179 @@
+// property_publisher_test.cpp — PropertyPublisher rate limit and deadband
+#include "check.h"
+#include "property_publisher.h"
+
+#include <utility>
+#include <vector>
+
+using vrto3d::PropertyPublisher;
+
+namespace {
+
+constexpr uint32_t kDevice = 7;
+
+// Records writes and drives a fake clock in place of OpenVR.
+struct Harness
+{
+    PropertyPublisher publisher;
+    PropertyPublisher::Clock::time_point now{};
+    std::vector<float> ipd_writes;
+    std::vector<float> proj_writes;  // left eye's left tangent per write
+    float proj_left = -1.0f;
+
+    Harness()
+    {
+        PropertyPublisher::Backend backend;
+        backend.write_ipd = [this](uint32_t device, float meters) {
+            CHECK(device == kDevice);
+            ipd_writes.push_back(meters);
+        };
+        backend.write_projection = [this](uint32_t device, const vr::HmdRect2_t& left, const vr::HmdRect2_t&) {
+            CHECK(device == kDevice);
+            proj_writes.push_back(left.vTopLeft.v[0]);
+        };
+        backend.now = [this] { return now; };
+        publisher.SetBackend(std::move(backend));
+    }
+
+    void Configure(double interval_s, double ipd_threshold, double proj_threshold)
+    {
+        publisher.Configure(kDevice, { interval_s, ipd_threshold }, { interval_s, proj_threshold },
+                            [this](vr::HmdRect2_t& left, vr::HmdRect2_t& right) {
+                                left = {};
+                                right = {};
+                                left.vTopLeft.v[0] = proj_left;
+                                right.vTopLeft.v[0] = proj_left;
+                            });
+    }
+
+    void Advance(double seconds)
+    {
+        now += std::chrono::duration_cast<PropertyPublisher::Clock::duration>(
+            std::chrono::duration<double>(seconds));
+    }
+};
+
+void NothingBeforeConfigure()
+{
+    Harness h;
+    h.publisher.SetIpd(0.063f);
+    h.publisher.RequestProjection(false);
+    h.publisher.Flush();
+    CHECK(h.ipd_writes.empty());
+    CHECK(h.proj_writes.empty());
+
+    // Pending requests go out on the first Flush after Configure.
+    h.Configure(0.1, 0.001, 0.001);
+    CHECK(h.ipd_writes.empty());
+    h.publisher.Flush();
+    CHECK(h.ipd_writes.size() == 1 && h.ipd_writes.back() == 0.063f);
+    CHECK(h.proj_writes.size() == 1);
+}
+
+void FirstWriteIsImmediate()
+{
+    Harness h;
+    h.Configure(10.0, 0.001, 0.001);
+    h.publisher.SetIpd(0.063f);
+    h.publisher.RequestProjection(false);
+    CHECK(h.ipd_writes.size() == 1);
+    CHECK(h.proj_writes.size() == 1);
+}
+
+void RateLimitDefersToFlush()
+{
+    Harness h;
+    h.Configure(0.1, 0.0, 0.0);
+    h.publisher.SetIpd(0.060f);
+    CHECK(h.ipd_writes.size() == 1);
+
+    // A burst inside the interval only keeps the latest value.
+    h.Advance(0.01);
+    h.publisher.SetIpd(0.065f);
+    h.Advance(0.01);
+    h.publisher.SetIpd(0.070f);
+    h.Advance(0.03);
+    h.publisher.Flush();
+    CHECK(h.ipd_writes.size() == 1);
+
+    h.Advance(0.05);
+    h.publisher.Flush();
+    CHECK(h.ipd_writes.size() == 2 && h.ipd_writes.back() == 0.070f);
+
+    // Nothing pending: Flush writes nothing.
+    h.Advance(1.0);
+    h.publisher.Flush();
+    CHECK(h.ipd_writes.size() == 2);
+
+    // Once the interval has passed, a single change lands at once.
+    h.publisher.SetIpd(0.060f);
+    CHECK(h.ipd_writes.size() == 3 && h.ipd_writes.back() == 0.060f);
+}
+
+void DeadbandAgainstPublished()
+{
+    Harness h;
+    h.Configure(0.0, 0.001, 0.01);
+    h.publisher.SetIpd(0.0700f);
+    h.publisher.SetIpd(0.0705f);
+    CHECK(h.ipd_writes.size() == 1);
+
+    // Compared with the published 0.0700, not the dropped 0.0705, so a
+    // slow drift still goes out once it adds up.
+    h.publisher.SetIpd(0.0709f);
+    CHECK(h.ipd_writes.size() == 1);
+    h.publisher.SetIpd(0.0712f);
+    CHECK(h.ipd_writes.size() == 2 && h.ipd_writes.back() == 0.0712f);
+
+    // A dropped value is not retried on Flush.
+    h.publisher.SetIpd(0.0715f);
+    h.publisher.Flush();
+    CHECK(h.ipd_writes.size() == 2);
+
+    h.publisher.RequestProjection(false);
+    CHECK(h.proj_writes.size() == 1);
+    h.proj_left = -1.005f;
+    h.publisher.RequestProjection(false);
+    CHECK(h.proj_writes.size() == 1);
+    h.proj_left = -1.02f;
+    h.publisher.RequestProjection(false);
+    CHECK(h.proj_writes.size() == 2 && h.proj_writes.back() == -1.02f);
+}
+
+void ForceResendsUnchangedProjection()
+{
+    Harness h;
+    h.Configure(0.1, 0.001, 0.001);
+    h.publisher.RequestProjection(false);
+    CHECK(h.proj_writes.size() == 1);
+
+    // Unchanged and not forced: nothing goes out.
+    h.Advance(0.2);
+    h.publisher.RequestProjection(false);
+    CHECK(h.proj_writes.size() == 1);
+
+    // Forced: the same projection is sent again.
+    h.publisher.RequestProjection(true);
+    CHECK(h.proj_writes.size() == 2 && h.proj_writes.back() == -1.0f);
+
+    // A force inside the interval waits for a Flush after it.
+    h.Advance(0.01);
+    h.publisher.RequestProjection(true);
+    h.publisher.Flush();
+    CHECK(h.proj_writes.size() == 2);
+    h.Advance(0.1);
+    h.publisher.Flush();
+    CHECK(h.proj_writes.size() == 3);
+}
+
+} // namespace
+
+int main()
+{
+    NothingBeforeConfigure();
+    FirstWriteIsImmediate();
+    RateLimitDefersToFlush();
+    DeadbandAgainstPublished();
+    ForceResendsUnchangedProjection();
+    return TestFailures();
+}
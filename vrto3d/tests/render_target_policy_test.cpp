@@ -0,0 +1,83 @@
+// render_target_policy_test.cpp — OutputMatchedRenderTargetSize per output mode
+#include "check.h"
+#include "render_target_policy.h"
+
+// Stand-in for VRto3DLib's timing table so the test doesn't pull in
+// JsonManager: HDMI 1.4a 1080p frame packing (two 1920x1080 eyes with a
+// 45-line gap), the only packed mode the cases below use.
+const FramePackTimingSpec* GetFramePackTimingSpec(OutputMode mode)
+{
+    static const FramePackTimingSpec k1080p = [] {
+        FramePackTimingSpec s{};
+        s.active_w = 1920;
+        s.active_h = 2205;
+        s.gap_pixels = 45;
+        return s;
+    }();
+    return mode == OutputMode::FramePacked1080p24 ? &k1080p : nullptr;
+}
+
+namespace {
+
+using vrto3d::OutputMatchedRenderTargetSize;
+using vrto3d::RenderTargetSize;
+
+void CheckSize(OutputMode mode, uint32_t out_w, uint32_t out_h, float supersample, uint32_t want_w,
+               uint32_t want_h)
+{
+    const RenderTargetSize size = OutputMatchedRenderTargetSize(mode, out_w, out_h, supersample);
+    CHECK_NEAR(size.width, want_w, 0);
+    CHECK_NEAR(size.height, want_h, 0);
+}
+
+void HalfModes()
+{
+    CheckSize(OutputMode::SbS, 3840, 2160, 1.0f, 1920, 2160);
+    CheckSize(OutputMode::ColInterlaced, 3840, 2160, 1.0f, 1920, 2160);
+    CheckSize(OutputMode::TaB, 3840, 2160, 1.0f, 3840, 1080);
+    CheckSize(OutputMode::RowInterlaced, 3840, 2160, 1.0f, 3840, 1080);
+    CheckSize(OutputMode::VirtualDesktop, 3840, 2160, 1.0f, 1920, 1080);
+}
+
+void CheckerboardKeepsHalfThePixels()
+{
+    const RenderTargetSize size = OutputMatchedRenderTargetSize(OutputMode::Checkerboard, 3840, 2160, 1.0f);
+    CHECK_NEAR(size.width, 2715, 0);   // 3840 / sqrt(2)
+    CHECK_NEAR(size.height, 1527, 0);  // 2160 / sqrt(2)
+    CHECK_NEAR(static_cast<double>(size.width) * size.height, 3840.0 * 2160.0 / 2.0, 3840.0 * 2.0);
+}
+
+void FullFrameModesMatchOutput()
+{
+    CheckSize(OutputMode::Mono, 2560, 1440, 1.0f, 2560, 1440);
+    CheckSize(OutputMode::AnaglyphRedCyan, 2560, 1440, 1.0f, 2560, 1440);
+}
+
+void FramePackedUsesPackedTiming()
+{
+    // The desktop mode doesn't matter; each eye is the packed timing's size.
+    CheckSize(OutputMode::FramePacked1080p24, 3840, 2160, 1.0f, 1920, 1080);
+    CheckSize(OutputMode::FramePacked1080p24, 1280, 720, 1.0f, 1920, 1080);
+}
+
+void Supersample()
+{
+    CheckSize(OutputMode::SbS, 3840, 2160, 1.5f, 2880, 3240);
+    CheckSize(OutputMode::TaB, 1920, 1080, 0.5f, 960, 270);
+    // Clamped to 0.25..4 and never below one pixel.
+    CheckSize(OutputMode::Mono, 1920, 1080, 0.0f, 480, 270);
+    CheckSize(OutputMode::Mono, 1920, 1080, 10.0f, 7680, 4320);
+    CheckSize(OutputMode::VirtualDesktop, 2, 2, 0.25f, 1, 1);
+}
+
+} // namespace
+
+int main()
+{
+    HalfModes();
+    CheckerboardKeepsHalfThePixels();
+    FullFrameModesMatchOutput();
+    FramePackedUsesPackedTiming();
+    Supersample();
+    return TestFailures();
+}